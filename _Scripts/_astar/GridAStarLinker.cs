@@ -31,7 +31,7 @@ namespace AStar
         private delegate IntPtr getGridPoint(int gridX, int gridY);
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-        private delegate IntPtr getPathList(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist);
+        private delegate IntPtr getPathList(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags);
 
         [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
         private delegate IntPtr blurWeights(int blurSize);
@@ -82,6 +82,16 @@ namespace AStar
 
         #endregion Constructors
 
+        #region Properties
+
+        /// <summary>
+        /// Gets or sets the search mode flags passed along with every path query
+        /// (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search).
+        /// </summary>
+        public int SearchFlags { get; set; }
+
+        #endregion Properties
+
         #region Public Methods
 
         /// <summary>
@@ -149,49 +159,47 @@ namespace AStar
         /// <param name="callback">The callback to return the result to</param>
         public void GetPath(PathRequest request, Action<PathResult> callback)
         {
-            lock (_getPath)
+            // The native query utilizes a search context per calling thread, so requests run in parallel
+            (var start, var end) = (request.pathStart, request.pathEnd);
+            IntPtr pathPtr = _getPath(start.x, start.y, start.z, end.x, end.y, end.z, request.smooth, request.turnDist, request.stopDist, SearchFlags);
+
+            float[] sizeArray = new float[1];
+            Marshal.Copy(pathPtr, sizeArray, 0, 1);
+            int size = (int)sizeArray[0];
+            if (size == 1)
             {
-                (var start, var end) = (request.pathStart, request.pathEnd);
-                IntPtr pathPtr = _getPath(start.x, start.y, start.z, end.x, end.y, end.z, request.smooth, request.turnDist, request.stopDist);
+                // TODO: Fix Empty Path Bug -- requester becomes stuck on an unwalkable node
+                callback(new PathResult(null, false, request.hash, request.callback));
+            }
 
-                float[] sizeArray = new float[1];
-                Marshal.Copy(pathPtr, sizeArray, 0, 1);
-                int size = (int)sizeArray[0];
-                if (size == 1)
-                {
-                    // TODO: Fix Empty Path Bug -- requester becomes stuck on an unwalkable node
-                    callback(new PathResult(null, false, request.hash, request.callback));
-                }
 
+            float[] points = new float[size];
+            Marshal.Copy(pathPtr, points, 0, size);
 
-                float[] points = new float[size];
-                Marshal.Copy(pathPtr, points, 0, size);
+            _releaseMemory(pathPtr);
 
-                _releaseMemory(pathPtr);
+            if (request.smooth)
+            {
+                var finishIndex = (int)points[1];
+                var slowIndex = (int)points[2];
 
-                if (request.smooth)
+                Vector3[] waypoints = new Vector3[(size - 3) / 10];
+                Line[] lines = new Line[(size - 3) / 10];
+                for (int i = 3; i < size; i += 10)
                 {
-                    var finishIndex = (int)points[1];
-                    var slowIndex = (int)points[2];
-
-                    Vector3[] waypoints = new Vector3[(size - 3) / 10];
-                    Line[] lines = new Line[(size - 3) / 10];
-                    for (int i = 3; i < size; i += 10)
-                    {
-                        waypoints[i / 10] = new Vector3(points[i], points[i + 1], points[i + 2]);
-                        lines[i / 10] = new Line(points[i + 3], points[i + 4], new Vector2(points[i + 5], points[i + 6]), new Vector2(points[i + 7], points[i + 8]), (int)points[i + 9]);
-                    }
-                    callback(new PathResult(new SmoothPath(waypoints, lines, finishIndex, slowIndex), true, request.hash, request.callback));
+                    waypoints[i / 10] = new Vector3(points[i], points[i + 1], points[i + 2]);
+                    lines[i / 10] = new Line(points[i + 3], points[i + 4], new Vector2(points[i + 5], points[i + 6]), new Vector2(points[i + 7], points[i + 8]), (int)points[i + 9]);
                 }
-                else
+                callback(new PathResult(new SmoothPath(waypoints, lines, finishIndex, slowIndex), true, request.hash, request.callback));
+            }
+            else
+            {
+                Vector3[] waypoints = new Vector3[(size - 1) / 3];
+                for (int i = 1; i < size; i += 3)
                 {
-                    Vector3[] waypoints = new Vector3[(size - 1) / 3];
-                    for (int i = 1; i < size; i += 3)
-                    {
-                        waypoints[i / 3] = new Vector3(points[i], points[i + 1], points[i + 2]);
-                    }
-                    callback(new PathResult(new Pathing.Path(waypoints), true, request.hash, request.callback));
+                    waypoints[i / 3] = new Vector3(points[i], points[i + 1], points[i + 2]);
                 }
+                callback(new PathResult(new Pathing.Path(waypoints), true, request.hash, request.callback));
             }
         }
 
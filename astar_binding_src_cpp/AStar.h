@@ -1,24 +1,48 @@
-#include <unordered_set>
+#pragma once
 
-#include "Grid.h"
+#include "CompactGrid.h"
 #include "PathPoint.h"
-#include "MinHeap.h"
+#include "CellMap.h"
+#include "JumpPointSearch.h"
+#include "SearchContext.h"
+#include "SearchOptions.h"
+#include "SearchBudget.h"
+#include "SteppedSearch.h"
+#include "HierarchicalGraph.h"
+#include "IncrementalPlanner.h"
+#include "ConnectedComponents.h"
+#include "Landmarks.h"
+#include "WeightBlur.h"
+#include "GridSnapshot.h"
+#include "TileFile.h"
+
+// Width and height of the tiles carrying their own version stamp
+#define TILE_SIZE 16
+
+// Number of single cell edits remembered for incremental planners
+#define EDIT_JOURNAL_CAPACITY 4096
 
 /// <summary>
-/// Hash function class for hashing path points
+/// Enum representing the open list implementations
+/// available to the search.
 /// </summary>
-class PathPointHashFunction
+enum class OpenList : int
 {
-public:
-	/// <summary>
-	/// Function call operator override
-	/// </summary>
-	/// <param name="node">The point to hash</param>
-	/// <returns>The unique hash for the passed point</returns>
-	size_t operator()(const PathPoint& point) const
-	{
-		return std::hash<std::string>()(point.GetPosition().ToString());
-	}
+	BinaryHeap = 0,
+	Buckets = 1
+};
+
+/// <summary>
+/// Enum representing the flags selecting the search mode of a path query.
+/// </summary>
+enum SearchFlags : int
+{
+	SEARCH_DEFAULT = 0,
+	SEARCH_JUMP_POINT = 1 << 0,
+	SEARCH_HIERARCHICAL = 1 << 1,
+	SEARCH_BIDIRECTIONAL = 1 << 2,
+	SEARCH_WEIGHTED = 1 << 3,
+	SEARCH_ANYTIME = 1 << 4
 };
 
 /// <summary>
@@ -32,7 +56,21 @@ class AStar
 private:
 	int m_minPenalty, m_maxPenalty;
 	Vec3 m_worldOffset;
-	Grid<PathPoint> m_grid;
+	CompactGrid m_grid;
+	CellMap m_cells;
+	OpenList m_openList;
+	SearchContext m_context;
+	JumpPointSearch m_jumpPoints;
+	HierarchicalGraph m_hierarchy;
+	ConnectedComponents m_components;
+	Landmarks m_landmarks;
+	WeightBlur m_blur;
+	unsigned int m_version;
+	std::vector<unsigned int> m_tileVersions;
+
+	// Cells edited since the journal base version, with the version of each edit
+	std::vector<std::pair<unsigned int, int>> m_journal;
+	unsigned int m_journalBase;
 
 public:
 
@@ -52,6 +90,13 @@ public:
 	/// <param name="d1">The dimension of the collection</param>
 	AStar(float* nodes, int d1);
 
+	/// <summary>
+	/// Initializes a new instance of the <see cref="AStar"/> class from a
+	/// validated binary snapshot.
+	/// </summary>
+	/// <param name="snapshot">The snapshot to initialize with</param>
+	AStar(const GridSnapshot& snapshot);
+
 	/// <summary>
 	/// Clears the grid utilized by the algorithm.
 	/// </summary>
@@ -98,15 +143,254 @@ public:
 	/// </summary>
 	/// <param name="startCoordinate">The starting coordinate</param>
 	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <returns>The collection of the points outlining the shortest path</returns>
+	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags = SEARCH_DEFAULT);
+
+	/// <summary>
+	/// Finds the shortest path from the passed starting coordinate to the
+	/// passed target coordinate utilizing the passed search context. The grid
+	/// is only read, so concurrent queries with separate contexts are safe
+	/// once <see cref="Prepare"/> has been called for the flags.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="context">The search context to utilize</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <returns>The collection of the points outlining the shortest path</returns>
+	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SearchContext& context, const SearchOptions& options = SearchOptions());
+
+	/// <summary>
+	/// Finds the shortest path from the passed starting coordinate to the
+	/// passed target coordinate utilizing the passed incremental planner,
+	/// which repairs its previous search instead of starting over.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="planner">The incremental planner of the agent</param>
 	/// <returns>The collection of the points outlining the shortest path</returns>
-	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate);
+	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, IncrementalPlanner& planner);
+
+	/// <summary>
+	/// Starts a search from the passed starting coordinate to the passed target
+	/// coordinate, expanded by later calls to <see cref="StepSearch"/>. Stepped
+	/// searches always run forwards, bidirectional, anytime and hierarchical
+	/// flags are ignored.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="search">The search to start</param>
+	/// <param name="weight">The heuristic weight of a weighted search</param>
+	void StartSearch(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SteppedSearch& search, float weight = DEFAULT_SEARCH_WEIGHT);
+
+	/// <summary>
+	/// Continues the passed search until the target is reached, found to be
+	/// unreachable or the step budgets run out.
+	/// </summary>
+	/// <param name="search">The started search</param>
+	/// <param name="maxExpansions">The maximum number of cells expanded by this step (0 - unlimited)</param>
+	/// <param name="maxMicroseconds">The maximum time spent by this step (microseconds, 0 - unlimited)</param>
+	/// <returns>The status of the search</returns>
+	const SearchStatus StepSearch(SteppedSearch& search, int maxExpansions, int maxMicroseconds = 0);
+
+	/// <summary>
+	/// Retrieves the path found by the passed search. While it is still running
+	/// the path leads to the expanded cell closest to the target instead.
+	/// </summary>
+	/// <param name="search">The started search</param>
+	/// <returns>The collection of the points outlining the path</returns>
+	const std::vector<Vec3> GetSearchResult(SteppedSearch& search);
+
+	/// <summary>
+	/// Builds the lazily rebuilt search structures required by the passed flags.
+	/// </summary>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	void Prepare(int flags);
+
+	/// <summary>
+	/// Selects the open list implementation utilized by the search.
+	/// </summary>
+	/// <param name="type">The open list implementation</param>
+	void SetOpenList(OpenList type) { m_openList = type; }
+
+	/// <summary>
+	/// Retrieves the open list implementation utilized by the search.
+	/// </summary>
+	/// <returns>The open list implementation</returns>
+	const OpenList GetOpenList() const { return m_openList; }
+
+	/// <summary>
+	/// Sets the cluster size of the hierarchical search abstraction.
+	/// </summary>
+	/// <param name="clusterSize">The width and height of a cluster in cells</param>
+	void SetClusterSize(int clusterSize) { m_hierarchy.SetClusterSize(clusterSize); }
+
+	/// <summary>
+	/// Sets the number of landmarks tightening the heuristic. Their distance
+	/// tables are rebuilt by the next <see cref="Prepare"/> after every edit.
+	/// </summary>
+	/// <param name="count">The number of landmarks (0 - disabled)</param>
+	void SetLandmarkCount(int count) { m_landmarks.SetCount(count); }
+
+	/// <summary>
+	/// Retrieves the number of landmarks tightening the heuristic.
+	/// </summary>
+	/// <returns>The number of landmarks</returns>
+	const int GetLandmarkCount() const { return m_landmarks.GetCount(); }
+
+	/// <summary>
+	/// Retrieves the size and build time of the landmark distance tables.
+	/// </summary>
+	/// <returns>A tuple containing the landmarks, bytes held and preprocessing milliseconds</returns>
+	const std::tuple<int, size_t, double> GetLandmarkStats() const { return m_landmarks.GetStats(); }
+
+	/// <summary>
+	/// Retrieves the version of the grid, changing with every edit.
+	/// </summary>
+	/// <returns>The grid version</returns>
+	const unsigned int GetVersion() const { return m_version; }
+
+	/// <summary>
+	/// Retrieves the tile containing the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The tile index</returns>
+	const int GetTile(int index);
+
+	/// <summary>
+	/// Retrieves the version of the passed tile, changing with every edit to
+	/// one of its cells. Stamps are drawn from the grid versions, so they are
+	/// never repeated by another tile or grid.
+	/// </summary>
+	/// <param name="tile">The tile index</param>
+	/// <returns>The tile version</returns>
+	const unsigned int GetTileVersion(int tile) const { return m_tileVersions[tile]; }
+
+	/// <summary>
+	/// Collects the cells edited since the passed grid version. Wholesale
+	/// edits (blurring, importing, clearing) and edits too far back are not
+	/// remembered, requiring the caller to start over.
+	/// </summary>
+	/// <param name="version">The grid version the caller is up to date with</param>
+	/// <param name="cells">The edited cells, possibly repeated</param>
+	/// <returns>Whether every edit since the version is known</returns>
+	const bool GetEditsSince(unsigned int version, std::vector<int>& cells) const;
+
+	/// <summary>
+	/// Retrieves the grid utilized by the algorithm.
+	/// </summary>
+	/// <returns>The grid</returns>
+	CompactGrid& GetGrid() { return m_grid; }
+
+	/// <summary>
+	/// Determines whether the passed cell is walkable.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the cell is walkable</returns>
+	const bool IsWalkable(int index) const { return m_cells.IsWalkable(index); }
+
+	/// <summary>
+	/// Determines whether the passed walkable cells may be connected. Always
+	/// true while the component labels are not prepared.
+	/// </summary>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <returns>Whether a path between the cells may exist</returns>
+	const bool IsReachable(int start, int target) const { return !m_components.IsValid() || m_components.Connected(start, target); }
+
+	/// <summary>
+	/// Determines whether a path from the passed starting coordinate to the passed
+	/// target coordinate exists, without searching.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <returns>Whether a path exists (unknown pairs of walkable cells count as reachable)</returns>
+	const bool IsReachable(const Vec3& startCoordinate, const Vec3& targetCoordinate);
+
+	/// <summary>
+	/// Retrieves the connected component labels of the grid.
+	/// </summary>
+	/// <returns>The connected components</returns>
+	const ConnectedComponents& GetComponents() const { return m_components; }
+
+	/// <summary>
+	/// Retrieves the compact walkability and penalty layout of the grid.
+	/// </summary>
+	/// <returns>The cell map</returns>
+	const CellMap& GetCells() const { return m_cells; }
+
+	/// <summary>
+	/// Retrieves the blur of the movement penalties and the edits since it ran.
+	/// </summary>
+	/// <returns>The weight blur</returns>
+	const WeightBlur& GetBlur() const { return m_blur; }
+
+	/// <summary>
+	/// Calculates the movement cost of stepping from the passed cell
+	/// onto the passed neighboring cell.
+	/// </summary>
+	/// <param name="from">The cell index stepped from</param>
+	/// <param name="to">The cell index stepped onto</param>
+	/// <returns>The movement cost</returns>
+	const int MoveCost(int from, int to);
+
+	/// <summary>
+	/// Calculates the heuristic cost from the passed cell to the target cell,
+	/// tightened by the landmark tables once they are prepared. Every step
+	/// pays at least the minimum penalty, so it is counted for the fewest
+	/// steps between the cells.
+	/// </summary>
+	/// <param name="from">The cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <returns>The heuristic cost</returns>
+	const int Heuristic(int from, int target);
+
+	/// <summary>
+	/// Calculates the heuristic cost from the passed cell to the target cell
+	/// from the grid alone, counting the passed minimum penalty for the fewest
+	/// steps between the cells. The landmark tables are never read, so the
+	/// cost stays fixed while they are rebuilt.
+	/// </summary>
+	/// <param name="from">The cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="minPenalty">The minimum penalty paid per step</param>
+	/// <returns>The heuristic cost</returns>
+	const int GridHeuristic(int from, int target, int minPenalty);
 
 	/// <summary>
 	/// Blurs the weight map of the grid utilized by the algorithm.
 	/// </summary>
 	/// <param name="size">The blurr window size</param>
+	/// <param name="pool">The pool to spread the blur across (null - calling thread only)</param>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> BlurWeights(int size, ThreadPool* pool = nullptr);
+
+	/// <summary>
+	/// Re-blurs the cells around the cells edited since the last blur, with
+	/// its window size, as if the whole grid was blurred again from the
+	/// penalties it started from with the edits applied.
+	/// </summary>
+	/// <param name="pool">The pool to spread the blur across (null - calling thread only)</param>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> ReblurWeights(ThreadPool* pool = nullptr);
+
+	/// <summary>
+	/// Takes over the passed blur of the current penalties, blurred away from
+	/// the grid so its owner need not hold any lock while blurring.
+	/// </summary>
+	/// <param name="blur">The blur of every cell, swapped with the previous blur</param>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> AdoptBlur(WeightBlur& blur);
+
+	/// <summary>
+	/// Takes over the passed copy of the last blur, re-blurred around the
+	/// edits since that blur while none were made.
+	/// </summary>
+	/// <param name="blur">The re-blurred copy, swapped with the previous blur</param>
 	/// <returns>The new minimum and maximum movement penalty</returns>
-	const std::tuple<int, int> BlurWeights(int size);
+	const std::tuple<int, int> AdoptReblur(WeightBlur& blur);
 
 	/// <summary>
 	/// Exports the grid utilized by the algorithm.
@@ -122,6 +406,21 @@ public:
 	/// <param name="points">The collection of points to initialize with</param>
 	/// <param name="d1">The dimension of the collection</param>
 	void ImportGrid(float* points, int d1);
+
+	/// <summary>
+	/// Writes a binary snapshot of the grid utilized by the algorithm.
+	/// </summary>
+	/// <param name="data">The bytes to replace with the snapshot</param>
+	void ExportSnapshot(std::vector<uint8_t>& data);
+
+	/// <summary>
+	/// Writes the grid utilized by the algorithm into a new tile file,
+	/// to be searched out of core by a <see cref="TiledWorld"/>.
+	/// </summary>
+	/// <param name="path">The file path</param>
+	/// <param name="tileSize">The cells per tile side</param>
+	/// <returns>Whether every tile was written</returns>
+	const bool ExportTiles(const char* path, int tileSize);
 	
 private:
 
@@ -133,10 +432,184 @@ private:
 	std::vector<PathPoint> GetNearestNeighbors(const PathPoint& center);
 
 	/// <summary>
-	/// 
+	/// Rebuilds the grid point of the passed cell from the grid and the cell map.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The grid point</returns>
+	const PathPoint GetPoint(int index);
+
+	/// <summary>
+	/// Places the passed batch of points, in the layout of <see cref="AddGridPoints"/>,
+	/// into the grid and the cell map.
+	/// </summary>
+	/// <param name="points">The first point of the batch</param>
+	/// <param name="count">The number of points</param>
+	void PlacePoints(const float* points, int count);
+
+	/// <summary>
+	/// Runs the A* search from the start cell to the target cell,
+	/// recording parents within the search arena.
+	/// </summary>
+	/// <typeparam name="TOpen">The open list implementation</typeparam>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="open">The open list to utilize</param>
+	/// <param name="arena">The search arena to record into</param>
+	/// <param name="jump">Whether to expand jump points instead of direct neighbors</param>
+	/// <param name="weight">The heuristic weight (1 - exact)</param>
+	/// <param name="budget">The budget of the search</param>
+	/// <param name="closest">The expanded cell index closest to the target</param>
+	/// <returns>Whether the target was reached</returns>
+	template<typename TOpen>
+	const bool Search(int start, int target, TOpen& open, SearchArena& arena, bool jump, float weight, SearchBudget& budget, int& closest);
+
+	/// <summary>
+	/// Resets the passed open list and search arena to hold only the start cell.
+	/// </summary>
+	/// <typeparam name="TOpen">The open list implementation</typeparam>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="open">The open list to utilize</param>
+	/// <param name="arena">The search arena to record into</param>
+	/// <param name="weight">The heuristic weight (1 - exact)</param>
+	template<typename TOpen>
+	void BeginSearch(int start, int target, TOpen& open, SearchArena& arena, float weight);
+
+	/// <summary>
+	/// Expands the open cells of a begun A* search until the target is reached,
+	/// the open list runs dry or the budget runs out.
+	/// </summary>
+	/// <typeparam name="TOpen">The open list implementation</typeparam>
+	/// <param name="target">The target cell index</param>
+	/// <param name="open">The open list of the search</param>
+	/// <param name="arena">The search arena of the search</param>
+	/// <param name="jump">Whether to expand jump points instead of direct neighbors</param>
+	/// <param name="weight">The heuristic weight (1 - exact)</param>
+	/// <param name="budget">The budget of the search</param>
+	/// <param name="closest">The expanded cell index closest to the target, kept across calls</param>
+	/// <returns>Whether the target was reached</returns>
+	template<typename TOpen>
+	const bool ContinueSearch(int target, TOpen& open, SearchArena& arena, bool jump, float weight, SearchBudget& budget, int& closest);
+
+	/// <summary>
+	/// Resolves the query of the passed search against the current grid and
+	/// begins it from scratch.
+	/// </summary>
+	/// <param name="search">The search to restart</param>
+	void RestartSearch(SteppedSearch& search);
+
+	/// <summary>
+	/// Anytime repairing A* (ARA*) path finding from the start cell to the
+	/// target cell. A weighted search finds a first path quickly, then passes
+	/// with a shrinking weight improve it while time remains. Each pass only
+	/// reopens the cells a cheaper path was found to, instead of starting over.
+	/// </summary>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="context">The search context to record into</param>
+	/// <param name="options">The starting weight and the time limit</param>
+	/// <param name="budget">The budget of the search, spanning every pass</param>
+	/// <param name="closest">The expanded cell index closest to the target</param>
+	/// <returns>Whether the target was reached</returns>
+	const bool SearchAnytime(int start, int target, SearchContext& context, const SearchOptions& options, SearchBudget& budget, int& closest);
+
+	/// <summary>
+	/// Bidirectional A* path finding from the start cell to the target cell.
+	/// A forward frontier from the start and a backward frontier from the target
+	/// are expanded alternately, the smaller one first, recording the cheapest
+	/// cell where they meet. Keys use the average of both heuristics, so the
+	/// search stops exactly once the popped keys of both frontiers add up to
+	/// the cheapest meeting, weighted cells included.
+	/// </summary>
+	/// <typeparam name="TOpen">The open list implementation</typeparam>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="context">The search context holding both frontiers</param>
+	/// <param name="forward">The open list of the forward frontier</param>
+	/// <param name="backward">The open list of the backward frontier</param>
+	/// <param name="budget">The budget of the search</param>
+	/// <param name="meeting">The cell where the frontiers meet along the shortest path</param>
+	/// <param name="closest">The cell index expanded by the forward frontier closest to the target</param>
+	/// <returns>Whether a path was found</returns>
+	template<typename TOpen>
+	const bool SearchBidirectional(int start, int target, SearchContext& context, TOpen& forward, TOpen& backward, SearchBudget& budget, int& meeting, int& closest);
+
+	/// <summary>
+	/// Expands a single cell of one bidirectional search frontier.
+	/// </summary>
+	/// <typeparam name="TOpen">The open list implementation</typeparam>
+	/// <param name="current">The cell index to expand</param>
+	/// <param name="origin">The cell index the frontier started from</param>
+	/// <param name="goal">The cell index the frontier is searching towards</param>
+	/// <param name="open">The open list of the frontier</param>
+	/// <param name="arena">The search arena of the frontier</param>
+	/// <param name="opposite">The search arena of the opposite frontier</param>
+	/// <param name="reverse">Whether the frontier steps onto the current cell instead of away from it</param>
+	/// <param name="best">The cost of the cheapest path through a meeting cell</param>
+	/// <param name="meeting">The meeting cell of the cheapest path</param>
+	template<typename TOpen>
+	void ExpandFrontier(int current, int origin, int goal, TOpen& open, SearchArena& arena, SearchArena& opposite, bool reverse, int& best, int& meeting);
+
+	/// <summary>
+	/// Calculates the movement cost of travelling along the straight or
+	/// diagonal line of cells from the passed cell to the passed cell.
+	/// </summary>
+	/// <param name="from">The cell index travelled from</param>
+	/// <param name="to">The cell index travelled to</param>
+	/// <returns>The movement cost</returns>
+	const int LineCost(int from, int to);
+
+	/// <summary>
+	/// Retraces the path from the end cell back to the start cell
+	/// through the parents recorded within the passed search arena.
+	/// </summary>
+	/// <param name="start">The start cell index</param>
+	/// <param name="end">The end cell index</param>
+	/// <param name="arena">The search arena holding the parents</param>
+	/// <param name="cells">The cells ordered from the end back to (and excluding) the start</param>
+	/// <returns>The collection of waypoints along the path</returns>
+	const std::vector<Vec3> RetracePath(int start, int end, SearchArena& arena, std::vector<int>& cells);
+
+	/// <summary>
+	/// Simplifies the passed cells into waypoints, keeping only the
+	/// cells where the direction of travel changes.
+	/// </summary>
+	/// <param name="nodes">The cells ordered from the end back to (and excluding) the start</param>
+	/// <returns>The collection of waypoints along the path</returns>
+	const std::vector<Vec3> SimplifyPath(const std::vector<int>& nodes);
+
+	/// <summary>
+	/// Writes the penalties of the last blur into the cell map.
+	/// </summary>
+	void ApplyBlur();
+
+	/// <summary>
+	/// Writes the penalties of a blur of every cell into the cell map and
+	/// drops the search structures built on the previous penalties.
+	/// </summary>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> Blurred();
+
+	/// <summary>
+	/// Writes the penalties of a re-blur into the cell map, dropping the search
+	/// structures built on the previous penalties and stamping the re-blurred tiles.
+	/// </summary>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> Reblurred();
+
+	/// <summary>
+	/// Bumps the grid version and stamps every tile with it.
+	/// </summary>
+	void StampTiles();
+
+	/// <summary>
+	/// Bumps the grid version and stamps the tile containing the passed cell with it.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	void StampTile(int index);
+
+	/// <summary>
+	/// Forgets the oldest journaled edits once the journal is over capacity.
 	/// </summary>
-	/// <param name="start"></param>
-	/// <param name="end"></param>
-	/// <returns></returns>
-	const std::vector<Vec3> RetracePath(PathPoint start, PathPoint end);
+	void TrimJournal();
 };
\ No newline at end of file
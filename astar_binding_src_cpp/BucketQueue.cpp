@@ -0,0 +1,91 @@
+#include "pch.h"
+
+#include "BucketQueue.h"
+
+BucketQueue::BucketQueue()
+	: m_buckets(std::vector<std::vector<int>>()), m_keys(std::vector<int>()),
+		m_baseCost(-1), m_cursor(0), m_highest(-1), m_size(0)
+{
+}
+
+void BucketQueue::Reset(size_t size)
+{
+	if (m_keys.size() != size)
+	{
+		m_keys.assign(size, -1);
+	}
+	else
+	{
+		// Only the cells left queued by the previous search need clearing
+		for (int i = m_cursor; i <= m_highest; i++)
+		{
+			for (int index : m_buckets[i])
+			{
+				m_keys[index] = -1;
+			}
+		}
+	}
+	for (int i = 0; i <= m_highest; i++)
+	{
+		m_buckets[i].clear();
+	}
+	m_baseCost = -1;
+	m_cursor = 0;
+	m_highest = -1;
+	m_size = 0;
+}
+
+void BucketQueue::Add(int index, int fCost, int)
+{
+	int bucket = BucketOf(fCost);
+	m_buckets[bucket].push_back(index);
+	m_keys[index] = bucket;
+	m_size++;
+}
+
+int BucketQueue::RemoveFirst()
+{
+	while (true)
+	{
+		std::vector<int>& bucket = m_buckets[m_cursor];
+		while (!bucket.empty())
+		{
+			int index = bucket.back();
+			bucket.pop_back();
+
+			// Skip entries left behind by a decrease-key
+			if (m_keys[index] == m_cursor)
+			{
+				m_keys[index] = -1;
+				m_size--;
+				return index;
+			}
+		}
+		m_cursor++;
+	}
+}
+
+void BucketQueue::DecreaseKey(int index, int fCost, int)
+{
+	int bucket = BucketOf(fCost);
+	m_buckets[bucket].push_back(index);
+	m_keys[index] = bucket;
+}
+
+int BucketQueue::BucketOf(int fCost)
+{
+	if (m_baseCost < 0)
+	{
+		m_baseCost = fCost;
+	}
+
+	// An inconsistent cost can not go behind the cursor, it is
+	// served with the current minimum instead.
+	int bucket = std::max(fCost - m_baseCost, m_cursor);
+	if (bucket >= (int)m_buckets.size())
+	{
+		m_buckets.resize(bucket + 1);
+	}
+	m_highest = std::max(m_highest, bucket);
+	return bucket;
+}
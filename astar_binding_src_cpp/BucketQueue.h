@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pch.h"
+
+/// <summary>
+/// Class representing a Dial-style bucket priority queue of grid cells
+/// keyed by dense cell index. Relies on the integer F costs of the grid
+/// search never decreasing below the last popped cost (consistent
+/// heuristic), so the minimum is found by advancing a cursor over the
+/// buckets instead of comparing elements. Decrease-key pushes the cell
+/// into its new bucket and leaves the old entry to be skipped lazily.
+/// Cells of equal F cost are not ordered by their H cost like the heap
+/// orders them, ties are broken LIFO - the cell pushed last, usually the
+/// one reached deepest towards the target, is popped first.
+/// </summary>
+class BucketQueue
+{
+private:
+	std::vector<std::vector<int>> m_buckets;
+	std::vector<int> m_keys;
+	int m_baseCost, m_cursor, m_highest;
+	size_t m_size;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="BucketQueue"/> class.
+	/// </summary>
+	BucketQueue();
+
+	/// <summary>
+	/// Prepares the queue for a search over the passed number of cells,
+	/// removing any remaining elements.
+	/// </summary>
+	/// <param name="size">The number of cells within the grid</param>
+	void Reset(size_t size);
+
+	/// <summary>
+	/// Retrieves the number of cells within the queue.
+	/// </summary>
+	/// <returns>The size of the queue</returns>
+	inline const size_t Size() const { return m_size; }
+
+	/// <summary>
+	/// Determines whether the queue contains the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the queue contains the cell</returns>
+	inline const bool Contains(int index) const { return m_keys[index] >= 0; }
+
+	/// <summary>
+	/// Adds the passed cell into the queue.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="fCost">The F cost of the cell</param>
+	/// <param name="hCost">The H cost of the cell (unused, buckets are LIFO)</param>
+	void Add(int index, int fCost, int hCost);
+
+	/// <summary>
+	/// Pops a cell with the minimum F cost from the queue.
+	/// </summary>
+	/// <returns>The top minimum cell index</returns>
+	int RemoveFirst();
+
+	/// <summary>
+	/// Lowers the F cost of a cell already within the queue.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="fCost">The new F cost of the cell</param>
+	/// <param name="hCost">The new H cost of the cell (unused, buckets are LIFO)</param>
+	void DecreaseKey(int index, int fCost, int hCost);
+
+private:
+
+	/// <summary>
+	/// Retrieves the bucket slot of the passed F cost, growing
+	/// the bucket collection as necessary.
+	/// </summary>
+	/// <param name="fCost">The F cost</param>
+	/// <returns>The bucket slot</returns>
+	int BucketOf(int fCost);
+};
@@ -0,0 +1,62 @@
+#include "pch.h"
+
+#include "CellMap.h"
+
+CellMap::CellMap()
+	: m_width(0), m_height(0), m_stride(1), m_minPenalty(INT_MAX)
+{
+}
+
+void CellMap::Resize(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	m_stride = GetStride(width);
+	m_bits.assign((size_t)m_stride * (height + 2), 0);
+	m_penalties.assign((size_t)width * height, 0);
+	m_minPenalty = INT_MAX;
+}
+
+void CellMap::Load(int width, int height, const uint64_t* bits)
+{
+	Resize(width, height);
+	std::copy(bits, bits + m_bits.size(), m_bits.begin());
+}
+
+void CellMap::Set(int index, bool walkable, int penalty)
+{
+	int bit = index % m_width + 1;
+	uint64_t& word = m_bits[(index / m_width + 1) * m_stride + (bit >> 6)];
+	uint64_t mask = (uint64_t)1 << (bit & 63);
+	word = walkable ? word | mask : word & ~mask;
+	m_penalties[index] = penalty;
+	if (walkable && penalty < m_minPenalty)
+	{
+		m_minPenalty = penalty;
+	}
+}
+
+const unsigned int CellMap::GetNeighborMask(int index) const
+{
+	// The padded column of the left neighbor equals the cell column
+	int x = index % m_width, y = index / m_width;
+	return ReadBits(y, x) | (ReadBits(y + 1, x) << 3) | (ReadBits(y + 2, x) << 6);
+}
+
+int CellMap::GetWalkableNeighbors(int index, int* neighbors) const
+{
+	unsigned int mask = GetNeighborMask(index) & ~(1u << 4);
+	int count = 0;
+	for (int x = -1; x <= 1; x++)
+	{
+		for (int y = -1; y <= 1; y++)
+		{
+			if (mask & (1u << ((y + 1) * 3 + (x + 1))))
+			{
+				neighbors[count++] = index + x + y * m_width;
+			}
+		}
+	}
+	return count;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "pch.h"
+
+/// <summary>
+/// Class representing the compact search layout of the grid - a bit packed
+/// walkability map and a dense movement penalty array, the only place either
+/// is kept. The map is padded by a blocked cell on every side, so the
+/// walkability of all eight neighbors of a cell is read from three rows of
+/// bits with word operations instead of touching eight cells.
+/// </summary>
+class CellMap
+{
+private:
+	int m_width, m_height;
+	int m_stride;
+	std::vector<uint64_t> m_bits;
+	std::vector<int> m_penalties;
+
+	// No walkable cell has a lower penalty, lowered by edits but never raised
+	int m_minPenalty;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="CellMap"/> class.
+	/// </summary>
+	CellMap();
+
+	/// <summary>
+	/// Resizes the map to the passed dimensions, every cell blocked without penalty.
+	/// </summary>
+	/// <param name="width">The grid width</param>
+	/// <param name="height">The grid height</param>
+	void Resize(int width, int height);
+
+	/// <summary>
+	/// Resizes the map to the passed dimensions and copies the passed walkability
+	/// bits verbatim, every cell without penalty.
+	/// </summary>
+	/// <param name="width">The grid width</param>
+	/// <param name="height">The grid height</param>
+	/// <param name="bits">The padded rows of walkability bits, laid out like <see cref="GetBits"/></param>
+	void Load(int width, int height, const uint64_t* bits);
+
+	/// <summary>
+	/// Copies the passed penalties of every cell, after the walkability is loaded.
+	/// </summary>
+	/// <typeparam name="Penalty">The integer type the penalties are stored as</typeparam>
+	/// <param name="penalties">The penalties (x + y * width)</param>
+	template<typename Penalty>
+	void LoadPenalties(const Penalty* penalties)
+	{
+		std::copy(penalties, penalties + m_penalties.size(), m_penalties.begin());
+		m_minPenalty = INT_MAX;
+		for (int index = 0; index < (int)m_penalties.size(); index++)
+		{
+			if (m_penalties[index] < m_minPenalty && IsWalkable(index))
+			{
+				m_minPenalty = m_penalties[index];
+			}
+		}
+	}
+
+	/// <summary>
+	/// Updates the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="walkable">Whether the cell is walkable</param>
+	/// <param name="penalty">The movement penalty of the cell</param>
+	void Set(int index, bool walkable, int penalty);
+
+	/// <summary>
+	/// Updates the movement penalty of the passed cell, keeping its walkability.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="penalty">The movement penalty of the cell</param>
+	inline void SetPenalty(int index, int penalty)
+	{
+		m_penalties[index] = penalty;
+		if (penalty < m_minPenalty && IsWalkable(index))
+		{
+			m_minPenalty = penalty;
+		}
+	}
+
+	/// <summary>
+	/// Determines whether the passed cell is walkable.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the cell is walkable</returns>
+	inline const bool IsWalkable(int index) const
+	{
+		return IsWalkable(index % m_width, index / m_width);
+	}
+
+	/// <summary>
+	/// Determines whether the cell at the passed grid coordinates is walkable.
+	/// </summary>
+	/// <param name="x">X grid coordinate</param>
+	/// <param name="y">Y grid coordinate</param>
+	/// <returns>Whether the cell is walkable (false outside the grid)</returns>
+	inline const bool IsWalkable(int x, int y) const
+	{
+		if (x < 0 || x >= m_width || y < 0 || y >= m_height) { return false; }
+
+		int bit = x + 1;
+		return (m_bits[(y + 1) * m_stride + (bit >> 6)] >> (bit & 63)) & 1;
+	}
+
+	/// <summary>
+	/// Retrieves the movement penalty of the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The movement penalty</returns>
+	inline const int GetPenalty(int index) const { return m_penalties[index]; }
+
+	/// <summary>
+	/// Retrieves the movement penalties of every cell.
+	/// </summary>
+	/// <returns>The penalties (x + y * width)</returns>
+	inline const int* GetPenalties() const { return m_penalties.data(); }
+
+	/// <summary>
+	/// Forgets the lower bound on the walkable penalties, to be
+	/// found again as every penalty is set anew.
+	/// </summary>
+	inline void ResetMinPenalty() { m_minPenalty = INT_MAX; }
+
+	/// <summary>
+	/// Retrieves a lower bound on the movement penalty of every walkable cell.
+	/// </summary>
+	/// <returns>The minimum movement penalty (0 if no cell is walkable)</returns>
+	inline const int GetMinPenalty() const { return m_minPenalty == INT_MAX ? 0 : std::max(m_minPenalty, 0); }
+
+	/// <summary>
+	/// Retrieves the padded rows of walkability bits, a blocked cell on every
+	/// side of the grid and <see cref="GetStride"/> words per row.
+	/// </summary>
+	/// <returns>The walkability bits</returns>
+	inline const std::vector<uint64_t>& GetBits() const { return m_bits; }
+
+	/// <summary>
+	/// Calculates the words per padded row of walkability bits of a grid
+	/// of the passed width.
+	/// </summary>
+	/// <param name="width">The grid width</param>
+	/// <returns>The words per row</returns>
+	inline static const int GetStride(int width)
+	{
+		// One padding bit either side, plus a spare word so three bits can always be read
+		return (width + 2) / 64 + 2;
+	}
+
+	/// <summary>
+	/// Retrieves the walkability of the 3x3 block centered on the passed cell,
+	/// bit (y + 1) * 3 + (x + 1) holding the cell at offset (x, y).
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The walkability mask</returns>
+	const unsigned int GetNeighborMask(int index) const;
+
+	/// <summary>
+	/// Retrieves the walkable neighbors of the passed cell without allocating,
+	/// in the same order as <see cref="Grid::GetNeighborIndices"/>.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="neighbors">The buffer to fill (at least 8 elements)</param>
+	/// <returns>The number of neighbors written</returns>
+	int GetWalkableNeighbors(int index, int* neighbors) const;
+
+private:
+
+	/// <summary>
+	/// Reads three consecutive bits of a padded row.
+	/// </summary>
+	/// <param name="row">The padded row</param>
+	/// <param name="bit">The first padded bit</param>
+	/// <returns>The three bits</returns>
+	inline const unsigned int ReadBits(int row, int bit) const
+	{
+		const uint64_t* words = &m_bits[row * m_stride + (bit >> 6)];
+		int shift = bit & 63;
+		uint64_t value = words[0] >> shift;
+		if (shift > 61)
+		{
+			value |= words[1] << (64 - shift);
+		}
+		return (unsigned int)(value & 7);
+	}
+};
@@ -0,0 +1,181 @@
+#include "pch.h"
+#include <cmath>
+
+#include "CompactGrid.h"
+
+/// <summary>
+/// Calculates the height between consecutive codes covering the passed range,
+/// a power of two so heights on a multiple of it are rebuilt exactly.
+/// </summary>
+/// <param name="lowest">The lowest height</param>
+/// <param name="highest">The highest height</param>
+/// <returns>The height step (0 - a single height)</returns>
+static float HeightStep(float lowest, float highest)
+{
+	float needed = (highest - lowest) / (CELL_EXPLICIT - 1);
+	if (!(needed > 0.0f)) { return 0.0f; }
+
+	int exponent;
+	float mantissa = std::frexp(needed, &exponent);
+	return std::ldexp(1.0f, mantissa == 0.5f ? exponent - 1 : exponent);
+}
+
+CompactGrid::CompactGrid(size_t width, size_t height)
+	: Grid<uint16_t>(width, height), m_width((int)width),
+		m_originX(0.0f), m_originZ(0.0f), m_spacingX(0.0f), m_spacingZ(0.0f), m_latticeX(false), m_latticeZ(false),
+		m_anchorRow(0), m_anchorCol(0), m_anchor(Vec3()), m_anchored(false),
+		m_heightMin(0.0f), m_heightStep(0.0f), m_heights(false), m_emptyCode(0)
+{
+}
+
+void CompactGrid::SetPosition(int row, int col, const Vec3& position)
+{
+	if (!m_anchored)
+	{
+		m_anchorRow = row;
+		m_anchorCol = col;
+		m_anchor = position;
+		m_anchored = true;
+	}
+	if (!m_heights)
+	{
+		m_heightMin = position.y;
+		m_heightStep = 0.0f;
+		m_heights = true;
+	}
+
+	// The spacing along an axis is known once a cell off the anchor's row or column is placed
+	bool settled = m_latticeX && m_latticeZ;
+	if (!m_latticeX && (row != m_anchorRow || GetWidth() == 1))
+	{
+		m_spacingX = row != m_anchorRow ? (position.x - m_anchor.x) / (row - m_anchorRow) : 1.0f;
+		m_originX = m_anchor.x - m_anchorRow * m_spacingX;
+		m_latticeX = true;
+	}
+	if (!m_latticeZ && (col != m_anchorCol || GetHeight() == 1))
+	{
+		m_spacingZ = col != m_anchorCol ? (position.z - m_anchor.z) / (col - m_anchorCol) : 1.0f;
+		m_originZ = m_anchor.z - m_anchorCol * m_spacingZ;
+		m_latticeZ = true;
+	}
+
+	int index = GetIndex(row, col);
+	uint16_t code = Encode(row, col, position);
+	if (code == CELL_EXPLICIT)
+	{
+		m_explicit[index] = position;
+	}
+	else if (!m_explicit.empty())
+	{
+		m_explicit.erase(index);
+	}
+	Set(row, col, code);
+
+	if (!settled && m_latticeX && m_latticeZ)
+	{
+		Settle();
+	}
+}
+
+void CompactGrid::FitHeights(float lowest, float highest)
+{
+	if (!m_heights)
+	{
+		m_heightMin = lowest;
+		m_heightStep = HeightStep(lowest, highest);
+		m_heights = true;
+		return;
+	}
+
+	float top = m_heightMin + (CELL_EXPLICIT - 1) * m_heightStep;
+	if (lowest >= m_heightMin && highest <= top) { return; }
+
+	// Every placed code is requantised into the widened range, the matrix
+	// rebuilt so the empty cells of a sparse grid stay unstored
+	float oldMin = m_heightMin, oldStep = m_heightStep;
+	m_heightMin = std::min(lowest, oldMin);
+	m_heightStep = HeightStep(m_heightMin, std::max(highest, top));
+	auto requantise = [&](uint16_t code) { return code == CELL_EXPLICIT ? code : Quantise(oldMin + code * oldStep); };
+
+	Matrix<uint16_t> rebased(GetWidth(), GetHeight());
+	m_emptyCode = requantise(m_emptyCode);
+	rebased.SetEmpty(m_emptyCode);
+	for (int index = 0; index < (int)GetSize(); index++)
+	{
+		rebased.Set(GetRow(index), GetCol(index), requantise(m_matrix.Get(index)));
+	}
+	m_matrix = std::move(rebased);
+	Settle();
+}
+
+void CompactGrid::SetLattice(float originX, float originZ, float spacingX, float spacingZ, float heightMin, float heightStep)
+{
+	m_originX = originX;
+	m_originZ = originZ;
+	m_spacingX = spacingX;
+	m_spacingZ = spacingZ;
+	m_latticeX = m_latticeZ = true;
+	m_anchored = true;
+	m_heightMin = heightMin;
+	m_heightStep = heightStep;
+	m_heights = true;
+	Settle();
+}
+
+void CompactGrid::SetEmptyHeight(float height)
+{
+	uint16_t code = Quantise(height);
+	if (code != CELL_EXPLICIT && SetEmpty(code))
+	{
+		m_emptyCode = code;
+	}
+}
+
+void CompactGrid::LoadCodes(const uint16_t* codes, uint16_t emptyCode)
+{
+	if (SetEmpty(emptyCode))
+	{
+		m_emptyCode = emptyCode;
+	}
+	for (int index = 0; index < (int)GetSize(); index++)
+	{
+		Set(GetRow(index), GetCol(index), codes[index]);
+	}
+}
+
+const uint16_t CompactGrid::Encode(int row, int col, const Vec3& position) const
+{
+	if (!m_latticeX || !m_latticeZ) { return CELL_EXPLICIT; }
+
+	float tolerance = 1e-4f * std::max(1.0f, std::max(std::fabs(m_spacingX), std::fabs(m_spacingZ)));
+	if (std::fabs(position.x - (m_originX + row * m_spacingX)) > tolerance ||
+		std::fabs(position.z - (m_originZ + col * m_spacingZ)) > tolerance)
+	{
+		return CELL_EXPLICIT;
+	}
+	return Quantise(position.y);
+}
+
+const uint16_t CompactGrid::Quantise(float height) const
+{
+	if (!(m_heightStep > 0.0f)) { return height == m_heightMin ? 0 : CELL_EXPLICIT; }
+
+	float code = std::round((height - m_heightMin) / m_heightStep);
+	return code >= 0.0f && code < (float)CELL_EXPLICIT ? (uint16_t)code : CELL_EXPLICIT;
+}
+
+void CompactGrid::Settle()
+{
+	for (auto explicitCell = m_explicit.begin(); explicitCell != m_explicit.end();)
+	{
+		int row = GetRow(explicitCell->first), col = GetCol(explicitCell->first);
+		uint16_t code = Encode(row, col, explicitCell->second);
+		if (code == CELL_EXPLICIT)
+		{
+			explicitCell++;
+			continue;
+		}
+		Set(row, col, code);
+		explicitCell = m_explicit.erase(explicitCell);
+	}
+}
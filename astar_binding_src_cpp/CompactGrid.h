@@ -0,0 +1,164 @@
+#pragma once
+
+#include "pch.h"
+#include "Grid.h"
+
+// Height code of a cell whose position does not fit the lattice or the
+// height range, its position kept in full instead
+#define CELL_EXPLICIT UINT16_MAX
+
+/// <summary>
+/// Class representing the static grid in compact form, a quantised 16 bit
+/// height per cell. The world position of a cell is derived from its grid
+/// coordinate on the lattice the grid points lie on, found from the first
+/// points placed along each axis, and its height code. Walkability and
+/// penalties are only kept in the <see cref="CellMap"/>, and the search
+/// state only in the search contexts. Cells off the lattice or outside the
+/// height range keep their position in full, so nothing is lost on grids
+/// that are not regular.
+/// </summary>
+class CompactGrid : public Grid<uint16_t>
+{
+private:
+	int m_width;
+
+	// Cell (row, col) lies at (originX + row * spacingX, height, originZ + col * spacingZ)
+	float m_originX, m_originZ;
+	float m_spacingX, m_spacingZ;
+	bool m_latticeX, m_latticeZ;
+
+	// First placed cell, the lattice spacing taken from the next ones along each axis
+	int m_anchorRow, m_anchorCol;
+	Vec3 m_anchor;
+	bool m_anchored;
+
+	// Heights quantised to heightMin + code * heightStep
+	float m_heightMin, m_heightStep;
+	bool m_heights;
+
+	// Code of the cells a sparse grid never stored
+	uint16_t m_emptyCode;
+
+	// Positions of the cells coded CELL_EXPLICIT
+	std::unordered_map<int, Vec3> m_explicit;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="CompactGrid"/> class.
+	/// </summary>
+	/// <param name="width">The width of the grid</param>
+	/// <param name="height">The height of the grid</param>
+	CompactGrid(size_t width, size_t height);
+
+	/// <summary>
+	/// Places the passed cell at the passed world position.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <param name="position">The world position</param>
+	void SetPosition(int row, int col, const Vec3& position);
+
+	/// <summary>
+	/// Retrieves the world position of the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The world position</returns>
+	inline const Vec3 GetPosition(int index)
+	{
+		uint16_t code = Get(index);
+		if (code == CELL_EXPLICIT) { return m_explicit.at(index); }
+
+		int row = index % m_width, col = index / m_width;
+		return Vec3(m_originX + row * m_spacingX, m_heightMin + code * m_heightStep, m_originZ + col * m_spacingZ);
+	}
+
+	/// <summary>
+	/// Widens the height range to hold the heights of a batch about to be
+	/// placed, requantising the placed cells when it grows.
+	/// </summary>
+	/// <param name="lowest">The lowest height of the batch</param>
+	/// <param name="highest">The highest height of the batch</param>
+	void FitHeights(float lowest, float highest);
+
+	/// <summary>
+	/// Sets the lattice and height range outright, ahead of placing cells
+	/// known to lie on them.
+	/// </summary>
+	/// <param name="originX">The x world coordinate of row 0</param>
+	/// <param name="originZ">The z world coordinate of column 0</param>
+	/// <param name="spacingX">The x world distance between rows</param>
+	/// <param name="spacingZ">The z world distance between columns</param>
+	/// <param name="heightMin">The height of code 0</param>
+	/// <param name="heightStep">The height between consecutive codes</param>
+	void SetLattice(float originX, float originZ, float spacingX, float spacingZ, float heightMin, float heightStep);
+
+	/// <summary>
+	/// Sets the height read back from the cells of a sparse grid that were never
+	/// stored, only taken over while nothing is stored yet.
+	/// </summary>
+	/// <param name="height">The height of the empty cells</param>
+	void SetEmptyHeight(float height);
+
+	/// <summary>
+	/// Copies the passed height codes of every cell, quantised on the lattice and
+	/// height range already set. A sparse grid leaves the cells of the passed empty
+	/// code unstored.
+	/// </summary>
+	/// <param name="codes">The height codes (x + y * width), none of them CELL_EXPLICIT</param>
+	/// <param name="emptyCode">The code of the cells a sparse grid need not store</param>
+	void LoadCodes(const uint16_t* codes, uint16_t emptyCode);
+
+	/// <summary>
+	/// Retrieves the lattice of the grid.
+	/// </summary>
+	/// <returns>A tuple containing the x and z origin and the x and z spacing</returns>
+	inline const std::tuple<float, float, float, float> GetLattice() const
+	{
+		return std::make_tuple(m_originX, m_originZ, m_spacingX, m_spacingZ);
+	}
+
+	/// <summary>
+	/// Retrieves the height range of the grid.
+	/// </summary>
+	/// <returns>A tuple containing the height of code 0 and the height between codes</returns>
+	inline const std::tuple<float, float> GetHeightRange() const { return std::make_tuple(m_heightMin, m_heightStep); }
+
+	/// <summary>
+	/// Retrieves the number of cells keeping their position in full.
+	/// </summary>
+	/// <returns>The number of explicit cells</returns>
+	inline const size_t GetExplicit() const { return m_explicit.size(); }
+
+	/// <summary>
+	/// Retrieves the bytes held by the grid, roughly for the explicit cells.
+	/// </summary>
+	/// <returns>The number of bytes</returns>
+	inline const size_t GetBytes() const
+	{
+		return GetStored() * sizeof(uint16_t) + m_explicit.size() * (sizeof(int) + sizeof(Vec3) + 2 * sizeof(void*));
+	}
+
+private:
+
+	/// <summary>
+	/// Encodes the height of the passed position, if the cell lies on the lattice.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <param name="position">The world position</param>
+	/// <returns>The height code (CELL_EXPLICIT - not on the lattice or outside the height range)</returns>
+	const uint16_t Encode(int row, int col, const Vec3& position) const;
+
+	/// <summary>
+	/// Encodes the passed height within the height range.
+	/// </summary>
+	/// <param name="height">The height</param>
+	/// <returns>The height code (CELL_EXPLICIT - outside the height range)</returns>
+	const uint16_t Quantise(float height) const;
+
+	/// <summary>
+	/// Moves the explicit cells that fit the lattice and height range back into the grid.
+	/// </summary>
+	void Settle();
+};
@@ -0,0 +1,151 @@
+#include "pch.h"
+
+#include "ConnectedComponents.h"
+#include "AStar.h"
+
+/// <summary>
+/// Offsets of the eight neighbors ordered around the center cell.
+/// </summary>
+static const int s_ring[8][2] = { { -1, -1 }, { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 } };
+
+ConnectedComponents::ConnectedComponents()
+	: m_dirty(true)
+{
+}
+
+void ConnectedComponents::Prepare(AStar& astar)
+{
+	if (!m_dirty) { return; }
+
+	const CellMap& cells = astar.GetCells();
+	int size = astar.GetGrid().GetSize();
+	m_labels.assign(size, -1);
+	m_parents.clear();
+	m_sizes.clear();
+	for (int index = 0; index < size; index++)
+	{
+		if (cells.IsWalkable(index) && m_labels[index] < 0)
+		{
+			Flood(astar, index, AddLabel());
+		}
+	}
+	m_dirty = false;
+}
+
+void ConnectedComponents::Update(AStar& astar, int index)
+{
+	if (m_dirty) { return; }
+
+	const CellMap& cells = astar.GetCells();
+	bool walkable = cells.IsWalkable(index);
+	if (walkable == (m_labels[index] >= 0)) { return; }
+
+	int neighbors[8];
+	int count = cells.GetWalkableNeighbors(index, neighbors);
+	if (walkable)
+	{
+		// Opening a cell joins every component around it
+		int root = AddLabel();
+		m_sizes[root] = 1;
+		for (int i = 0; i < count; i++)
+		{
+			root = Join(root, m_labels[neighbors[i]]);
+		}
+		m_labels[index] = root;
+		return;
+	}
+
+	int root = Root(m_labels[index]);
+	m_labels[index] = -1;
+	m_sizes[root]--;
+
+	// Neighbors that still touch each other around the closed cell stay
+	// connected, only separate groups of them may have been split apart
+	unsigned int mask = cells.GetNeighborMask(index);
+	int groups[8];
+	int groupCount = 0;
+	for (int i = 0; i < 8; i++)
+	{
+		groups[i] = -1;
+		if (!(mask & (1u << ((s_ring[i][1] + 1) * 3 + (s_ring[i][0] + 1))))) { continue; }
+
+		groups[i] = groupCount++;
+		for (int j = 0; j < i; j++)
+		{
+			if (groups[j] < 0 || groups[j] == groups[i] || abs(s_ring[i][0] - s_ring[j][0]) > 1 || abs(s_ring[i][1] - s_ring[j][1]) > 1) { continue; }
+
+			// Merge the earlier group into this one
+			int merged = groups[j];
+			for (int k = 0; k <= i; k++)
+			{
+				if (groups[k] == merged) { groups[k] = groups[i]; }
+			}
+			groupCount--;
+		}
+	}
+	if (groupCount <= 1) { return; }
+
+	// Relabel the component from every neighbor, a flood reaching another
+	// neighbor proves the split did not happen there
+	CompactGrid& grid = astar.GetGrid();
+	int first = (int)m_parents.size();
+	for (int i = 0; i < count; i++)
+	{
+		if (m_labels[neighbors[i]] < first)
+		{
+			Flood(astar, neighbors[i], AddLabel());
+		}
+	}
+
+	// Rebuild from scratch once abandoned labels outnumber the cells
+	if (m_parents.size() > 2 * grid.GetSize())
+	{
+		m_dirty = true;
+		Prepare(astar);
+	}
+}
+
+int ConnectedComponents::Join(int first, int second)
+{
+	first = Root(first);
+	second = Root(second);
+	if (first == second) { return first; }
+
+	if (m_sizes[first] < m_sizes[second])
+	{
+		std::swap(first, second);
+	}
+	m_parents[second] = first;
+	m_sizes[first] += m_sizes[second];
+	return first;
+}
+
+void ConnectedComponents::Flood(AStar& astar, int seed, int label)
+{
+	const CellMap& cells = astar.GetCells();
+	int neighbors[8];
+
+	m_queue.clear();
+	m_queue.push_back(seed);
+	m_labels[seed] = label;
+	for (size_t head = 0; head < m_queue.size(); head++)
+	{
+		int count = cells.GetWalkableNeighbors(m_queue[head], neighbors);
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+			if (m_labels[neighbor] == label) { continue; }
+
+			m_labels[neighbor] = label;
+			m_queue.push_back(neighbor);
+		}
+	}
+	m_sizes[label] = (int)m_queue.size();
+}
+
+int ConnectedComponents::AddLabel()
+{
+	m_parents.push_back((int)m_parents.size());
+	m_sizes.push_back(0);
+	return (int)m_parents.size() - 1;
+}
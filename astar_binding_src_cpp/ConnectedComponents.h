@@ -0,0 +1,118 @@
+#pragma once
+
+#include "pch.h"
+
+class AStar;
+
+/// <summary>
+/// Class representing the connected component labels of the walkable
+/// cells (8-connected, matching the search moves). Queries between two
+/// components are rejected in constant time instead of exhausting the
+/// search. Opening a cell merges the components around it through a
+/// union-find, closing one relabels its component only if its walkable
+/// neighbors no longer touch each other. Wholesale edits are relabeled
+/// by <see cref="Prepare"/>, after which queries only read the labels.
+/// </summary>
+class ConnectedComponents
+{
+private:
+	bool m_dirty;
+
+	// Label of every cell (-1 if blocked), the union-find parent
+	// and the cell count of every label
+	std::vector<int> m_labels;
+	std::vector<int> m_parents;
+	std::vector<int> m_sizes;
+	std::vector<int> m_queue;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="ConnectedComponents"/> class.
+	/// </summary>
+	ConnectedComponents();
+
+	/// <summary>
+	/// Marks the labels to be rebuilt by the next <see cref="Prepare"/>.
+	/// </summary>
+	inline void Invalidate() { m_dirty = true; }
+
+	/// <summary>
+	/// Determines whether the labels are current.
+	/// </summary>
+	/// <returns>Whether the labels are current</returns>
+	inline const bool IsValid() const { return !m_dirty; }
+
+	/// <summary>
+	/// Relabels every cell if the labels have been invalidated.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	void Prepare(AStar& astar);
+
+	/// <summary>
+	/// Updates the labels around the passed edited cell.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="index">The edited cell index</param>
+	void Update(AStar& astar, int index);
+
+	/// <summary>
+	/// Determines whether the passed walkable cells are connected.
+	/// </summary>
+	/// <param name="from">The first cell index</param>
+	/// <param name="to">The second cell index</param>
+	/// <returns>Whether a path between the cells exists</returns>
+	inline const bool Connected(int from, int to) const
+	{
+		return m_labels[from] >= 0 && Root(m_labels[from]) == Root(m_labels[to]);
+	}
+
+	/// <summary>
+	/// Retrieves the number of cells in the component of the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The component size (0 if the cell is blocked)</returns>
+	inline const int GetSize(int index) const
+	{
+		return m_labels[index] >= 0 ? m_sizes[Root(m_labels[index])] : 0;
+	}
+
+private:
+
+	/// <summary>
+	/// Finds the root label of the passed label without modifying the
+	/// union-find, so concurrent queries only read.
+	/// </summary>
+	/// <param name="label">The label</param>
+	/// <returns>The root label</returns>
+	inline const int Root(int label) const
+	{
+		while (m_parents[label] != label)
+		{
+			label = m_parents[label];
+		}
+		return label;
+	}
+
+	/// <summary>
+	/// Joins the components of the passed labels, the smaller below the larger.
+	/// </summary>
+	/// <param name="first">The first label</param>
+	/// <param name="second">The second label</param>
+	/// <returns>The root label of the joined component</returns>
+	int Join(int first, int second);
+
+	/// <summary>
+	/// Labels every walkable cell reachable from the passed cell.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="seed">The cell index to start from</param>
+	/// <param name="label">The new label</param>
+	void Flood(AStar& astar, int seed, int label);
+
+	/// <summary>
+	/// Adds a new label.
+	/// </summary>
+	/// <returns>The new label</returns>
+	int AddLabel();
+};
@@ -0,0 +1,121 @@
+#include "pch.h"
+
+#include "FlowField.h"
+#include "AStar.h"
+
+FlowField::FlowField()
+	: m_target(-1), m_version(0), m_valid(false)
+{
+}
+
+void FlowField::Compute(AStar& astar, int target)
+{
+	CompactGrid& grid = astar.GetGrid();
+	bool current = m_valid && m_version == astar.GetVersion() && m_costs.size() == grid.GetSize();
+	if (current && target == m_target) { return; }
+
+	Sweep(astar, target, current);
+	m_target = target;
+	m_version = astar.GetVersion();
+	m_valid = true;
+}
+
+void FlowField::Sweep(AStar& astar, int target, bool incremental)
+{
+	CompactGrid& grid = astar.GetGrid();
+	int size = grid.GetSize();
+	if (!incremental)
+	{
+		m_costs.assign(size, INT_MAX);
+		m_next.assign(size, -1);
+	}
+
+	m_arena.Begin(size);
+	m_open.Reset(size);
+	m_touched.clear();
+	if (!astar.IsWalkable(target)) { incremental = false; }
+	else
+	{
+		m_arena.Open(target, 0, 0, -1);
+		m_open.Add(target, 0, 0);
+		m_touched.push_back(target);
+	}
+
+	// Cost from the previous target to the new one, known once it is settled.
+	// Until then unvisited cells are treated as unreached, afterwards as their
+	// previous cost offset by it - exact whenever no cheaper path is relaxed.
+	int previous = m_target;
+	int offset = -1;
+
+	int neighbors[8];
+	while (m_open.Size() > 0)
+	{
+		int current = m_open.RemoveFirst();
+		m_arena.Close(current);
+
+		int currentG = m_arena[current].gCost;
+		m_costs[current] = currentG;
+		m_next[current] = m_arena[current].parent;
+
+		if (incremental && current == previous)
+		{
+			offset = currentG;
+
+			// Queued cells may already be cheaper through the previous target
+			for (int index : m_touched)
+			{
+				if (!m_arena.IsOpen(index) || m_costs[index] == INT_MAX) { continue; }
+
+				SearchNode& node = m_arena[index];
+				if (m_costs[index] + offset < node.gCost)
+				{
+					node.gCost = m_costs[index] + offset;
+					node.parent = m_next[index];
+					m_open.DecreaseKey(index, node.gCost, 0);
+				}
+			}
+		}
+
+		int count = astar.GetCells().GetWalkableNeighbors(current, neighbors);
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+			if (m_arena.IsClosed(neighbor)) { continue; }
+
+			// Stepping from the neighbor onto the current cell
+			int newMoveCost = currentG + astar.MoveCost(neighbor, current);
+			if (m_arena.IsOpen(neighbor))
+			{
+				SearchNode& node = m_arena[neighbor];
+				if (newMoveCost < node.gCost)
+				{
+					node.gCost = newMoveCost;
+					node.parent = current;
+					m_open.DecreaseKey(neighbor, newMoveCost, 0);
+				}
+			}
+			else if (offset < 0 || m_costs[neighbor] == INT_MAX || newMoveCost < m_costs[neighbor] + offset)
+			{
+				m_arena.Open(neighbor, newMoveCost, 0, current);
+				m_open.Add(neighbor, newMoveCost, 0);
+				m_touched.push_back(neighbor);
+			}
+		}
+	}
+
+	// Cells left unvisited keep their direction, reaching the target through the previous one
+	for (int index = 0; index < size; index++)
+	{
+		if (m_arena.IsClosed(index)) { continue; }
+
+		if (offset >= 0 && m_costs[index] != INT_MAX)
+		{
+			m_costs[index] += offset;
+		}
+		else
+		{
+			m_costs[index] = INT_MAX;
+			m_next[index] = -1;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "pch.h"
+#include "SearchArena.h"
+#include "BucketQueue.h"
+
+class AStar;
+
+/// <summary>
+/// Class representing a flow field towards a single target cell - the
+/// integration field (cost of the cheapest path from every cell to the
+/// target, movement penalties included) and the direction field (the next
+/// cell along that path). Agents sharing the target read their next step
+/// in constant time instead of searching individually.
+/// </summary>
+class FlowField
+{
+private:
+	int m_target;
+	unsigned int m_version;
+	bool m_valid;
+	std::vector<int> m_costs;
+	std::vector<int> m_next;
+	std::vector<int> m_touched;
+	SearchArena m_arena;
+	BucketQueue m_open;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="FlowField"/> class.
+	/// </summary>
+	FlowField();
+
+	/// <summary>
+	/// Computes the field towards the passed target. Moving the target of a
+	/// field computed against the current grid version only re-sweeps the cells
+	/// whose cost is not simply offset through the previous target, any grid
+	/// edit since the last computation rebuilds the whole field.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="target">The target cell index</param>
+	void Compute(AStar& astar, int target);
+
+	/// <summary>
+	/// Retrieves the target cell index of the field.
+	/// </summary>
+	/// <returns>The target cell index (-1 if never computed)</returns>
+	inline const int GetTarget() const { return m_target; }
+
+	/// <summary>
+	/// Retrieves the grid version the field was computed against.
+	/// </summary>
+	/// <returns>The grid version</returns>
+	inline const unsigned int GetVersion() const { return m_version; }
+
+	/// <summary>
+	/// Retrieves the cost of the cheapest path from the passed cell to the target.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The path cost (INT_MAX if the target is unreachable)</returns>
+	inline const int GetCost(int index) const { return m_valid ? m_costs[index] : INT_MAX; }
+
+	/// <summary>
+	/// Retrieves the next cell along the cheapest path from the passed cell to the target.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The next cell index (-1 at the target or if it is unreachable)</returns>
+	inline const int GetNext(int index) const { return m_valid ? m_next[index] : -1; }
+
+private:
+
+	/// <summary>
+	/// Runs the reverse Dijkstra sweep from the target. An incremental sweep
+	/// treats every unvisited cell as reaching the new target through the
+	/// previous one, relaxing only the cells a cheaper path is found for.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="incremental">Whether the previous field may be reused</param>
+	void Sweep(AStar& astar, int target, bool incremental);
+};
@@ -21,11 +21,12 @@ inline float clamp(float n, float lower, float upper)
 /// Class representing a 2-dimensional grid.
 /// </summary>
 /// <typeparam name="T">The type of elements within the grid</typeparam>
-template<typename T>
+/// <typeparam name="Layout">The storage order of the elements</typeparam>
+template<typename T, typename Layout = GRID_LAYOUT>
 class Grid
 {
 protected:
-	Matrix<T> m_matrix;
+	Matrix<T, Layout> m_matrix;
 public:
 
 	/// <summary>
@@ -34,7 +35,7 @@ public:
 	/// <param name="width">The width of the grid</param>
 	/// <param name="height">The height of the grid</param>
 	Grid(size_t width, size_t height)
-		: m_matrix(Matrix<T>(width, height))
+		: m_matrix(Matrix<T, Layout>(width, height))
 	{
 	}
 
@@ -50,6 +51,51 @@ public:
 	/// <returns>The height of the grid</returns>
 	const size_t GetHeight() { return m_matrix.GetHeight(); }
 
+	/// <summary>
+	/// Retrieves the number of cells within the grid.
+	/// </summary>
+	/// <returns>The number of cells</returns>
+	const size_t GetSize() { return m_matrix.GetSize(); }
+
+	/// <summary>
+	/// Retrieves the dense cell index of the passed row and column index.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The cell index (row + col * width)</returns>
+	const int GetIndex(unsigned int row, unsigned int col) { return row + (col * (int)GetWidth()); }
+
+	/// <summary>
+	/// Retrieves the dense cell index at the estimated
+	/// index to the passed world coordinate.
+	/// </summary>
+	/// <param name="coordinate">The world coordinate</param>
+	/// <returns>The cell index</returns>
+	const int GetIndex(Vec3 coordinate)
+	{
+		float xPercent = (coordinate.x + (GetWidth() / 2.0f)) / GetWidth();
+		float yPercent = (coordinate.z + (GetHeight() / 2.0f)) / GetHeight();
+
+		xPercent = clamp(xPercent, 0.0f, 1.0f);
+		yPercent = clamp(yPercent, 0.0f, 1.0f);
+
+		return GetIndex(std::round((GetWidth() - 1) * xPercent), std::round((GetHeight() - 1) * yPercent));
+	}
+
+	/// <summary>
+	/// Retrieves the row index of the passed cell index.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The row index</returns>
+	const int GetRow(int index) { return index % (int)GetWidth(); }
+
+	/// <summary>
+	/// Retrieves the column index of the passed cell index.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The column index</returns>
+	const int GetCol(int index) { return index / (int)GetWidth(); }
+
 	/// <summary>
 	/// Retrieves the element within the grid at the passed
 	/// row and column index.
@@ -74,6 +120,66 @@ public:
 		return Find(row, col);
 	}
 
+	/// <summary>
+	/// Retrieves the element within the grid at the passed
+	/// dense cell index.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The reference to the element at the index</returns>
+	T& operator[](int index)
+	{
+		return m_matrix[index];
+	}
+
+	/// <summary>
+	/// Retrieves the element within the grid at the passed
+	/// row and column index for reading, never storing a cell.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The reference to the element at the index</returns>
+	const T& Get(unsigned int row, unsigned int col) const
+	{
+		return m_matrix.Get(row, col);
+	}
+
+	/// <summary>
+	/// Retrieves the element within the grid at the passed
+	/// dense cell index for reading, never storing a cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The reference to the element at the index</returns>
+	const T& Get(int index) const
+	{
+		return m_matrix.Get(index);
+	}
+
+	/// <summary>
+	/// Sets the element within the grid at the passed row and column index.
+	/// A sparse grid does not store elements reading as its empty element.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <param name="value">The element</param>
+	void Set(unsigned int row, unsigned int col, const T& value)
+	{
+		m_matrix.Set(row, col, value);
+	}
+
+	/// <summary>
+	/// Sets the element read back from the cells of a sparse grid that were
+	/// never stored, only taken over while nothing is stored yet.
+	/// </summary>
+	/// <param name="value">The empty element</param>
+	/// <returns>Whether the empty element was taken over</returns>
+	const bool SetEmpty(const T& value) { return m_matrix.SetEmpty(value); }
+
+	/// <summary>
+	/// Retrieves the number of elements held in memory.
+	/// </summary>
+	/// <returns>The number of stored elements</returns>
+	const size_t GetStored() const { return m_matrix.GetStored(); }
+
 	/// <summary>
 	/// Retrieves the element within the grid at the estimated
 	/// index to the passed world coordiante.
@@ -82,13 +188,7 @@ public:
 	/// <returns>The reference to the element at the index</returns>
 	T& operator()(Vec3 coordinate)
 	{
-		float xPercent = (coordinate.x + (GetWidth() / 2.0f)) / GetWidth();
-		float yPercent = (coordinate.z + (GetHeight() / 2.0f)) / GetHeight();
-
-		xPercent = clamp(xPercent, 0.0f, 1.0f);
-		yPercent = clamp(yPercent, 0.0f, 1.0f);
-
-		return Find(std::round((GetWidth() - 1) * xPercent), std::round((GetHeight() - 1) * yPercent));
+		return m_matrix[GetIndex(coordinate)];
 	}
 
 	/// <summary>
@@ -112,13 +212,43 @@ public:
 
 				if (xCheck >= 0 && xCheck < GetWidth() && yCheck >= 0 && yCheck < GetHeight())
 				{
-					neighbors.push_back(m_matrix(xCheck, yCheck));
+					neighbors.push_back(m_matrix.Get(xCheck, yCheck));
 				}
 			}
 		}
 		return neighbors;
 	}
 
+	/// <summary>
+	/// Retrieves the cell indices of the neighbors to the passed
+	/// cell index without allocating.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="neighbors">The buffer to fill (at least 8 elements)</param>
+	/// <returns>The number of neighbors written</returns>
+	int GetNeighborIndices(int index, int* neighbors)
+	{
+		int width = GetWidth(), height = GetHeight();
+		int row = GetRow(index), col = GetCol(index);
+		int count = 0;
+		for (int x = -1; x <= 1; x++)
+		{
+			for (int y = -1; y <= 1; y++)
+			{
+				if (x == 0 && y == 0) { continue; }
+
+				int xCheck = row + x;
+				int yCheck = col + y;
+
+				if (xCheck >= 0 && xCheck < width && yCheck >= 0 && yCheck < height)
+				{
+					neighbors[count++] = xCheck + (yCheck * width);
+				}
+			}
+		}
+		return count;
+	}
+
 	/// <summary>
 	/// Retrieves all of the elements within the grid.
 	/// </summary>
@@ -130,7 +260,7 @@ public:
 		{
 			for (unsigned int j = 0; j < GetHeight(); j++)
 			{
-				results.push_back(m_matrix(i, j));
+				results.push_back(m_matrix.Get(i, j));
 			}
 		}
 		return results;
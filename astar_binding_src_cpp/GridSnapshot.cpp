@@ -0,0 +1,178 @@
+#include "pch.h"
+#include <cstring>
+
+#include "GridSnapshot.h"
+
+GridSnapshot::GridSnapshot(const uint8_t* data, size_t size)
+	: m_valid(false), m_header(),
+		m_bits(nullptr), m_penalties(nullptr), m_heights(nullptr), m_positions(nullptr)
+{
+	if (data == nullptr || size < sizeof(SnapshotHeader)) { return; }
+
+	std::memcpy(&m_header, data, sizeof(SnapshotHeader));
+	if (m_header.magic != SNAPSHOT_MAGIC || m_header.version != SNAPSHOT_VERSION || (m_header.flags & ~SNAPSHOT_KNOWN_FLAGS)) { return; }
+	if (m_header.width < 0 || m_header.height < 0 || (int64_t)m_header.width * m_header.height > INT_MAX) { return; }
+	if (m_header.penaltyBytes != 1 && m_header.penaltyBytes != 2 && m_header.penaltyBytes != 4) { return; }
+
+	size_t bits, penalties, positions;
+	SectionSizes(m_header, CellMap::GetStride(m_header.width), bits, penalties, positions);
+	if (m_header.payloadSize != bits + penalties + positions || size - sizeof(SnapshotHeader) < m_header.payloadSize) { return; }
+
+	const uint8_t* payload = data + sizeof(SnapshotHeader);
+	if (Checksum(m_header, payload) != m_header.checksum) { return; }
+
+	// A set padding bit would walk the neighbor scans off the grid
+	if (!IsPadded(reinterpret_cast<const uint64_t*>(payload), m_header.width, m_header.height)) { return; }
+
+	m_bits = reinterpret_cast<const uint64_t*>(payload);
+	m_penalties = payload + bits;
+	if (m_header.flags & SNAPSHOT_EXPLICIT_POSITIONS)
+	{
+		m_positions = reinterpret_cast<const float*>(payload + bits + penalties);
+	}
+	else
+	{
+		// Height codes are taken over by the grid as stored, which keeps no explicit cells
+		m_heights = reinterpret_cast<const uint16_t*>(payload + bits + penalties);
+		size_t cells = (size_t)m_header.width * m_header.height;
+		if (std::find(m_heights, m_heights + cells, CELL_EXPLICIT) != m_heights + cells) { return; }
+	}
+	m_valid = true;
+}
+
+void GridSnapshot::Write(CompactGrid& grid, const CellMap& cells, Vec3 offset, int minPenalty, int maxPenalty, std::vector<uint8_t>& data)
+{
+	int width = (int)grid.GetWidth(), height = (int)grid.GetHeight();
+	int size = (int)grid.GetSize();
+
+	SnapshotHeader header = {};
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.width = width;
+	header.height = height;
+	header.minPenalty = minPenalty;
+	header.maxPenalty = maxPenalty;
+	header.offsetX = offset.x;
+	header.offsetY = offset.y;
+	header.offsetZ = offset.z;
+
+	// The snapshot shares the lattice and height codes of the grid, a grid
+	// with cells off the lattice stores every position in full instead
+	bool lattice = grid.GetExplicit() == 0;
+	std::tie(header.originX, header.originZ, header.spacingX, header.spacingZ) = grid.GetLattice();
+	std::tie(header.heightMin, header.heightScale) = grid.GetHeightRange();
+
+	int lowestPenalty = 0, highestPenalty = 0;
+	for (int index = 0; index < size; index++)
+	{
+		lowestPenalty = std::min(lowestPenalty, cells.GetPenalty(index));
+		highestPenalty = std::max(highestPenalty, cells.GetPenalty(index));
+	}
+	header.flags = lattice ? 0 : SNAPSHOT_EXPLICIT_POSITIONS;
+	header.penaltyBytes = lowestPenalty < 0 ? 4 : highestPenalty <= UINT8_MAX ? 1 : highestPenalty <= UINT16_MAX ? 2 : 4;
+
+	size_t bits, penalties, positions;
+	SectionSizes(header, CellMap::GetStride(width), bits, penalties, positions);
+	header.payloadSize = bits + penalties + positions;
+	data.assign(sizeof(SnapshotHeader) + header.payloadSize, 0);
+
+	uint8_t* payload = data.data() + sizeof(SnapshotHeader);
+	std::memcpy(payload, cells.GetBits().data(), bits);
+	for (int index = 0; index < size; index++)
+	{
+		int penalty = cells.GetPenalty(index);
+		switch (header.penaltyBytes)
+		{
+		case 1: payload[bits + index] = (uint8_t)penalty; break;
+		case 2: reinterpret_cast<uint16_t*>(payload + bits)[index] = (uint16_t)penalty; break;
+		default: reinterpret_cast<int32_t*>(payload + bits)[index] = penalty; break;
+		}
+
+		if (!lattice)
+		{
+			Vec3 position = grid.GetPosition(index);
+			float* written = reinterpret_cast<float*>(payload + bits + penalties) + (size_t)index * 3;
+			written[0] = position.x;
+			written[1] = position.y;
+			written[2] = position.z;
+		}
+		else
+		{
+			reinterpret_cast<uint16_t*>(payload + bits + penalties)[index] = grid.Get(index);
+		}
+	}
+
+	header.checksum = Checksum(header, payload);
+	std::memcpy(data.data(), &header, sizeof(SnapshotHeader));
+}
+
+const Vec3 GridSnapshot::GetPosition(int index) const
+{
+	if (m_positions != nullptr)
+	{
+		const float* position = m_positions + (size_t)index * 3;
+		return Vec3(position[0], position[1], position[2]);
+	}
+
+	int x = index % m_header.width, y = index / m_header.width;
+	return Vec3(m_header.originX + x * m_header.spacingX,
+				m_header.heightMin + m_heights[index] * m_header.heightScale,
+				m_header.originZ + y * m_header.spacingZ);
+}
+
+const uint64_t GridSnapshot::Checksum(const uint64_t* words, size_t count)
+{
+	uint64_t sum = 0, weighted = 0;
+	Accumulate(words, count, sum, weighted);
+	return sum ^ ((weighted << 1) | (weighted >> 63));
+}
+
+const uint64_t GridSnapshot::Checksum(SnapshotHeader header, const uint8_t* payload)
+{
+	// A flipped header byte changes the layout or placement of the cells
+	// as much as a flipped payload byte, so both are covered
+	header.checksum = 0;
+	uint64_t sum = 0, weighted = 0;
+	Accumulate(reinterpret_cast<const uint64_t*>(&header), sizeof(SnapshotHeader) / sizeof(uint64_t), sum, weighted);
+	Accumulate(reinterpret_cast<const uint64_t*>(payload), header.payloadSize / sizeof(uint64_t), sum, weighted);
+	return sum ^ ((weighted << 1) | (weighted >> 63));
+}
+
+void GridSnapshot::Accumulate(const uint64_t* words, size_t count, uint64_t& sum, uint64_t& weighted)
+{
+	// Fletcher style running sums, the second one weighting every word by its position
+	for (size_t i = 0; i < count; i++)
+	{
+		sum += words[i];
+		weighted += sum;
+	}
+}
+
+const bool GridSnapshot::IsPadded(const uint64_t* bits, int width, int height)
+{
+	int stride = CellMap::GetStride(width);
+	for (int row = 0; row < height + 2; row++)
+	{
+		bool inside = row > 0 && row <= height;
+		for (int word = 0; word < stride; word++)
+		{
+			// Padded bits 1 to width of the rows between the padding rows hold cells
+			int first = std::max(1, word * 64) - word * 64, last = std::min(width, word * 64 + 63) - word * 64;
+			uint64_t cells = 0;
+			if (inside && first <= last)
+			{
+				cells = (last == 63 ? ~(uint64_t)0 : ((uint64_t)1 << (last + 1)) - 1) & ~(((uint64_t)1 << first) - 1);
+			}
+			if (bits[(size_t)row * stride + word] & ~cells) { return false; }
+		}
+	}
+	return true;
+}
+
+void GridSnapshot::SectionSizes(const SnapshotHeader& header, int stride, size_t& bits, size_t& penalties, size_t& positions)
+{
+	size_t cells = (size_t)header.width * header.height;
+	bits = (size_t)stride * (header.height + 2) * sizeof(uint64_t);
+	penalties = Align(cells * header.penaltyBytes);
+	positions = Align(header.flags & SNAPSHOT_EXPLICIT_POSITIONS ? cells * 3 * sizeof(float) : cells * sizeof(uint16_t));
+}
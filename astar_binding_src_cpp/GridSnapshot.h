@@ -0,0 +1,194 @@
+#pragma once
+
+#include "pch.h"
+#include "CompactGrid.h"
+#include "CellMap.h"
+
+// Leading bytes of every snapshot ("AGRD" read as a little endian word)
+#define SNAPSHOT_MAGIC 0x44524741u
+
+// Layout version written into new snapshots, older layouts are rejected
+// (version 2 extends the checksum over the header)
+#define SNAPSHOT_VERSION 2
+
+// Snapshot flag set when the cell positions do not follow a regular lattice,
+// storing every position in full instead of quantised heights
+#define SNAPSHOT_EXPLICIT_POSITIONS 1
+
+// Every flag a snapshot of the current version may carry
+#define SNAPSHOT_KNOWN_FLAGS SNAPSHOT_EXPLICIT_POSITIONS
+
+/// <summary>
+/// Struct representing the fixed size header leading a grid snapshot.
+/// </summary>
+struct SnapshotHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t flags;
+	int32_t width, height;
+	int32_t minPenalty, maxPenalty;
+	float offsetX, offsetY, offsetZ;
+
+	// Cell (x, y) lies at (originX + x * spacingX, height, originZ + y * spacingZ),
+	// its height quantised to heightMin + q * heightScale
+	float originX, originZ;
+	float spacingX, spacingZ;
+	float heightMin, heightScale;
+
+	// Bytes per stored penalty (1, 2 or 4)
+	uint32_t penaltyBytes;
+
+	// Bytes following the header, and the checksum of the header
+	// (its checksum zeroed) followed by those bytes
+	uint64_t payloadSize;
+	uint64_t checksum;
+};
+
+/// <summary>
+/// Class representing a read-only view over a binary grid snapshot - a
+/// versioned header followed by the walkability bits in the padded layout of
+/// <see cref="CellMap"/>, the penalties as the smallest integers holding them
+/// and the cell heights quantised to 16 bits. Every section starts on an 8 byte
+/// boundary, so a snapshot read into memory in one piece or mapped from a file
+/// is used in place, the walkability bits, penalties and height codes copied
+/// verbatim into the cell map and grid.
+/// Snapshots are little endian.
+/// </summary>
+class GridSnapshot
+{
+private:
+	bool m_valid;
+	SnapshotHeader m_header;
+	const uint64_t* m_bits;
+	const uint8_t* m_penalties;
+	const uint16_t* m_heights;
+	const float* m_positions;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="GridSnapshot"/> class over
+	/// the passed bytes, validating the header, sizes, checksum and padding bits.
+	/// </summary>
+	/// <param name="data">The snapshot bytes, kept alive by the caller while the view is used</param>
+	/// <param name="size">The number of bytes</param>
+	GridSnapshot(const uint8_t* data, size_t size);
+
+	/// <summary>
+	/// Writes a snapshot of the passed grid.
+	/// </summary>
+	/// <param name="grid">The grid</param>
+	/// <param name="cells">The cell map of the grid</param>
+	/// <param name="offset">The world offset</param>
+	/// <param name="minPenalty">The minimum movement penalty</param>
+	/// <param name="maxPenalty">The maximum movement penalty</param>
+	/// <param name="data">The bytes to replace with the snapshot</param>
+	static void Write(CompactGrid& grid, const CellMap& cells, Vec3 offset, int minPenalty, int maxPenalty, std::vector<uint8_t>& data);
+
+	/// <summary>
+	/// Determines whether the bytes hold a complete snapshot of the current version.
+	/// </summary>
+	/// <returns>Whether the snapshot may be loaded</returns>
+	inline const bool IsValid() const { return m_valid; }
+
+	/// <summary>
+	/// Retrieves the header of the snapshot.
+	/// </summary>
+	/// <returns>The header</returns>
+	inline const SnapshotHeader& GetHeader() const { return m_header; }
+
+	/// <summary>
+	/// Retrieves the walkability bits, laid out like the bits of <see cref="CellMap"/>.
+	/// </summary>
+	/// <returns>The padded rows of walkability bits</returns>
+	inline const uint64_t* GetBits() const { return m_bits; }
+
+	/// <summary>
+	/// Retrieves the movement penalties, stored as integers of the header's penalty bytes.
+	/// </summary>
+	/// <returns>The penalties (x + y * width)</returns>
+	inline const uint8_t* GetPenalties() const { return m_penalties; }
+
+	/// <summary>
+	/// Retrieves the quantised heights of a snapshot on a regular lattice.
+	/// </summary>
+	/// <returns>The height codes (x + y * width), null if every position is stored in full</returns>
+	inline const uint16_t* GetHeights() const { return m_heights; }
+
+	/// <summary>
+	/// Retrieves the movement penalty of the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The movement penalty</returns>
+	inline const int GetPenalty(int index) const
+	{
+		switch (m_header.penaltyBytes)
+		{
+		case 1: return m_penalties[index];
+		case 2: return reinterpret_cast<const uint16_t*>(m_penalties)[index];
+		default: return reinterpret_cast<const int32_t*>(m_penalties)[index];
+		}
+	}
+
+	/// <summary>
+	/// Retrieves the world position of the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The world position</returns>
+	const Vec3 GetPosition(int index) const;
+
+	/// <summary>
+	/// Calculates the checksum of the passed words.
+	/// </summary>
+	/// <param name="words">The words</param>
+	/// <param name="count">The number of words</param>
+	/// <returns>The checksum</returns>
+	static const uint64_t Checksum(const uint64_t* words, size_t count);
+
+private:
+
+	/// <summary>
+	/// Calculates the checksum of the passed header, its checksum zeroed, followed by the passed payload.
+	/// </summary>
+	/// <param name="header">The header describing the payload</param>
+	/// <param name="payload">The bytes following the header</param>
+	/// <returns>The checksum</returns>
+	static const uint64_t Checksum(SnapshotHeader header, const uint8_t* payload);
+
+	/// <summary>
+	/// Adds the passed words to the running sums of a checksum.
+	/// </summary>
+	/// <param name="words">The words</param>
+	/// <param name="count">The number of words</param>
+	/// <param name="sum">The running sum of the words</param>
+	/// <param name="weighted">The running sum of the running sums</param>
+	static void Accumulate(const uint64_t* words, size_t count, uint64_t& sum, uint64_t& weighted);
+
+	/// <summary>
+	/// Determines whether every padding bit of the passed walkability bits is clear,
+	/// the padding rows and columns as well as the bits past the width.
+	/// </summary>
+	/// <param name="bits">The padded rows of walkability bits</param>
+	/// <param name="width">The grid width</param>
+	/// <param name="height">The grid height</param>
+	/// <returns>Whether only cells within the grid are walkable</returns>
+	static const bool IsPadded(const uint64_t* bits, int width, int height);
+
+	/// <summary>
+	/// Rounds the passed byte count up to the next section boundary.
+	/// </summary>
+	/// <param name="bytes">The byte count</param>
+	/// <returns>The padded byte count</returns>
+	inline static const size_t Align(size_t bytes) { return (bytes + 7) & ~(size_t)7; }
+
+	/// <summary>
+	/// Calculates the sizes of the sections following the header.
+	/// </summary>
+	/// <param name="header">The header describing the snapshot</param>
+	/// <param name="stride">The words per padded row of walkability bits</param>
+	/// <param name="bits">The bytes of the walkability bits</param>
+	/// <param name="penalties">The bytes of the penalties</param>
+	/// <param name="positions">The bytes of the heights or the full positions</param>
+	static void SectionSizes(const SnapshotHeader& header, int stride, size_t& bits, size_t& penalties, size_t& positions);
+};
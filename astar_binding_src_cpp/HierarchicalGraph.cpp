@@ -0,0 +1,537 @@
+#include "pch.h"
+
+#include "HierarchicalGraph.h"
+#include "AStar.h"
+
+/// <summary>
+/// Border runs at least this long receive an entrance at both ends and
+/// every <see cref="ENTRANCE_SPACING"/> cells in between, instead of a
+/// single one in the middle. Runs are split wherever the penalty of
+/// crossing the border changes, so a cheap crossing beside an expensive
+/// one receives its own entrance.
+/// </summary>
+#define WIDE_ENTRANCE_LENGTH 6
+#define ENTRANCE_SPACING 4
+
+HierarchicalGraph::HierarchicalGraph(int clusterSize)
+	: m_clusterSize(clusterSize), m_clustersX(0), m_clustersY(0), m_built(false)
+{
+}
+
+void HierarchicalGraph::SetClusterSize(int clusterSize)
+{
+	m_clusterSize = std::max(clusterSize, 2);
+	m_built = false;
+}
+
+void HierarchicalGraph::Update(AStar& astar, int index)
+{
+	if (!m_built) { return; }
+
+	m_dirty[ClusterOf(astar, index)] = 1;
+}
+
+const bool HierarchicalGraph::FindPath(AStar& astar, int start, int target, SearchContext& context, SearchBudget& budget, std::vector<int>& cells)
+{
+	if (!m_built) { return false; }
+
+	SearchArena& clusterArena = context.clusterArena;
+	int startCluster = ClusterOf(astar, start);
+	int targetCluster = ClusterOf(astar, target);
+
+	// Entrances are sparse along a border, which detours most on short paths,
+	// so targets within the clusters around the start are left to the regular
+	// search, cheap at that range
+	if (abs(startCluster % m_clustersX - targetCluster % m_clustersX) <= 1 &&
+		abs(startCluster / m_clustersX - targetCluster / m_clustersX) <= 1)
+	{
+		return false;
+	}
+
+	// Connect the start to the entrances of its cluster (and the target when they share it)
+	std::vector<std::pair<int, int>> startEdges;
+	SearchCluster(astar, startCluster, start, false, clusterArena, context.clusterHeap, -1, &budget);
+	for (int node : m_nodes[startCluster])
+	{
+		if (clusterArena.IsClosed(node))
+		{
+			startEdges.push_back(std::make_pair(node, clusterArena[node].gCost));
+		}
+	}
+	if (startCluster == targetCluster && clusterArena.IsClosed(target))
+	{
+		startEdges.push_back(std::make_pair(target, clusterArena[target].gCost));
+	}
+
+	// Connect the entrances of the target cluster to the target, searched within
+	// the abstract search state so the start cluster search stays readable
+	CompactGrid& grid = astar.GetGrid();
+	SearchArena& arena = context.arena;
+	IndexedHeap& open = context.heap;
+	std::vector<std::pair<int, int>> targetEdges;
+	SearchCluster(astar, targetCluster, target, true, arena, open, -1, &budget);
+	for (int node : m_nodes[targetCluster])
+	{
+		if (arena.IsClosed(node))
+		{
+			targetEdges.push_back(std::make_pair(node, arena[node].gCost));
+		}
+	}
+
+	// A* over the abstract graph, abstract nodes are identified by their cell index
+	arena.Begin(grid.GetSize());
+	open.Reset(grid.GetSize());
+
+	int startH = astar.Heuristic(start, target);
+	arena.Open(start, 0, startH, -1);
+	open.Add(start, startH, startH);
+
+	bool success = false;
+	int closest = start;
+	std::vector<std::pair<int, int>> edges;
+	while (open.Size() > 0)
+	{
+		if (!budget.Expand(open.Size())) { break; }
+
+		int current = open.RemoveFirst();
+		arena.Close(current);
+		if (current == target)
+		{
+			success = true;
+			break;
+		}
+		if (arena[current].hCost < arena[closest].hCost)
+		{
+			closest = current;
+		}
+
+		edges.clear();
+		if (current == start)
+		{
+			edges.insert(edges.end(), startEdges.begin(), startEdges.end());
+		}
+
+		int cluster = ClusterOf(astar, current);
+		const std::vector<int>& nodes = m_nodes[cluster];
+		int count = nodes.size();
+		int node = std::find(nodes.begin(), nodes.end(), current) - nodes.begin();
+		if (node < count)
+		{
+			for (int other = 0; other < count; other++)
+			{
+				int cost = m_costs[cluster][(node * count) + other];
+				if (other != node && cost >= 0)
+				{
+					edges.push_back(std::make_pair(nodes[other], cost));
+				}
+			}
+			for (int partner : m_links[cluster][node])
+			{
+				edges.push_back(std::make_pair(partner, astar.MoveCost(current, partner)));
+			}
+		}
+		if (cluster == targetCluster)
+		{
+			for (const auto& edge : targetEdges)
+			{
+				if (edge.first == current)
+				{
+					edges.push_back(std::make_pair(target, edge.second));
+				}
+			}
+		}
+
+		int currentG = arena[current].gCost;
+		for (const auto& edge : edges)
+		{
+			int neighbor = edge.first;
+			if (arena.IsClosed(neighbor)) { continue; }
+
+			int newMoveCost = currentG + edge.second;
+			if (arena.IsOpen(neighbor))
+			{
+				SearchNode& state = arena[neighbor];
+				if (newMoveCost < state.gCost)
+				{
+					state.gCost = newMoveCost;
+					state.parent = current;
+					open.DecreaseKey(neighbor, newMoveCost + state.hCost, state.hCost);
+				}
+			}
+			else
+			{
+				int hCost = astar.Heuristic(neighbor, target);
+				arena.Open(neighbor, newMoveCost, hCost, current);
+				open.Add(neighbor, newMoveCost + hCost, hCost);
+			}
+		}
+	}
+
+	// Without a budget running out the regular search takes over
+	if (!success && !budget.IsExhausted()) { return false; }
+
+	cells.clear();
+	if (!success && closest == start)
+	{
+		// Out of budget before leaving the start cluster, settle for its cell closest to the target
+		Approach(astar, startCluster, start, target, clusterArena, cells);
+		return true;
+	}
+
+	// Refine the abstract edges from the start towards the target, or the
+	// abstract node closest to it, until the budget runs out
+	std::vector<int> chain;
+	for (int current = success ? target : closest; current != start; current = arena[current].parent)
+	{
+		chain.push_back(current);
+	}
+	chain.push_back(start);
+	std::reverse(chain.begin(), chain.end());
+
+	std::vector<int> refined, segment;
+	for (size_t i = 1; i < chain.size(); i++)
+	{
+		segment.clear();
+		if (ClusterOf(astar, chain[i - 1]) != ClusterOf(astar, chain[i]))
+		{
+			segment.push_back(chain[i]);
+		}
+		else if (i == 1)
+		{
+			// The start cluster search already holds the way to its entrances
+			for (int current = chain[1]; current != start; current = clusterArena[current].parent)
+			{
+				segment.push_back(current);
+			}
+		}
+		else if (!Refine(astar, chain[i - 1], chain[i], context, budget, segment))
+		{
+			// Settle for the refined cell closest to the target
+			segment.clear();
+			Approach(astar, ClusterOf(astar, chain[i - 1]), chain[i - 1], target, clusterArena, segment);
+			refined.insert(refined.end(), segment.rbegin(), segment.rend());
+			break;
+		}
+		refined.insert(refined.end(), segment.rbegin(), segment.rend());
+	}
+
+	cells.assign(refined.rbegin(), refined.rend());
+	return true;
+}
+
+void HierarchicalGraph::Prepare(AStar& astar)
+{
+	CompactGrid& grid = astar.GetGrid();
+	if (!m_built)
+	{
+		m_clustersX = (grid.GetWidth() + m_clusterSize - 1) / m_clusterSize;
+		m_clustersY = (grid.GetHeight() + m_clusterSize - 1) / m_clusterSize;
+
+		int clusters = m_clustersX * m_clustersY;
+		m_dirty.assign(clusters, 0);
+		m_eastBorders.assign(clusters, std::vector<std::pair<int, int>>());
+		m_southBorders.assign(clusters, std::vector<std::pair<int, int>>());
+		m_corners.assign(clusters, std::vector<std::pair<int, int>>());
+		m_nodes.assign(clusters, std::vector<int>());
+		m_links.assign(clusters, std::vector<std::vector<int>>());
+		m_costs.assign(clusters, std::vector<int>());
+
+		for (int cluster = 0; cluster < clusters; cluster++)
+		{
+			BuildBorders(astar, cluster);
+		}
+		for (int cluster = 0; cluster < clusters; cluster++)
+		{
+			BuildCluster(astar, cluster);
+		}
+		m_built = true;
+		return;
+	}
+
+	// An edit changes the borders and corners of its cluster, shared with the eight surrounding clusters
+	std::set<int> affected;
+	for (int cluster = 0; cluster < (int)m_dirty.size(); cluster++)
+	{
+		if (!m_dirty[cluster]) { continue; }
+
+		int cx = cluster % m_clustersX, cy = cluster / m_clustersX;
+		for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, m_clustersY - 1); y++)
+		{
+			for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, m_clustersX - 1); x++)
+			{
+				affected.insert(x + y * m_clustersX);
+				if (x <= cx && y <= cy) { BuildBorders(astar, x + y * m_clustersX); }
+			}
+		}
+		m_dirty[cluster] = 0;
+	}
+	for (int cluster : affected)
+	{
+		BuildCluster(astar, cluster);
+	}
+}
+
+const int HierarchicalGraph::ClusterOf(AStar& astar, int index)
+{
+	CompactGrid& grid = astar.GetGrid();
+	return (grid.GetRow(index) / m_clusterSize) + ((grid.GetCol(index) / m_clusterSize) * m_clustersX);
+}
+
+void HierarchicalGraph::BuildBorders(AStar& astar, int cluster)
+{
+	CompactGrid& grid = astar.GetGrid();
+	int cx = cluster % m_clustersX, cy = cluster / m_clustersX;
+	int x0 = cx * m_clusterSize, y0 = cy * m_clusterSize;
+	int x1 = std::min(x0 + m_clusterSize, (int)grid.GetWidth()) - 1;
+	int y1 = std::min(y0 + m_clusterSize, (int)grid.GetHeight()) - 1;
+
+	std::vector<std::pair<int, int>> run;
+	const CellMap& cells = astar.GetCells();
+	auto crossing = [&](const std::pair<int, int>& transition) { return cells.GetPenalty(transition.first) + cells.GetPenalty(transition.second); };
+
+	// Cutting the corner between two blocked cells crosses a border where no
+	// straight transition does, and a diagonal is the only way through a cluster corner
+	auto addDiagonal = [&](int inside, int outside, std::vector<std::pair<int, int>>& transitions)
+	{
+		if (astar.IsWalkable(inside) && astar.IsWalkable(outside))
+		{
+			transitions.push_back(std::make_pair(inside, outside));
+		}
+	};
+
+	m_eastBorders[cluster].clear();
+	if (cx + 1 < m_clustersX)
+	{
+		for (int y = y0; y <= y1; y++)
+		{
+			int inside = grid.GetIndex(x1, y), outside = grid.GetIndex(x1 + 1, y);
+			bool walkable = astar.IsWalkable(inside) && astar.IsWalkable(outside);
+			if (walkable && (run.empty() || crossing(run.back()) == crossing(std::make_pair(inside, outside))))
+			{
+				run.push_back(std::make_pair(inside, outside));
+				continue;
+			}
+			AddTransitions(run, m_eastBorders[cluster]);
+			run.clear();
+			if (walkable)
+			{
+				run.push_back(std::make_pair(inside, outside));
+			}
+			else if (y < y1 && !(astar.IsWalkable(grid.GetIndex(x1, y + 1)) && astar.IsWalkable(grid.GetIndex(x1 + 1, y + 1))))
+			{
+				addDiagonal(inside, grid.GetIndex(x1 + 1, y + 1), m_eastBorders[cluster]);
+				addDiagonal(grid.GetIndex(x1, y + 1), outside, m_eastBorders[cluster]);
+			}
+		}
+		AddTransitions(run, m_eastBorders[cluster]);
+		run.clear();
+	}
+
+	m_southBorders[cluster].clear();
+	if (cy + 1 < m_clustersY)
+	{
+		for (int x = x0; x <= x1; x++)
+		{
+			int inside = grid.GetIndex(x, y1), outside = grid.GetIndex(x, y1 + 1);
+			bool walkable = astar.IsWalkable(inside) && astar.IsWalkable(outside);
+			if (walkable && (run.empty() || crossing(run.back()) == crossing(std::make_pair(inside, outside))))
+			{
+				run.push_back(std::make_pair(inside, outside));
+				continue;
+			}
+			AddTransitions(run, m_southBorders[cluster]);
+			run.clear();
+			if (walkable)
+			{
+				run.push_back(std::make_pair(inside, outside));
+			}
+			else if (x < x1 && !(astar.IsWalkable(grid.GetIndex(x + 1, y1)) && astar.IsWalkable(grid.GetIndex(x + 1, y1 + 1))))
+			{
+				addDiagonal(inside, grid.GetIndex(x + 1, y1 + 1), m_southBorders[cluster]);
+				addDiagonal(grid.GetIndex(x + 1, y1), outside, m_southBorders[cluster]);
+			}
+		}
+		AddTransitions(run, m_southBorders[cluster]);
+	}
+
+	m_corners[cluster].clear();
+	if (cx + 1 < m_clustersX && cy + 1 < m_clustersY)
+	{
+		addDiagonal(grid.GetIndex(x1, y1), grid.GetIndex(x1 + 1, y1 + 1), m_corners[cluster]);
+		addDiagonal(grid.GetIndex(x1 + 1, y1), grid.GetIndex(x1, y1 + 1), m_corners[cluster]);
+	}
+}
+
+void HierarchicalGraph::AddTransitions(const std::vector<std::pair<int, int>>& run, std::vector<std::pair<int, int>>& transitions)
+{
+	if (run.empty()) { return; }
+
+	if (run.size() < WIDE_ENTRANCE_LENGTH)
+	{
+		transitions.push_back(run[run.size() / 2]);
+	}
+	else
+	{
+		for (size_t i = 0; i + 1 < run.size(); i += ENTRANCE_SPACING)
+		{
+			transitions.push_back(run[i]);
+		}
+		transitions.push_back(run.back());
+	}
+}
+
+void HierarchicalGraph::BuildCluster(AStar& astar, int cluster)
+{
+	int cx = cluster % m_clustersX, cy = cluster / m_clustersX;
+	std::vector<int>& nodes = m_nodes[cluster];
+	std::vector<std::vector<int>>& links = m_links[cluster];
+	nodes.clear();
+	links.clear();
+
+	auto addLink = [&](int inside, int outside)
+	{
+		int node = std::find(nodes.begin(), nodes.end(), inside) - nodes.begin();
+		if (node == (int)nodes.size())
+		{
+			nodes.push_back(inside);
+			links.push_back(std::vector<int>());
+		}
+		links[node].push_back(outside);
+	};
+
+	for (const auto& transition : m_eastBorders[cluster]) { addLink(transition.first, transition.second); }
+	for (const auto& transition : m_southBorders[cluster]) { addLink(transition.first, transition.second); }
+	if (cx > 0)
+	{
+		for (const auto& transition : m_eastBorders[cluster - 1]) { addLink(transition.second, transition.first); }
+	}
+	if (cy > 0)
+	{
+		for (const auto& transition : m_southBorders[cluster - m_clustersX]) { addLink(transition.second, transition.first); }
+	}
+
+	// Either diagonal across a corner links two of the four clusters meeting there
+	for (int y = std::max(cy - 1, 0); y <= cy; y++)
+	{
+		for (int x = std::max(cx - 1, 0); x <= cx; x++)
+		{
+			for (const auto& transition : m_corners[x + y * m_clustersX])
+			{
+				if (ClusterOf(astar, transition.first) == cluster) { addLink(transition.first, transition.second); }
+				if (ClusterOf(astar, transition.second) == cluster) { addLink(transition.second, transition.first); }
+			}
+		}
+	}
+
+	int count = nodes.size();
+	std::vector<int>& costs = m_costs[cluster];
+	costs.assign(count * count, -1);
+	for (int from = 0; from < count; from++)
+	{
+		SearchCluster(astar, cluster, nodes[from], false, m_clusterArena, m_clusterOpen);
+		for (int to = 0; to < count; to++)
+		{
+			if (m_clusterArena.IsClosed(nodes[to]))
+			{
+				costs[(from * count) + to] = m_clusterArena[nodes[to]].gCost;
+			}
+		}
+	}
+}
+
+void HierarchicalGraph::SearchCluster(AStar& astar, int cluster, int source, bool reverse, SearchArena& arena, IndexedHeap& open, int goal, SearchBudget* budget)
+{
+	CompactGrid& grid = astar.GetGrid();
+	int cx = cluster % m_clustersX, cy = cluster / m_clustersX;
+	int x0 = cx * m_clusterSize, y0 = cy * m_clusterSize;
+	int x1 = std::min(x0 + m_clusterSize, (int)grid.GetWidth()) - 1;
+	int y1 = std::min(y0 + m_clusterSize, (int)grid.GetHeight()) - 1;
+
+	arena.Begin(grid.GetSize());
+	open.Reset(grid.GetSize());
+
+	arena.Open(source, 0, 0, -1);
+	open.Add(source, 0, 0);
+
+	int neighbors[8];
+	while (open.Size() > 0)
+	{
+		if (budget != nullptr && !budget->Expand(open.Size())) { break; }
+
+		int current = open.RemoveFirst();
+		arena.Close(current);
+		if (current == goal) { break; }
+
+		int currentG = arena[current].gCost;
+		int count = astar.GetCells().GetWalkableNeighbors(current, neighbors);
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+			int row = grid.GetRow(neighbor), col = grid.GetCol(neighbor);
+			if (row < x0 || row > x1 || col < y0 || col > y1) { continue; }
+			if (arena.IsClosed(neighbor)) { continue; }
+
+			int newMoveCost = currentG + (reverse ? astar.MoveCost(neighbor, current) : astar.MoveCost(current, neighbor));
+			if (arena.IsOpen(neighbor))
+			{
+				SearchNode& state = arena[neighbor];
+				if (newMoveCost < state.gCost)
+				{
+					state.gCost = newMoveCost;
+					state.parent = current;
+					open.DecreaseKey(neighbor, newMoveCost + state.hCost, state.hCost);
+				}
+			}
+			else
+			{
+				int hCost = goal >= 0 ? astar.Heuristic(neighbor, goal) : 0;
+				arena.Open(neighbor, newMoveCost, hCost, current);
+				open.Add(neighbor, newMoveCost + hCost, hCost);
+			}
+		}
+	}
+}
+
+void HierarchicalGraph::Approach(AStar& astar, int cluster, int from, int target, SearchArena& arena, std::vector<int>& cells)
+{
+	CompactGrid& grid = astar.GetGrid();
+	int cx = cluster % m_clustersX, cy = cluster / m_clustersX;
+	int x0 = cx * m_clusterSize, y0 = cy * m_clusterSize;
+	int x1 = std::min(x0 + m_clusterSize, (int)grid.GetWidth()) - 1;
+	int y1 = std::min(y0 + m_clusterSize, (int)grid.GetHeight()) - 1;
+
+	int nearest = from, nearestH = astar.Heuristic(from, target);
+	for (int row = x0; row <= x1; row++)
+	{
+		for (int col = y0; col <= y1; col++)
+		{
+			int index = grid.GetIndex(row, col);
+			if (!arena.IsClosed(index)) { continue; }
+
+			int hCost = astar.Heuristic(index, target);
+			if (hCost < nearestH)
+			{
+				nearest = index;
+				nearestH = hCost;
+			}
+		}
+	}
+	for (int current = nearest; current != from; current = arena[current].parent)
+	{
+		cells.push_back(current);
+	}
+}
+
+const bool HierarchicalGraph::Refine(AStar& astar, int from, int to, SearchContext& context, SearchBudget& budget, std::vector<int>& cells)
+{
+	SearchCluster(astar, ClusterOf(astar, from), from, false, context.clusterArena, context.clusterHeap, to, &budget);
+	if (!context.clusterArena.IsClosed(to)) { return false; }
+
+	int current = to;
+	while (current != from)
+	{
+		cells.push_back(current);
+		current = context.clusterArena[current].parent;
+	}
+	return true;
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "pch.h"
+#include "SearchArena.h"
+#include "IndexedHeap.h"
+#include "SearchContext.h"
+#include "SearchBudget.h"
+
+#define DEFAULT_CLUSTER_SIZE 16
+
+class AStar;
+
+/// <summary>
+/// Class representing a hierarchical (HPA*) abstraction over the search
+/// grid. The grid is partitioned into square clusters, entrances are
+/// placed along the walkable runs of every cluster border, and the costs
+/// between the entrances of a cluster are computed once. Queries search the
+/// small abstract graph and refine each abstract edge with a search confined
+/// to a single cluster. Edited clusters are rebuilt by <see cref="Prepare"/>,
+/// after which queries only read the abstraction.
+/// </summary>
+class HierarchicalGraph
+{
+private:
+	int m_clusterSize;
+	int m_clustersX, m_clustersY;
+	bool m_built;
+	std::vector<unsigned char> m_dirty;
+
+	// Transitions (cell pairs) across the east and south border and the
+	// south-east corner of every cluster
+	std::vector<std::vector<std::pair<int, int>>> m_eastBorders, m_southBorders, m_corners;
+
+	// Entrance cells, the partner cells across the border and the entrance
+	// to entrance cost matrix of every cluster
+	std::vector<std::vector<int>> m_nodes;
+	std::vector<std::vector<std::vector<int>>> m_links;
+	std::vector<std::vector<int>> m_costs;
+
+	// Scratch state utilized while building cluster costs
+	SearchArena m_clusterArena;
+	IndexedHeap m_clusterOpen;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="HierarchicalGraph"/> class.
+	/// </summary>
+	/// <param name="clusterSize">The width and height of a cluster in cells</param>
+	HierarchicalGraph(int clusterSize = DEFAULT_CLUSTER_SIZE);
+
+	/// <summary>
+	/// Marks the whole abstraction as requiring a rebuild.
+	/// </summary>
+	inline void Invalidate() { m_built = false; }
+
+	/// <summary>
+	/// Sets the cluster size, invalidating the abstraction.
+	/// </summary>
+	/// <param name="clusterSize">The width and height of a cluster in cells</param>
+	void SetClusterSize(int clusterSize);
+
+	/// <summary>
+	/// Marks the cluster containing the passed edited cell for a rebuild.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="index">The edited cell index</param>
+	void Update(AStar& astar, int index);
+
+	/// <summary>
+	/// Builds or rebuilds the invalidated parts of the abstraction.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	void Prepare(AStar& astar);
+
+	/// <summary>
+	/// Finds a path from the start cell to the target cell through the
+	/// abstract graph, refined to grid cells. The abstraction must have been
+	/// prepared, the query only writes into the passed context. Every cell and
+	/// abstract node expanded counts against the passed budget - once it runs
+	/// out the path ends at the last refined node on the way to the abstract
+	/// node closest to the target.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="context">The search context to utilize</param>
+	/// <param name="budget">The budgets of the search</param>
+	/// <param name="cells">The resulting cells, ordered from the target back to
+	///						(and excluding) the start</param>
+	/// <returns>Whether a path was found or the budget ran out, otherwise the
+	///			 regular search is left to find the path</returns>
+	const bool FindPath(AStar& astar, int start, int target, SearchContext& context, SearchBudget& budget, std::vector<int>& cells);
+
+private:
+
+	/// <summary>
+	/// Retrieves the cluster containing the passed cell.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="index">The cell index</param>
+	/// <returns>The cluster index</returns>
+	const int ClusterOf(AStar& astar, int index);
+
+	/// <summary>
+	/// Rebuilds the transitions across the east and south border and the
+	/// south-east corner of the passed cluster.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="cluster">The cluster index</param>
+	void BuildBorders(AStar& astar, int cluster);
+
+	/// <summary>
+	/// Collects the transitions of a walkable run of border cell pairs.
+	/// </summary>
+	/// <param name="run">The walkable run of cell pairs</param>
+	/// <param name="transitions">The transitions to append to</param>
+	void AddTransitions(const std::vector<std::pair<int, int>>& run, std::vector<std::pair<int, int>>& transitions);
+
+	/// <summary>
+	/// Rebuilds the entrances and the entrance to entrance costs of the passed cluster.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="cluster">The cluster index</param>
+	void BuildCluster(AStar& astar, int cluster);
+
+	/// <summary>
+	/// Runs Dijkstra from the passed cell confined to the passed cluster,
+	/// recording costs and parents within the passed arena. A reverse search
+	/// computes the costs towards the source, its parents leading to the source.
+	/// Given a goal the search runs A* towards it instead, stopping once it is reached.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="cluster">The cluster index</param>
+	/// <param name="source">The source cell index</param>
+	/// <param name="reverse">Whether to search towards the source</param>
+	/// <param name="arena">The search arena to record into</param>
+	/// <param name="open">The open list to utilize</param>
+	/// <param name="goal">The cell index to search a path to (-1 - every cell of the cluster)</param>
+	/// <param name="budget">The budgets of the query counting the expansions (null - unlimited)</param>
+	void SearchCluster(AStar& astar, int cluster, int source, bool reverse, SearchArena& arena, IndexedHeap& open, int goal = -1, SearchBudget* budget = nullptr);
+
+	/// <summary>
+	/// Appends the cells of the path from the passed cell to the closed cell of the
+	/// passed cluster closest to the target, ordered from that cell back to (and
+	/// excluding) the origin. Nothing is appended if no closed cell is closer.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="cluster">The cluster index</param>
+	/// <param name="from">The source cell index of the search recorded in the arena</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="arena">The arena holding the confined search from the source</param>
+	/// <param name="cells">The cells to append to</param>
+	void Approach(AStar& astar, int cluster, int from, int target, SearchArena& arena, std::vector<int>& cells);
+
+	/// <summary>
+	/// Appends the cells of the confined path from the passed cell to the
+	/// passed cell, ordered from the destination back to (and excluding) the origin.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="from">The origin cell index</param>
+	/// <param name="to">The destination cell index</param>
+	/// <param name="context">The search context to utilize</param>
+	/// <param name="budget">The budgets of the query</param>
+	/// <param name="cells">The cells to append to</param>
+	/// <returns>Whether the destination was reached before the budget ran out</returns>
+	const bool Refine(AStar& astar, int from, int to, SearchContext& context, SearchBudget& budget, std::vector<int>& cells);
+};
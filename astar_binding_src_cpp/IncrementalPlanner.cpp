@@ -0,0 +1,197 @@
+#include "pch.h"
+
+#include "IncrementalPlanner.h"
+#include "AStar.h"
+
+IncrementalPlanner::IncrementalPlanner()
+	: m_astar(nullptr), m_version(0), m_target(-1), m_last(-1), m_keyModifier(0), m_minPenalty(0), m_expansions(0)
+{
+}
+
+void IncrementalPlanner::Reset()
+{
+	m_astar = nullptr;
+	m_target = -1;
+}
+
+const bool IncrementalPlanner::Plan(AStar& astar, int start, int target, std::vector<int>& cells)
+{
+	cells.clear();
+	m_expansions = 0;
+	if (!astar.IsWalkable(start) || !astar.IsWalkable(target) || !astar.IsReachable(start, target)) { return false; }
+
+	m_edits.clear();
+	if (m_astar != &astar || target != m_target || astar.GetCells().GetMinPenalty() < m_minPenalty ||
+		!astar.GetEditsSince(m_version, m_edits))
+	{
+		Initialize(astar, target);
+		m_last = start;
+	}
+	else
+	{
+		// Queued keys stay valid lower bounds once offset by the distance moved
+		if (start != m_last)
+		{
+			m_keyModifier += Heuristic(astar, m_last, start);
+			m_last = start;
+		}
+
+		// An edited cell changes its own steps and the steps onto it
+		int neighbors[8];
+		for (int edit : m_edits)
+		{
+			UpdateCell(astar, edit, start);
+			int count = astar.GetCells().GetWalkableNeighbors(edit, neighbors);
+			for (int i = 0; i < count; i++)
+			{
+				UpdateCell(astar, neighbors[i], start);
+			}
+		}
+	}
+	m_version = astar.GetVersion();
+
+	ComputeShortestPath(astar, start);
+	if (m_costs[start] == INT_MAX) { return false; }
+
+	// Follow the cheapest step towards the target
+	CompactGrid& grid = astar.GetGrid();
+	int neighbors[8];
+	int current = start;
+	while (current != target && cells.size() < grid.GetSize())
+	{
+		int best = -1, bestCost = INT_MAX;
+		int count = astar.GetCells().GetWalkableNeighbors(current, neighbors);
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+			int step = StepCost(astar, current, neighbor);
+			if (step == INT_MAX || m_costs[neighbor] == INT_MAX) { continue; }
+
+			if (step + m_costs[neighbor] < bestCost)
+			{
+				bestCost = step + m_costs[neighbor];
+				best = neighbor;
+			}
+		}
+		if (best < 0) { break; }
+
+		cells.push_back(best);
+		current = best;
+	}
+
+	if (current != target)
+	{
+		cells.clear();
+		return false;
+	}
+	std::reverse(cells.begin(), cells.end());
+	return true;
+}
+
+void IncrementalPlanner::Initialize(AStar& astar, int target)
+{
+	int size = astar.GetGrid().GetSize();
+	m_astar = &astar;
+	m_target = target;
+	m_keyModifier = 0;
+	m_minPenalty = astar.GetCells().GetMinPenalty();
+	m_costs.assign(size, INT_MAX);
+	m_lookahead.assign(size, INT_MAX);
+	m_open.Reset(size);
+
+	m_lookahead[target] = 0;
+	m_open.Add(target, 0, 0);
+}
+
+void IncrementalPlanner::ComputeShortestPath(AStar& astar, int start)
+{
+	int neighbors[8];
+	while (m_open.Size() > 0)
+	{
+		OpenNode top = m_open.Peek();
+		if (!(top < Key(astar, start, start)) && m_lookahead[start] == m_costs[start]) { break; }
+
+		int current = top.index;
+		OpenNode key = Key(astar, current, start);
+		if (top < key)
+		{
+			// Queued before the agent moved, requeue under the current key
+			m_open.UpdateKey(current, key.fCost, key.hCost);
+			continue;
+		}
+
+		m_open.RemoveFirst();
+		m_expansions++;
+
+		int count = astar.GetCells().GetWalkableNeighbors(current, neighbors);
+		if (m_costs[current] > m_lookahead[current])
+		{
+			m_costs[current] = m_lookahead[current];
+		}
+		else
+		{
+			m_costs[current] = INT_MAX;
+			UpdateCell(astar, current, start);
+		}
+		for (int i = 0; i < count; i++)
+		{
+			UpdateCell(astar, neighbors[i], start);
+		}
+	}
+}
+
+void IncrementalPlanner::UpdateCell(AStar& astar, int index, int start)
+{
+	if (index != m_target)
+	{
+		int lookahead = INT_MAX;
+		int neighbors[8];
+		int count = astar.GetCells().GetWalkableNeighbors(index, neighbors);
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+			int step = StepCost(astar, index, neighbor);
+			if (step == INT_MAX || m_costs[neighbor] == INT_MAX) { continue; }
+
+			lookahead = std::min(lookahead, step + m_costs[neighbor]);
+		}
+		m_lookahead[index] = lookahead;
+	}
+
+	bool queued = m_open.Contains(index);
+	if (m_costs[index] == m_lookahead[index])
+	{
+		if (queued) { m_open.Remove(index); }
+		return;
+	}
+
+	OpenNode key = Key(astar, index, start);
+	if (queued)
+	{
+		m_open.UpdateKey(index, key.fCost, key.hCost);
+	}
+	else
+	{
+		m_open.Add(index, key.fCost, key.hCost);
+	}
+}
+
+const OpenNode IncrementalPlanner::Key(AStar& astar, int index, int start)
+{
+	int cost = std::min(m_costs[index], m_lookahead[index]);
+	if (cost == INT_MAX) { return OpenNode{ index, INT_MAX, INT_MAX }; }
+
+	return OpenNode{ index, cost + Heuristic(astar, start, index) + m_keyModifier, cost };
+}
+
+const int IncrementalPlanner::Heuristic(AStar& astar, int from, int to)
+{
+	return astar.GridHeuristic(from, to, m_minPenalty);
+}
+
+const int IncrementalPlanner::StepCost(AStar& astar, int from, int to)
+{
+	if (!astar.IsWalkable(from) || !astar.IsWalkable(to)) { return INT_MAX; }
+
+	return astar.MoveCost(from, to);
+}
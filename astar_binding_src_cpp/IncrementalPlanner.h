@@ -0,0 +1,114 @@
+#pragma once
+
+#include "pch.h"
+#include "IndexedHeap.h"
+
+class AStar;
+
+/// <summary>
+/// Class representing a persistent incremental planner (D* Lite) for a
+/// single agent. The search runs backwards from the target, so the costs
+/// towards the target survive the agent moving. Cells edited since the
+/// last plan are read from the grid's edit journal, and only the part of
+/// the search tree whose costs they change is repaired. A new target, a
+/// different grid or an edit the journal no longer holds starts over.
+/// Queued keys must stay lower bounds across plans, so the planner keys
+/// cells by the grid heuristic alone - the landmark tables are rebuilt
+/// after every edit - and starts over once the minimum penalty drops.
+/// </summary>
+class IncrementalPlanner
+{
+private:
+	const AStar* m_astar;
+	unsigned int m_version;
+	int m_target, m_last;
+	int m_keyModifier;
+	int m_minPenalty;
+	size_t m_expansions;
+
+	// Cost to the target (g) and one step lookahead cost (rhs) of every cell
+	std::vector<int> m_costs, m_lookahead;
+	IndexedHeap m_open;
+	std::vector<int> m_edits;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="IncrementalPlanner"/> class.
+	/// </summary>
+	IncrementalPlanner();
+
+	/// <summary>
+	/// Plans the path from the passed start cell to the passed target cell,
+	/// reusing the previous plan where possible.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="cells">The cells ordered from the target back to (and excluding) the start</param>
+	/// <returns>Whether a path was found</returns>
+	const bool Plan(AStar& astar, int start, int target, std::vector<int>& cells);
+
+	/// <summary>
+	/// Discards the previous plan, the next plan starts over.
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Retrieves the number of cells expanded by the last plan.
+	/// </summary>
+	/// <returns>The number of expanded cells</returns>
+	inline const size_t GetExpansions() const { return m_expansions; }
+
+private:
+
+	/// <summary>
+	/// Starts a new search towards the passed target.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="target">The target cell index</param>
+	void Initialize(AStar& astar, int target);
+
+	/// <summary>
+	/// Expands inconsistent cells until the cost of the start cell is settled.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="start">The start cell index</param>
+	void ComputeShortestPath(AStar& astar, int start);
+
+	/// <summary>
+	/// Recalculates the lookahead cost of the passed cell and requeues it if inconsistent.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="index">The cell index</param>
+	/// <param name="start">The start cell index</param>
+	void UpdateCell(AStar& astar, int index, int start);
+
+	/// <summary>
+	/// Calculates the queue key of the passed cell.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="index">The cell index</param>
+	/// <param name="start">The start cell index</param>
+	/// <returns>The queue key, F holding the primary and H the secondary key</returns>
+	const OpenNode Key(AStar& astar, int index, int start);
+
+	/// <summary>
+	/// Calculates the heuristic cost between the passed cells, fixed for the
+	/// lifetime of the search.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="from">The cell index</param>
+	/// <param name="to">The cell index to estimate the cost to</param>
+	/// <returns>The heuristic cost</returns>
+	const int Heuristic(AStar& astar, int from, int to);
+
+	/// <summary>
+	/// Calculates the cost of stepping from the passed cell onto the passed neighboring cell.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="from">The cell index stepped from</param>
+	/// <param name="to">The cell index stepped onto</param>
+	/// <returns>The movement cost (INT_MAX if either cell is blocked)</returns>
+	const int StepCost(AStar& astar, int from, int to);
+};
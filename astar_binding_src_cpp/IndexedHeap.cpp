@@ -0,0 +1,114 @@
+#include "pch.h"
+
+#include "IndexedHeap.h"
+
+IndexedHeap::IndexedHeap()
+	: m_values(std::vector<OpenNode>()), m_slots(std::vector<int>())
+{
+}
+
+void IndexedHeap::Reset(size_t size)
+{
+	if (m_slots.size() != size)
+	{
+		m_slots.assign(size, -1);
+	}
+	else
+	{
+		// Only the cells left queued by the previous search need clearing
+		for (const OpenNode& node : m_values)
+		{
+			m_slots[node.index] = -1;
+		}
+	}
+	m_values.clear();
+}
+
+void IndexedHeap::Add(int index, int fCost, int hCost)
+{
+	m_values.push_back(OpenNode{ index, fCost, hCost });
+	m_slots[index] = (int)m_values.size() - 1;
+	SortUp((int)m_values.size() - 1);
+}
+
+int IndexedHeap::RemoveFirst()
+{
+	int first = m_values[0].index;
+	m_slots[first] = -1;
+
+	OpenNode last = m_values.back();
+	m_values.pop_back();
+	if (!m_values.empty())
+	{
+		Place(0, last);
+		SortDown(0);
+	}
+	return first;
+}
+
+void IndexedHeap::DecreaseKey(int index, int fCost, int hCost)
+{
+	int slot = m_slots[index];
+	m_values[slot].fCost = fCost;
+	m_values[slot].hCost = hCost;
+	SortUp(slot);
+}
+
+void IndexedHeap::UpdateKey(int index, int fCost, int hCost)
+{
+	int slot = m_slots[index];
+	m_values[slot].fCost = fCost;
+	m_values[slot].hCost = hCost;
+	SortUp(slot);
+	SortDown(m_slots[index]);
+}
+
+void IndexedHeap::Remove(int index)
+{
+	int slot = m_slots[index];
+	m_slots[index] = -1;
+
+	OpenNode last = m_values.back();
+	m_values.pop_back();
+	if (slot < (int)m_values.size())
+	{
+		Place(slot, last);
+		SortUp(slot);
+		SortDown(m_slots[last.index]);
+	}
+}
+
+void IndexedHeap::SortUp(int slot)
+{
+	OpenNode node = m_values[slot];
+	while (slot > 0)
+	{
+		int parent = (slot - 1) / 2;
+		if (!(node < m_values[parent])) { break; }
+
+		Place(slot, m_values[parent]);
+		slot = parent;
+	}
+	Place(slot, node);
+}
+
+void IndexedHeap::SortDown(int slot)
+{
+	OpenNode node = m_values[slot];
+	int size = (int)m_values.size();
+	while (true)
+	{
+		int child = (2 * slot) + 1;
+		if (child >= size) { break; }
+
+		if (child + 1 < size && m_values[child + 1] < m_values[child])
+		{
+			child++;
+		}
+		if (!(m_values[child] < node)) { break; }
+
+		Place(slot, m_values[child]);
+		slot = child;
+	}
+	Place(slot, node);
+}
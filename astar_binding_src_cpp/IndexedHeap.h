@@ -0,0 +1,111 @@
+#pragma once
+
+#include "pch.h"
+#include "SearchArena.h"
+
+/// <summary>
+/// Class representing an indexed binary minimum heap of grid cells
+/// keyed by dense cell index. The heap slot of every queued cell is
+/// tracked, giving constant time membership tests and logarithmic
+/// decrease-key without scanning the heap.
+/// </summary>
+class IndexedHeap
+{
+private:
+	std::vector<OpenNode> m_values;
+	std::vector<int> m_slots;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="IndexedHeap"/> class.
+	/// </summary>
+	IndexedHeap();
+
+	/// <summary>
+	/// Prepares the heap for a search over the passed number of cells,
+	/// removing any remaining elements.
+	/// </summary>
+	/// <param name="size">The number of cells within the grid</param>
+	void Reset(size_t size);
+
+	/// <summary>
+	/// Retrieves the current size of the heap.
+	/// </summary>
+	/// <returns>The size of the heap</returns>
+	inline const size_t Size() const { return m_values.size(); }
+
+	/// <summary>
+	/// Determines whether the heap contains the passed cell.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the heap contains the cell</returns>
+	inline const bool Contains(int index) const { return m_slots[index] >= 0; }
+
+	/// <summary>
+	/// Adds the passed cell into the heap.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="fCost">The F cost of the cell</param>
+	/// <param name="hCost">The H cost of the cell</param>
+	void Add(int index, int fCost, int hCost);
+
+	/// <summary>
+	/// Pops the cell with the minimum cost from the heap.
+	/// </summary>
+	/// <returns>The top minimum cell index</returns>
+	int RemoveFirst();
+
+	/// <summary>
+	/// Lowers the costs of a cell already within the heap.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="fCost">The new F cost of the cell</param>
+	/// <param name="hCost">The new H cost of the cell</param>
+	void DecreaseKey(int index, int fCost, int hCost);
+
+	/// <summary>
+	/// Raises or lowers the costs of a cell already within the heap.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="fCost">The new F cost of the cell</param>
+	/// <param name="hCost">The new H cost of the cell</param>
+	void UpdateKey(int index, int fCost, int hCost);
+
+	/// <summary>
+	/// Removes a cell from anywhere within the heap.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	void Remove(int index);
+
+	/// <summary>
+	/// Retrieves the cell with the minimum cost without removing it.
+	/// </summary>
+	/// <returns>The top minimum node</returns>
+	inline const OpenNode& Peek() const { return m_values[0]; }
+
+private:
+
+	/// <summary>
+	/// Sorts the element at the passed slot upwards.
+	/// </summary>
+	/// <param name="slot">The heap slot</param>
+	void SortUp(int slot);
+
+	/// <summary>
+	/// Sorts the element at the passed slot downwards.
+	/// </summary>
+	/// <param name="slot">The heap slot</param>
+	void SortDown(int slot);
+
+	/// <summary>
+	/// Places the passed node at the passed slot, recording its position.
+	/// </summary>
+	/// <param name="slot">The heap slot</param>
+	/// <param name="node">The node to place</param>
+	inline void Place(int slot, const OpenNode& node)
+	{
+		m_values[slot] = node;
+		m_slots[node.index] = slot;
+	}
+};
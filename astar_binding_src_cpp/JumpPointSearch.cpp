@@ -0,0 +1,290 @@
+#include "pch.h"
+
+#include "JumpPointSearch.h"
+
+/// <summary>
+/// Retrieves the jump distance table of the passed straight direction.
+/// </summary>
+/// <param name="dx">The row direction</param>
+/// <param name="dy">The column direction</param>
+/// <returns>The table index</returns>
+inline int StraightDirection(int dx, int dy)
+{
+	return dx != 0 ? (dx > 0 ? 0 : 1) : (dy > 0 ? 2 : 3);
+}
+
+/// <summary>
+/// Retrieves the sign of the passed value.
+/// </summary>
+/// <param name="value">The value</param>
+/// <returns>-1, 0 or 1</returns>
+inline int Sign(int value)
+{
+	return (value > 0) - (value < 0);
+}
+
+JumpPointSearch::JumpPointSearch()
+	: m_uniform(std::vector<unsigned char>()), m_dirty(true), m_valid(false)
+{
+}
+
+void JumpPointSearch::Update(CompactGrid& grid, const CellMap& cells, int index)
+{
+	if (m_dirty) { return; }
+
+	int width = grid.GetWidth(), height = grid.GetHeight();
+	int row = grid.GetRow(index), col = grid.GetCol(index);
+	for (int x = std::max(row - 1, 0); x <= std::min(row + 1, width - 1); x++)
+	{
+		for (int y = std::max(col - 1, 0); y <= std::min(col + 1, height - 1); y++)
+		{
+			m_uniform[grid.GetIndex(x, y)] = CheckUniform(grid, cells, x, y);
+		}
+	}
+
+	// The uniform cells and forced neighbors changed within a cell of the edit,
+	// so only the rows and columns through them are scanned again
+	for (int y = std::max(col - 1, 0); y <= std::min(col + 1, height - 1); y++)
+	{
+		BuildLine(grid, cells, true, y);
+	}
+	for (int x = std::max(row - 1, 0); x <= std::min(row + 1, width - 1); x++)
+	{
+		BuildLine(grid, cells, false, x);
+	}
+}
+
+const bool JumpPointSearch::Prepare(CompactGrid& grid, const CellMap& cells)
+{
+	if (!m_dirty) { return m_valid; }
+
+	int width = grid.GetWidth(), height = grid.GetHeight();
+	m_uniform.assign(grid.GetSize(), 0);
+	for (int x = 0; x < width; x++)
+	{
+		for (int y = 0; y < height; y++)
+		{
+			m_uniform[grid.GetIndex(x, y)] = CheckUniform(grid, cells, x, y);
+		}
+	}
+
+	for (std::vector<int16_t>& jumps : m_jumps)
+	{
+		jumps.assign(grid.GetSize(), 0);
+	}
+	for (int y = 0; y < height; y++)
+	{
+		BuildLine(grid, cells, true, y);
+	}
+	for (int x = 0; x < width; x++)
+	{
+		BuildLine(grid, cells, false, x);
+	}
+
+	// Pruning assumes a diagonal step costs more than one, and at most
+	// two, orthogonal steps - not the case on grids with small cells
+	m_valid = false;
+	if (width > 1 && height > 1)
+	{
+		Vec3 origin = grid.GetPosition(grid.GetIndex(0, 0));
+		float dx = abs(grid.GetPosition(grid.GetIndex(1, 0)).x - origin.x);
+		float dz = abs(grid.GetPosition(grid.GetIndex(0, 1)).z - origin.z);
+		int orthogonalX = ceil(dx), orthogonalZ = ceil(dz), diagonal = ceil(dx + dz);
+		m_valid = orthogonalX == orthogonalZ && orthogonalX < diagonal && diagonal <= 2 * orthogonalX;
+	}
+	m_dirty = false;
+	return m_valid;
+}
+
+int JumpPointSearch::GetSuccessors(CompactGrid& grid, const CellMap& cells, int current, int parent, int target, int* successors)
+{
+	int row = grid.GetRow(current), col = grid.GetCol(current);
+	int directions[8][2];
+	int count = 0;
+
+	if (parent < 0 || !m_uniform[current])
+	{
+		// Regular expansion, every direction is considered
+		for (int x = -1; x <= 1; x++)
+		{
+			for (int y = -1; y <= 1; y++)
+			{
+				if (x == 0 && y == 0) { continue; }
+
+				directions[count][0] = x;
+				directions[count][1] = y;
+				count++;
+			}
+		}
+	}
+	else
+	{
+		int dx = Sign(row - grid.GetRow(parent));
+		int dy = Sign(col - grid.GetCol(parent));
+		if (dx != 0 && dy != 0)
+		{
+			// Natural neighbors of a diagonal move
+			directions[count][0] = dx; directions[count++][1] = 0;
+			directions[count][0] = 0; directions[count++][1] = dy;
+			directions[count][0] = dx; directions[count++][1] = dy;
+
+			// Forced neighbors
+			if (!cells.IsWalkable(row - dx, col))
+			{
+				directions[count][0] = -dx; directions[count++][1] = dy;
+			}
+			if (!cells.IsWalkable(row, col - dy))
+			{
+				directions[count][0] = dx; directions[count++][1] = -dy;
+			}
+		}
+		else
+		{
+			// Natural neighbor of a straight move
+			directions[count][0] = dx; directions[count++][1] = dy;
+
+			// Forced neighbors, perpendicular to the move
+			int px = dy != 0 ? 1 : 0;
+			int py = dx != 0 ? 1 : 0;
+			if (!cells.IsWalkable(row + px, col + py))
+			{
+				directions[count][0] = dx + px; directions[count++][1] = dy + py;
+			}
+			if (!cells.IsWalkable(row - px, col - py))
+			{
+				directions[count][0] = dx - px; directions[count++][1] = dy - py;
+			}
+		}
+	}
+
+	int found = 0;
+	for (int i = 0; i < count; i++)
+	{
+		int jumpPoint = Jump(grid, cells, row, col, directions[i][0], directions[i][1], target);
+		if (jumpPoint >= 0)
+		{
+			successors[found++] = jumpPoint;
+		}
+	}
+	return found;
+}
+
+const bool JumpPointSearch::CheckUniform(CompactGrid& grid, const CellMap& cells, int row, int col)
+{
+	if (!cells.IsWalkable(row, col)) { return false; }
+
+	int index = grid.GetIndex(row, col);
+	int width = grid.GetWidth(), height = grid.GetHeight();
+	for (int x = std::max(row - 1, 0); x <= std::min(row + 1, width - 1); x++)
+	{
+		for (int y = std::max(col - 1, 0); y <= std::min(col + 1, height - 1); y++)
+		{
+			if (!cells.IsWalkable(x, y)) { continue; }
+
+			int other = grid.GetIndex(x, y);
+			if (cells.GetPenalty(other) != cells.GetPenalty(index) ||
+				!(abs(grid.GetPosition(other).y - grid.GetPosition(index).y) < FLT_EPSILON))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+const bool JumpPointSearch::IsForced(const CellMap& cells, int row, int col, int dx, int dy) const
+{
+	int px = dy != 0 ? 1 : 0;
+	int py = dx != 0 ? 1 : 0;
+	return (!cells.IsWalkable(row + px, col + py) && cells.IsWalkable(row + dx + px, col + dy + py)) ||
+		(!cells.IsWalkable(row - px, col - py) && cells.IsWalkable(row + dx - px, col + dy - py));
+}
+
+void JumpPointSearch::BuildLine(CompactGrid& grid, const CellMap& cells, bool horizontal, int line)
+{
+	int length = horizontal ? grid.GetWidth() : grid.GetHeight();
+	for (int sign : { 1, -1 })
+	{
+		int dx = horizontal ? sign : 0, dy = horizontal ? 0 : sign;
+		std::vector<int16_t>& jumps = m_jumps[StraightDirection(dx, dy)];
+
+		// Swept from the far end, every cell extends the span of the cell after it
+		int span = 0;
+		for (int step = length - 1; step >= 0; step--)
+		{
+			int position = sign > 0 ? step : length - 1 - step;
+			int row = horizontal ? position : line, col = horizontal ? line : position;
+			jumps[grid.GetIndex(row, col)] = (int16_t)span;
+
+			int index = grid.GetIndex(row, col);
+			if (!cells.IsWalkable(row, col))
+			{
+				span = 0;
+			}
+			else if (!m_uniform[index] || IsForced(cells, row, col, dx, dy))
+			{
+				span = 1;
+			}
+			else if (span > 0)
+			{
+				span = span < JUMP_SPAN_MAX ? span + 1 : -JUMP_SPAN_MAX;
+			}
+			else
+			{
+				span = span > -JUMP_SPAN_MAX ? span - 1 : -JUMP_SPAN_MAX;
+			}
+		}
+	}
+}
+
+int JumpPointSearch::JumpStraight(CompactGrid& grid, int row, int col, int dx, int dy, int target)
+{
+	const std::vector<int16_t>& jumps = m_jumps[StraightDirection(dx, dy)];
+	int stride = dx + dy * (int)grid.GetWidth();
+	int index = grid.GetIndex(row, col);
+
+	// Steps along the line to the target, if it lies ahead on it
+	int targetRow = grid.GetRow(target), targetCol = grid.GetCol(target);
+	int ahead = dx != 0
+		? (targetCol == col ? (targetRow - row) * dx : 0)
+		: (targetRow == row ? (targetCol - col) * dy : 0);
+
+	while (true)
+	{
+		int span = jumps[index];
+		int steps = abs(span);
+		if (ahead > 0 && ahead <= steps) { return target; }
+		if (span > 0) { return index + span * stride; }
+		if (steps < JUMP_SPAN_MAX) { return -1; }
+
+		index += steps * stride;
+		ahead -= steps;
+	}
+}
+
+int JumpPointSearch::Jump(CompactGrid& grid, const CellMap& cells, int row, int col, int dx, int dy, int target)
+{
+	if (dx == 0 || dy == 0) { return JumpStraight(grid, row, col, dx, dy, target); }
+
+	while (true)
+	{
+		row += dx;
+		col += dy;
+		if (!cells.IsWalkable(row, col)) { return -1; }
+
+		int index = grid.GetIndex(row, col);
+		if (index == target || !m_uniform[index]) { return index; }
+
+		if ((!cells.IsWalkable(row - dx, col) && cells.IsWalkable(row - dx, col + dy)) ||
+			(!cells.IsWalkable(row, col - dy) && cells.IsWalkable(row + dx, col - dy)))
+		{
+			return index;
+		}
+
+		// A diagonal step is a jump point when either straight scan finds one
+		if (JumpStraight(grid, row, col, dx, 0, target) >= 0 || JumpStraight(grid, row, col, 0, dy, target) >= 0)
+		{
+			return index;
+		}
+	}
+}
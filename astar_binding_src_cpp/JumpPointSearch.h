@@ -0,0 +1,140 @@
+#pragma once
+
+#include "pch.h"
+#include "CompactGrid.h"
+#include "CellMap.h"
+
+// Longest straight span a jump distance holds, longer spans are stored
+// as several consecutive spans
+#define JUMP_SPAN_MAX INT16_MAX
+
+/// <summary>
+/// Class representing the successor generation of Jump Point Search
+/// (Harabor and Grastien, corner cutting allowed) over the search grid.
+/// Jumps only travel across uniform cells - walkable cells whose walkable
+/// neighbors share their movement penalty and height. Every other cell
+/// stops a jump and is expanded without pruning, so weighted terrain is
+/// searched exactly like regular A*. The straight jumps are precomputed
+/// (JPS+) as the distance from every cell to the next jump point or wall
+/// along each straight direction, so a straight jump is a table lookup and
+/// a diagonal jump a walk of lookups.
+/// </summary>
+class JumpPointSearch
+{
+private:
+	std::vector<unsigned char> m_uniform;
+
+	// Straight jump distances per direction (+row, -row, +col, -col), positive
+	// - a jump point that many steps away, otherwise that many walkable steps
+	// before a wall, continued from there when the span is JUMP_SPAN_MAX
+	std::vector<int16_t> m_jumps[4];
+	bool m_dirty, m_valid;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="JumpPointSearch"/> class.
+	/// </summary>
+	JumpPointSearch();
+
+	/// <summary>
+	/// Marks the uniform cell map as requiring a rebuild.
+	/// </summary>
+	inline void Invalidate() { m_dirty = true; }
+
+	/// <summary>
+	/// Updates the uniform cell map around the passed edited cell.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <param name="index">The edited cell index</param>
+	void Update(CompactGrid& grid, const CellMap& cells, int index);
+
+	/// <summary>
+	/// Rebuilds the uniform cell map if it has been invalidated.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <returns>Whether the grid step costs allow jumping (orthogonal cost
+	///			 below the diagonal cost, diagonal at most two orthogonal)</returns>
+	const bool Prepare(CompactGrid& grid, const CellMap& cells);
+
+	/// <summary>
+	/// Determines whether the prepared uniform cell map allows jumping.
+	/// </summary>
+	/// <returns>Whether the map is prepared and the grid step costs allow jumping</returns>
+	inline const bool IsValid() const { return !m_dirty && m_valid; }
+
+	/// <summary>
+	/// Retrieves the jump point successors of the passed cell.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <param name="current">The cell index being expanded</param>
+	/// <param name="parent">The parent cell index (-1 for the start cell)</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="successors">The buffer to fill (at least 8 elements)</param>
+	/// <returns>The number of successors written</returns>
+	int GetSuccessors(CompactGrid& grid, const CellMap& cells, int current, int parent, int target, int* successors);
+
+private:
+
+	/// <summary>
+	/// Determines whether the passed cell is uniform.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>Whether the cell is uniform</returns>
+	const bool CheckUniform(CompactGrid& grid, const CellMap& cells, int row, int col);
+
+	/// <summary>
+	/// Determines whether the passed cell is a jump point when travelled
+	/// onto in the passed straight direction, having a forced neighbor.
+	/// </summary>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <param name="dx">The row direction</param>
+	/// <param name="dy">The column direction</param>
+	/// <returns>Whether the cell has a forced neighbor</returns>
+	const bool IsForced(const CellMap& cells, int row, int col, int dx, int dy) const;
+
+	/// <summary>
+	/// Rebuilds the straight jump distances along the passed row or column
+	/// in both of its directions.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <param name="horizontal">Whether to rebuild a line of cells along the rows (fixed column)</param>
+	/// <param name="line">The column index of a horizontal line, otherwise the row index</param>
+	void BuildLine(CompactGrid& grid, const CellMap& cells, bool horizontal, int line);
+
+	/// <summary>
+	/// Travels from the passed cell in the passed straight direction until
+	/// a jump point is found, reading the precomputed jump distances.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="row">The row index to jump from</param>
+	/// <param name="col">The column index to jump from</param>
+	/// <param name="dx">The row direction</param>
+	/// <param name="dy">The column direction</param>
+	/// <param name="target">The target cell index</param>
+	/// <returns>The jump point cell index or -1 if none was found</returns>
+	int JumpStraight(CompactGrid& grid, int row, int col, int dx, int dy, int target);
+
+	/// <summary>
+	/// Travels from the passed cell in the passed direction until
+	/// a jump point is found.
+	/// </summary>
+	/// <param name="grid">The search grid</param>
+	/// <param name="cells">The walkability and penalty layout of the grid</param>
+	/// <param name="row">The row index to jump from</param>
+	/// <param name="col">The column index to jump from</param>
+	/// <param name="dx">The row direction</param>
+	/// <param name="dy">The column direction</param>
+	/// <param name="target">The target cell index</param>
+	/// <returns>The jump point cell index or -1 if none was found</returns>
+	int Jump(CompactGrid& grid, const CellMap& cells, int row, int col, int dx, int dy, int target);
+};
@@ -0,0 +1,166 @@
+#include "pch.h"
+
+#include "Landmarks.h"
+#include "AStar.h"
+
+Landmarks::Landmarks()
+	: m_dirty(true), m_count(0), m_size(0), m_buildTime(0)
+{
+}
+
+void Landmarks::SetCount(int count)
+{
+	m_count = count > 0 ? count : 0;
+	m_dirty = true;
+}
+
+void Landmarks::Prepare(AStar& astar)
+{
+	if (!m_dirty) { return; }
+
+	m_dirty = false;
+	m_cells.clear();
+	m_scales.clear();
+	m_steps.clear();
+	m_forward.clear();
+	m_backward.clear();
+	m_buildTime = 0;
+	if (m_count == 0) { return; }
+
+	auto begin = std::chrono::steady_clock::now();
+	CompactGrid& grid = astar.GetGrid();
+	m_size = grid.GetSize();
+
+	// Landmarks only cover the largest component, queries between
+	// components are rejected before the heuristic is asked
+	const ConnectedComponents& components = astar.GetComponents();
+	int seed = -1, seedSize = 0;
+	for (int index = 0; index < m_size; index++)
+	{
+		if (astar.IsWalkable(index) && components.GetSize(index) > seedSize)
+		{
+			seed = index;
+			seedSize = components.GetSize(index);
+		}
+	}
+	if (seed < 0) { return; }
+
+	// Every landmark is the cell farthest from the ones already chosen,
+	// the first one the cell farthest from an arbitrary seed
+	Sweep(astar, seed, false, m_costs);
+	m_nearest.assign(m_costs.begin(), m_costs.end());
+	m_forward.resize((size_t)m_count * m_size);
+	m_backward.resize((size_t)m_count * m_size);
+	for (int landmark = 0; landmark < m_count; landmark++)
+	{
+		int farthest = -1;
+		for (int index = 0; index < m_size; index++)
+		{
+			if (m_nearest[index] != INT_MAX && m_nearest[index] > 0 && (farthest < 0 || m_nearest[index] > m_nearest[farthest]))
+			{
+				farthest = index;
+			}
+		}
+		if (farthest < 0) { break; }
+
+		int step = std::min(Sweep(astar, farthest, false, m_costs), Sweep(astar, farthest, true, m_reverseCosts));
+		int highest = 0;
+		for (int index = 0; index < m_size; index++)
+		{
+			if (m_costs[index] == INT_MAX) { continue; }
+
+			highest = std::max(highest, std::max(m_costs[index], m_reverseCosts[index]));
+			m_nearest[index] = std::min(m_nearest[index], m_costs[index]);
+		}
+
+		// Scaled down only where the costs do not fit the table
+		int scale = std::max(1, highest / (LANDMARK_UNREACHABLE - 1) + (highest % (LANDMARK_UNREACHABLE - 1) != 0));
+		Store(m_costs, scale, &m_forward[(size_t)landmark * m_size]);
+		Store(m_reverseCosts, scale, &m_backward[(size_t)landmark * m_size]);
+		m_cells.push_back(farthest);
+		m_scales.push_back(scale);
+		m_steps.push_back(step);
+	}
+	m_forward.resize(m_cells.size() * m_size);
+	m_backward.resize(m_cells.size() * m_size);
+
+	m_buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+const int Landmarks::LowerBound(int from, int target) const
+{
+	int bound = 0;
+	for (size_t landmark = 0; landmark < m_cells.size(); landmark++)
+	{
+		const uint16_t* forward = &m_forward[landmark * m_size];
+		const uint16_t* backward = &m_backward[landmark * m_size];
+		if (forward[from] == LANDMARK_UNREACHABLE || forward[target] == LANDMARK_UNREACHABLE) { continue; }
+
+		// From the landmark to the target no cheaper than through the cell,
+		// from the cell to the landmark no cheaper than through the target
+		bound = std::max(bound, Bound(forward[target] - forward[from], m_scales[landmark], m_steps[landmark]));
+		bound = std::max(bound, Bound(backward[from] - backward[target], m_scales[landmark], m_steps[landmark]));
+	}
+	return bound;
+}
+
+const std::tuple<int, size_t, double> Landmarks::GetStats() const
+{
+	size_t bytes = (m_forward.size() + m_backward.size()) * sizeof(uint16_t)
+		+ (m_cells.size() + m_scales.size() + m_steps.size()) * sizeof(int);
+	return std::make_tuple((int)m_cells.size(), bytes, m_buildTime);
+}
+
+int Landmarks::Sweep(AStar& astar, int source, bool reverse, std::vector<int>& costs)
+{
+	costs.assign(m_size, INT_MAX);
+	m_arena.Begin(m_size);
+	m_open.Reset(m_size);
+	m_arena.Open(source, 0, 0, -1);
+	m_open.Add(source, 0, 0);
+
+	int step = INT_MAX;
+	int neighbors[8];
+	while (m_open.Size() > 0)
+	{
+		int current = m_open.RemoveFirst();
+		m_arena.Close(current);
+
+		int currentG = m_arena[current].gCost;
+		costs[current] = currentG;
+
+		int count = astar.GetCells().GetWalkableNeighbors(current, neighbors);
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+			int moveCost = reverse ? astar.MoveCost(neighbor, current) : astar.MoveCost(current, neighbor);
+			step = std::min(step, moveCost);
+			if (m_arena.IsClosed(neighbor)) { continue; }
+
+			int newMoveCost = currentG + moveCost;
+			if (m_arena.IsOpen(neighbor))
+			{
+				SearchNode& node = m_arena[neighbor];
+				if (newMoveCost < node.gCost)
+				{
+					node.gCost = newMoveCost;
+					m_open.DecreaseKey(neighbor, newMoveCost, 0);
+				}
+			}
+			else
+			{
+				m_arena.Open(neighbor, newMoveCost, 0, current);
+				m_open.Add(neighbor, newMoveCost, 0);
+			}
+		}
+	}
+	return step == INT_MAX ? 0 : step;
+}
+
+void Landmarks::Store(const std::vector<int>& costs, int scale, uint16_t* table)
+{
+	for (int index = 0; index < m_size; index++)
+	{
+		table[index] = costs[index] == INT_MAX ? LANDMARK_UNREACHABLE : (uint16_t)(costs[index] / scale);
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "pch.h"
+#include "SearchArena.h"
+#include "BucketQueue.h"
+
+class AStar;
+
+// Stored distance marking a cell the landmark cannot reach or be reached from
+#define LANDMARK_UNREACHABLE 0xFFFF
+
+/// <summary>
+/// Class representing the landmark (ALT) distance tables of a grid. A few
+/// landmark cells are spread across the largest component and the cost from
+/// every landmark to every cell and back is stored, quantised to 16 bits. By
+/// the triangle inequality the differences of those costs bound the cost
+/// between any two cells from below, which is far tighter than the straight
+/// line distance on maze-like or heavily weighted grids. Every grid edit
+/// invalidates the tables, rebuilt by the next <see cref="Prepare"/>.
+/// </summary>
+class Landmarks
+{
+private:
+	bool m_dirty;
+	int m_count;
+	int m_size;
+	double m_buildTime;
+
+	// Landmark cells, and per landmark the cost from it to every cell (forward)
+	// and from every cell to it (backward) rounded down to a multiple of its
+	// scale, along with the cheapest single step of its component
+	std::vector<int> m_cells;
+	std::vector<int> m_scales;
+	std::vector<int> m_steps;
+	std::vector<uint16_t> m_forward;
+	std::vector<uint16_t> m_backward;
+
+	std::vector<int> m_costs;
+	std::vector<int> m_reverseCosts;
+	std::vector<int> m_nearest;
+	SearchArena m_arena;
+	BucketQueue m_open;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Landmarks"/> class.
+	/// </summary>
+	Landmarks();
+
+	/// <summary>
+	/// Sets the number of landmarks, invalidating the tables.
+	/// </summary>
+	/// <param name="count">The number of landmarks (0 - disabled)</param>
+	void SetCount(int count);
+
+	/// <summary>
+	/// Retrieves the requested number of landmarks.
+	/// </summary>
+	/// <returns>The number of landmarks</returns>
+	inline const int GetCount() const { return m_count; }
+
+	/// <summary>
+	/// Marks the tables to be rebuilt by the next <see cref="Prepare"/>.
+	/// </summary>
+	inline void Invalidate() { m_dirty = true; }
+
+	/// <summary>
+	/// Determines whether the tables are current and hold any landmark.
+	/// </summary>
+	/// <returns>Whether the tables are current</returns>
+	inline const bool IsValid() const { return !m_dirty && !m_cells.empty(); }
+
+	/// <summary>
+	/// Selects the landmarks and rebuilds the tables if they have been
+	/// invalidated and landmarks are enabled.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	void Prepare(AStar& astar);
+
+	/// <summary>
+	/// Calculates the lower bound on the cost from the passed cell to the
+	/// passed target cell over every landmark.
+	/// </summary>
+	/// <param name="from">The cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <returns>The lower bound (0 if no landmark relates the cells)</returns>
+	const int LowerBound(int from, int target) const;
+
+	/// <summary>
+	/// Retrieves the size and build time of the current tables.
+	/// </summary>
+	/// <returns>A tuple containing the landmarks, bytes held and preprocessing milliseconds</returns>
+	const std::tuple<int, size_t, double> GetStats() const;
+
+private:
+
+	/// <summary>
+	/// Runs a Dijkstra sweep from the passed cell over its component.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="source">The cell index to sweep from</param>
+	/// <param name="reverse">Whether to measure the cost towards the cell instead of away from it</param>
+	/// <param name="costs">The cost of every cell (INT_MAX if unreachable)</param>
+	/// <returns>The cheapest single step relaxed</returns>
+	int Sweep(AStar& astar, int source, bool reverse, std::vector<int>& costs);
+
+	/// <summary>
+	/// Quantises the passed costs into the passed table.
+	/// </summary>
+	/// <param name="costs">The cost of every cell</param>
+	/// <param name="scale">The scale the costs are divided by</param>
+	/// <param name="table">The table of the landmark</param>
+	void Store(const std::vector<int>& costs, int scale, uint16_t* table);
+
+	/// <summary>
+	/// Converts the difference of two quantised costs into a lower bound.
+	/// Rounding leaves the difference up to one scale short of the true one,
+	/// so it is shrunk by the cheapest step against that slack, keeping the
+	/// bound consistent as well as admissible.
+	/// </summary>
+	/// <param name="difference">The difference of the quantised costs</param>
+	/// <param name="scale">The scale of the table</param>
+	/// <param name="step">The cheapest single step of the component</param>
+	/// <returns>The lower bound</returns>
+	inline static const int Bound(int difference, int scale, int step)
+	{
+		if (difference <= 0) { return 0; }
+		if (scale == 1) { return difference; }
+		return (int)((long long)(difference * scale - (scale - 1)) * step / (step + scale - 1));
+	}
+};
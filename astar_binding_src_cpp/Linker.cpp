@@ -2,83 +2,156 @@
 #include "Linker.h"
 
 Linker::Linker()
-	: astar(Vec2(), 0, 0, Vec3())
+	: m_world(Vec2(), 0, 0, Vec3())
 {
 }
 
 void Linker::DestroyImpl()
 {
-	// To Do implement necessary memory managment
+	// Join the workers before the library unloads
+	std::lock_guard<std::mutex> lock(m_poolLock);
+	m_pool.reset();
 }
 
-void Linker::SetUpImpl(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset)
+ThreadPool& Linker::Pool()
 {
-	astar = AStar(gridSize, minPenalty, maxPenalty, worldOffset);
+	std::lock_guard<std::mutex> lock(m_poolLock);
+	if (!m_pool)
+	{
+		m_pool = std::make_unique<ThreadPool>();
+	}
+	return *m_pool;
 }
 
-void Linker::ClearGridImpl()
+SearchContext& Linker::LocalContext()
 {
-	astar.Clear();
+	thread_local SearchContext context;
+	return context;
 }
 
-void Linker::AddGridPointImpl(Vec3 coordinate, Vec2 gridCoord, bool walkable, int movementPenalty)
+float* Linker::ConvertGridPoint(const PathPoint& point)
 {
-	astar.AddGridPoint(PathPoint(coordinate, gridCoord, walkable, movementPenalty));
+	Vec3 pos = point.GetPosition();
+	return new float[5]
+	{
+		pos.x, pos.y, pos.z,
+		(float)point.GetMovementPenalty(),
+		(float)point.GetWalkable() ? 1.0f : 0.0f
+	};
 }
 
-void Linker::AddGridPointsImpl(float* points, int d1)
+float* Linker::FindPath(World& world, SearchContext& context, Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist, int flags,
+						const SearchOptions& options, bool partial)
 {
-	astar.AddGridPoints(points, d1);
+	// The packed result carries no partial marker, so callers not
+	// asking for a partial path receive none, as before budgets
+	std::vector<Vec3> path = world.FindPath(start, end, flags, context, options);
+	if (context.partial && !partial) { path.clear(); }
+
+	std::vector<float> unpacked;
+	UnpackPath(path, start, smooth, turnDist, stopDist, unpacked);
+	return ToArray(unpacked);
 }
 
-float* Linker::GetGridPointImpl(Vec3 coordinate)
+float* Linker::FindPath(TiledWorld& world, TiledContext& context, Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist, const SearchOptions& options)
 {
-	return ConvertGridPoint(astar.GetGridPoint(coordinate));
+	std::vector<float> unpacked;
+	UnpackPath(world.FindPath(start, end, context, options), start, smooth, turnDist, stopDist, unpacked);
+	return ToArray(unpacked);
 }
 
-float* Linker::GetGridPointImpl(unsigned int xGrid, unsigned int yGrid)
+int Linker::FindPath(TiledWorld& world, TiledContext& context, Vec3 start, Vec3 end, const SearchOptions& options, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
 {
-	return ConvertGridPoint(astar.GetGridPoint(xGrid, yGrid));
+	// The tiled search is exact unless a budget cuts it short
+	std::vector<Vec3> path = world.FindPath(start, end, context, options);
+	return WriteVertices(path, context.partial ? 0.0f : 1.0f, context.partial, info, buffer, capacity);
 }
 
-float* Linker::ConvertGridPoint(const PathPoint& point)
+float* Linker::FindPath(World& world, IncrementalPlanner& planner, Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist)
 {
-	Vec3 pos = point.GetPosition();
-	return new float[5]
-	{
-		pos.x, pos.y, pos.z,
-		(float)point.GetMovementPenalty(),
-		(float)point.GetWalkable() ? 1.0f : 0.0f
-	};
+	std::vector<float> unpacked;
+	UnpackPath(world.FindPath(start, end, planner), start, smooth, turnDist, stopDist, unpacked);
+	return ToArray(unpacked);
+}
+
+float* Linker::GetSearchResult(World& world, SteppedSearch& search, bool smooth, float turnDist, float stopDist)
+{
+	std::vector<float> unpacked;
+	UnpackPath(world.GetSearchResult(search), search.startCoordinate, smooth, turnDist, stopDist, unpacked);
+	return ToArray(unpacked);
+}
+
+int Linker::FindPath(World& world, SearchContext& context, Vec3 start, Vec3 end, int flags, const SearchOptions& options, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
+{
+	std::vector<Vec3> path = world.FindPath(start, end, flags, context, options);
+	return WriteVertices(path, context.bound, context.partial, info, buffer, capacity);
 }
 
-float* Linker::GetNearestNeighborImpl(Vec3 coordinate)
+int Linker::FindSmoothPath(World& world, SearchContext& context, Vec3 start, Vec3 end, float turnDist, float stopDist, int flags, const SearchOptions& options,
+						   NativePathInfo* info, NativeTurnPoint* buffer, int capacity)
 {
-	return ConvertToFloatArray(astar.GetNearestNeighbors(coordinate));
+	return WriteSmoothPath(SmoothPath(world.FindPath(start, end, flags, context, options), start, turnDist, stopDist), context, info, buffer, capacity);
 }
 
-float* Linker::FindPathImpl(Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist)
+float* Linker::FindPaths(World& world, const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags)
+{
+	std::vector<std::vector<float>> paths(std::max(count, 0));
+	Get().Pool().ParallelFor(count, [&](int i)
+	{
+		const float* request = requests + (i * 6);
+		Vec3 start(request[0], request[1], request[2]);
+		Vec3 end(request[3], request[4], request[5]);
+		SearchContext& context = LocalContext();
+		std::vector<Vec3> path = world.FindPath(start, end, flags, context);
+		if (context.partial) { path.clear(); }
+		UnpackPath(path, start, smooth, turnDist, stopDist, paths[i]);
+	});
+
+	// Total size, request count, offset of every path, paths...
+	size_t size = paths.size() + 2;
+	for (const std::vector<float>& path : paths)
+	{
+		size += path.size();
+	}
+
+	std::vector<float> unpacked;
+	unpacked.reserve(size);
+	unpacked.emplace_back(size);
+	unpacked.emplace_back(paths.size());
+
+	size_t offset = paths.size() + 2;
+	for (const std::vector<float>& path : paths)
+	{
+		unpacked.emplace_back(offset);
+		offset += path.size();
+	}
+	for (const std::vector<float>& path : paths)
+	{
+		unpacked.insert(unpacked.end(), path.begin(), path.end());
+	}
+	return ToArray(unpacked);
+}
+
+void Linker::UnpackPath(const std::vector<Vec3>& points, Vec3 start, bool smooth, float turnDist, float stopDist, std::vector<float>& unpacked)
 {
-	std::vector<Vec3> points = astar.FindPath(start, end);
 	if (smooth)
 	{
-		return UnpackSmoothPath(SmoothPath(points, start, turnDist, stopDist));
+		UnpackSmoothPath(SmoothPath(points, start, turnDist, stopDist), unpacked);
 	}
 	else
 	{
-		return ConvertToFloatArray(points);
+		UnpackVertices(points, unpacked);
 	}
 }
 
-float* Linker::UnpackSmoothPath(const SmoothPath& path)
+void Linker::UnpackSmoothPath(const SmoothPath& path, std::vector<float>& unpacked)
 {
-	std::vector<float> unpacked;
-	std::vector<Vec3> points = path.GetLookPoints();
-	std::vector<Line> turns = path.GetTurnBoundaries();
+	const std::vector<Vec3>& points = path.GetLookPoints();
+	const std::vector<Line>& turns = path.GetTurnBoundaries();
 
 	// First index as indicator for size of array
 	int size = (points.size() * 3) + (turns.size() * 7) + 3;
-	unpacked.reserve(size);
+	unpacked.reserve(unpacked.size() + size);
 	unpacked.emplace_back((points.size() * 3) + (turns.size() * 7) + 3);
 
 	// Push back finish line and slow down indices
@@ -100,21 +173,23 @@ float* Linker::UnpackSmoothPath(const SmoothPath& path)
 		unpacked.emplace_back(turns[i].GetPointOnLine2().y);
 		unpacked.emplace_back(turns[i].GetApproachSide() ? 1.0f : 0.0f);
 	}
+}
 
-	float* data = new float[unpacked.size()];
-	std::copy(unpacked.begin(), unpacked.end(), data);
-	return data;
+int* Linker::BlurWeights(World& world, int size)
+{
+	std::tuple<int, int> weights = world.BlurWeights(size, &Get().Pool());
+	return new int[2]{ std::get<0>(weights), std::get<1>(weights) };
 }
 
-int* const Linker::BlurWeightsImpl(int size)
+int* Linker::ReblurWeights(World& world)
 {
-	std::tuple<int, int> weights = astar.BlurWeights(size);
+	std::tuple<int, int> weights = world.ReblurWeights(&Get().Pool());
 	return new int[2]{ std::get<0>(weights), std::get<1>(weights) };
 }
 
-float* Linker::ExportImpl()
+float* Linker::Export(World& world)
 {
-	std::tuple<std::vector<PathPoint>, Vec3, int, int, int, int> packed_astar = astar.ExportGrid();
+	std::tuple<std::vector<PathPoint>, Vec3, int, int, int, int> packed_astar = world.ExportGrid();
 	std::vector<PathPoint> packed_grid = std::get<0>(packed_astar);
 
 	if (packed_grid.size() == 0) { return new float[0]{}; }
@@ -153,9 +228,42 @@ float* Linker::ExportImpl()
 	return data;
 }
 
-void Linker::ImportImpl(float* points, int d1)
+int Linker::ExportSnapshot(World& world, uint8_t* buffer, int capacity)
 {
-	astar = AStar(points, d1);
+	std::vector<uint8_t> data;
+	world.ExportSnapshot(data);
+	if (buffer != nullptr && (int)data.size() <= capacity)
+	{
+		std::copy(data.begin(), data.end(), buffer);
+	}
+	return (int)data.size();
+}
+
+bool Linker::ImportSnapshot(World& world, const uint8_t* data, int size)
+{
+	return size > 0 && world.ImportSnapshot(data, size);
+}
+
+bool Linker::SaveSnapshot(World& world, const char* path)
+{
+	std::vector<uint8_t> data;
+	world.ExportSnapshot(data);
+
+	std::ofstream file(path, std::ios::binary);
+	file.write(reinterpret_cast<const char*>(data.data()), data.size());
+	return file.good();
+}
+
+bool Linker::LoadSnapshot(World& world, const char* path)
+{
+	// The whole file is read in one go, the snapshot is decoded straight from it
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) { return false; }
+
+	std::vector<uint8_t> data((size_t)file.tellg());
+	file.seekg(0);
+	file.read(reinterpret_cast<char*>(data.data()), data.size());
+	return file.good() && world.ImportSnapshot(data.data(), data.size());
 }
 
 float* Linker::ConvertToFloatArray(const std::vector<PathPoint>& points)
@@ -178,21 +286,72 @@ float* Linker::ConvertToFloatArray(const std::vector<PathPoint>& points)
 	return data;
 }
 
-float* Linker::ConvertToFloatArray(const std::vector<Vec3>& vertices)
+void Linker::UnpackVertices(const std::vector<Vec3>& vertices, std::vector<float>& unpacked)
 {
-	std::vector<float> unpacked;
 	unsigned int size = (vertices.size() * 3) + 1;
-	unpacked.reserve(size);
+	unpacked.reserve(unpacked.size() + size);
 	unpacked.emplace_back(size);
-	Vec3 vec;
 	for (int i = 0; i < vertices.size(); i++)
 	{
 		unpacked.emplace_back(vertices[i].x);
 		unpacked.emplace_back(vertices[i].y);
 		unpacked.emplace_back(vertices[i].z);
 	}
+}
 
+void Linker::WriteGridPoint(const PathPoint& point, NativeGridPoint* written)
+{
+	Vec3 pos = point.GetPosition();
+	*written = { pos.x, pos.y, pos.z, point.GetMovementPenalty(), point.GetWalkable() ? 1 : 0 };
+}
+
+int Linker::WriteVertices(const std::vector<Vec3>& vertices, float bound, bool partial, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
+{
+	int count = (int)vertices.size();
+	if (info != nullptr)
+	{
+		// Waypoints are not smoothed, leaving no finish line or slow down index
+		*info = { count, -1, -1, bound, partial ? 1 : 0 };
+	}
+	if (buffer == nullptr || count > capacity) { return count; }
+
+	for (int i = 0; i < count; i++)
+	{
+		buffer[i] = { vertices[i].x, vertices[i].y, vertices[i].z };
+	}
+	return count;
+}
+
+int Linker::WriteSmoothPath(const SmoothPath& path, const SearchContext& context, NativePathInfo* info, NativeTurnPoint* buffer, int capacity)
+{
+	const std::vector<Vec3>& points = path.GetLookPoints();
+	const std::vector<Line>& turns = path.GetTurnBoundaries();
+
+	int count = (int)points.size();
+	if (info != nullptr)
+	{
+		*info = { count, path.GetFinishLineIndex(), path.GetSlowDownIndex(), context.bound, context.partial ? 1 : 0 };
+	}
+	if (buffer == nullptr || count > capacity) { return count; }
+
+	for (int i = 0; i < count; i++)
+	{
+		buffer[i] =
+		{
+			points[i].x, points[i].y, points[i].z,
+			turns[i].GetGradient(),
+			turns[i].GetPerpGradient(),
+			turns[i].GetPointOnLine1().x, turns[i].GetPointOnLine1().y,
+			turns[i].GetPointOnLine2().x, turns[i].GetPointOnLine2().y,
+			turns[i].GetApproachSide() ? 1 : 0
+		};
+	}
+	return count;
+}
+
+float* Linker::ToArray(const std::vector<float>& unpacked)
+{
 	float* data = new float[unpacked.size()];
 	std::copy(unpacked.begin(), unpacked.end(), data);
 	return data;
-}
\ No newline at end of file
+}
@@ -3,12 +3,17 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include "AStar.h"
+#include "World.h"
+#include "TiledWorld.h"
+#include "ThreadPool.h"
 #include "SmoothPath.h"
+#include "NativeBuffers.h"
 
 /// <summary>
 /// Singleton Linker class containing functionality
-/// to perform obstacle pathing.
+/// to perform obstacle pathing. The static functions without a
+/// world operate on the default world of the singleton, utilizing a
+/// search context per calling thread.
 /// </summary>
 class Linker
 {
@@ -26,6 +31,12 @@ public:
 		return instance;
 	}
 
+	/// <summary>
+	/// Retrieves the default world of the linker.
+	/// </summary>
+	/// <returns>The default world</returns>
+	static World& GetWorld() { return Get().m_world; }
+
 	/// <summary>
 	/// Destroys the linker.
 	/// </summary>
@@ -40,7 +51,7 @@ public:
 	/// <param name="worldOffset">The world offset</param>
 	static void SetUp(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset)
 	{
-		Get().SetUpImpl(gridSize, minPenalty, maxPenalty, worldOffset);
+		Get().m_world.SetUp(gridSize, minPenalty, maxPenalty, worldOffset);
 	}
 
 	/// <summary>
@@ -48,7 +59,7 @@ public:
 	/// </summary>
 	static void ClearGrid()
 	{
-		Get().ClearGridImpl();
+		Get().m_world.Clear();
 	}
 
 	/// <summary>
@@ -61,7 +72,7 @@ public:
 	/// <param name="movementPenalty">The points movement penalty</param>
 	static void AddGridPoint(Vec3 coordinate, Vec2 gridCoord, bool walkable, int movementPenalty)
 	{
-		Get().AddGridPointImpl(coordinate, gridCoord, walkable, movementPenalty);
+		Get().m_world.AddGridPoint(PathPoint(coordinate, gridCoord, walkable, movementPenalty));
 	}
 
 	/// <summary>
@@ -71,7 +82,7 @@ public:
 	/// <param name="d1">The dimensions of the collection</param>
 	static void AddGridPoints(float* points, int d1)
 	{
-		Get().AddGridPointsImpl(points, d1);
+		Get().m_world.AddGridPoints(points, d1);
 	}
 	
 	/// <summary>
@@ -81,7 +92,7 @@ public:
 	/// <returns>The collection of float values making up the closest point</returns>
 	static float* GetGridPoint(Vec3 coordinate)
 	{
-		return Get().GetGridPointImpl(coordinate);
+		return ConvertGridPoint(Get().m_world.GetGridPoint(coordinate));
 	}
 
 	/// <summary>
@@ -92,7 +103,7 @@ public:
 	/// <returns>The collection of float values making up the closest point</returns>
 	static float* GetGridPoint(unsigned int xGrid, unsigned int yGrid)
 	{
-		return Get().GetGridPointImpl(xGrid, yGrid);
+		return GetGridPoint(Get().m_world, xGrid, yGrid);
 	}
 	
 	/// <summary>
@@ -102,7 +113,66 @@ public:
 	/// <returns>The collection of floats representing the neartest neighbor points</returns>
 	static float* GetNearestNeighbor(Vec3 coordinate)
 	{
-		return Get().GetNearestNeighborImpl(coordinate);
+		return ConvertToFloatArray(Get().m_world.GetNearestNeighbors(coordinate));
+	}
+
+	/// <summary>
+	/// Writing the grid point closest to the passed coordinate into the passed struct.
+	/// </summary>
+	/// <param name="coordinate">The coordinate</param>
+	/// <param name="point">The struct to write into</param>
+	static void GetGridPoint(Vec3 coordinate, NativeGridPoint* point)
+	{
+		WriteGridPoint(Get().m_world.GetGridPoint(coordinate), point);
+	}
+
+	/// <summary>
+	/// Writing the grid point of the passed world at the passed grid coordinates into the passed struct.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="xGrid">The x grid coordinate</param>
+	/// <param name="yGrid">The y grid coordinate</param>
+	/// <param name="point">The struct to write into</param>
+	static void GetGridPoint(World& world, unsigned int xGrid, unsigned int yGrid, NativeGridPoint* point)
+	{
+		WriteGridPoint(world.GetGridPoint(xGrid, yGrid), point);
+	}
+
+	/// <summary>
+	/// Finding the shortest path from the start to the end coordinates,
+	/// written into the passed caller-owned buffer.
+	/// </summary>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <param name="info">The struct to write the bound and partial flag of the path into (null - skipped)</param>
+	/// <param name="buffer">The buffer to write the waypoints into</param>
+	/// <param name="capacity">The number of waypoints the buffer holds</param>
+	/// <returns>The number of waypoints, nothing written if it exceeds the capacity</returns>
+	static int FindPath(Vec3 start, Vec3 end, int flags, const SearchOptions& options, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
+	{
+		return FindPath(Get().m_world, LocalContext(), start, end, flags, options, info, buffer, capacity);
+	}
+
+	/// <summary>
+	/// Finding the smoothed shortest path from the start to the end coordinates,
+	/// written into the passed caller-owned buffer.
+	/// </summary>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="turnDist">The turn distance</param>
+	/// <param name="stopDist">The stopping distance</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <param name="info">The struct to write the indices, bound and partial flag of the path into</param>
+	/// <param name="buffer">The buffer to write the turn points into</param>
+	/// <param name="capacity">The number of turn points the buffer holds</param>
+	/// <returns>The number of turn points, nothing written if it exceeds the capacity</returns>
+	static int FindSmoothPath(Vec3 start, Vec3 end, float turnDist, float stopDist, int flags, const SearchOptions& options,
+							  NativePathInfo* info, NativeTurnPoint* buffer, int capacity)
+	{
+		return FindSmoothPath(Get().m_world, LocalContext(), start, end, turnDist, stopDist, flags, options, info, buffer, capacity);
 	}
 
 	/// <summary>
@@ -113,10 +183,56 @@ public:
 	/// <param name="smooth">Whether to smooth the path</param>
 	/// <param name="turnDist">The turn distance (for smoothing)</param>
 	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <param name="partial">Whether to return the partial path once a budget runs out, otherwise none</param>
 	/// <returns>A collection of float values representing the path</returns>
-	static float* FindPath(Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist)
+	static float* FindPath(Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist, int flags = SEARCH_DEFAULT,
+						   const SearchOptions& options = SearchOptions(), bool partial = false)
+	{
+		return FindPath(Get().m_world, LocalContext(), start, end, smooth, turnDist, stopDist, flags, options, partial);
+	}
+
+	/// <summary>
+	/// Retrieves the suboptimality bound of the last path found by the calling thread.
+	/// </summary>
+	/// <returns>The last path costs at most this many times the cheapest one</returns>
+	static float GetSearchBound()
+	{
+		return LocalContext().bound;
+	}
+
+	/// <summary>
+	/// Determines whether the last path found by the calling thread was cut short by a budget.
+	/// </summary>
+	/// <returns>Whether the last path only leads to the cell closest to the target</returns>
+	static bool GetSearchPartial()
+	{
+		return LocalContext().partial;
+	}
+
+	/// <summary>
+	/// Finding the shortest paths of a batch of requests, spread across the worker pool.
+	/// </summary>
+	/// <param name="requests">The start and end coordinates of every request (6 values per request)</param>
+	/// <param name="count">The number of requests</param>
+	/// <param name="smooth">Whether to smooth the paths</param>
+	/// <param name="turnDist">The turn distance (for smoothing)</param>
+	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <returns>A collection of float values representing the paths</returns>
+	static float* FindPaths(const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags = SEARCH_DEFAULT)
+	{
+		return FindPaths(Get().m_world, requests, count, smooth, turnDist, stopDist, flags);
+	}
+
+	/// <summary>
+	/// Selecting the open list implementation utilized by path finding.
+	/// </summary>
+	/// <param name="type">The open list implementation</param>
+	static void SetOpenList(OpenList type)
 	{
-		return Get().FindPathImpl(start, end, smooth, turnDist, stopDist);
+		Get().m_world.SetOpenList(type);
 	}
 
 	/// <summary>
@@ -126,7 +242,16 @@ public:
 	/// <returns>Collection of int values representing the new min and max movement penalties</returns>
 	static int* BlurWeights(int size)
 	{
-		return Get().BlurWeightsImpl(size);
+		return BlurWeights(Get().m_world, size);
+	}
+
+	/// <summary>
+	/// Re-blurring the weights around the cells edited since the last blur.
+	/// </summary>
+	/// <returns>Collection of int values representing the new min and max movement penalties</returns>
+	static int* ReblurWeights()
+	{
+		return ReblurWeights(Get().m_world);
 	}
 
 	/// <summary>
@@ -135,7 +260,7 @@ public:
 	/// <returns>The collection of float representing the grid</returns>
 	static float* Export()
 	{
-		return Get().ExportImpl();
+		return Export(Get().m_world);
 	}
 
 	/// <summary>
@@ -145,140 +270,348 @@ public:
 	/// <param name="d1">The dimension of the collection</param>
 	static void Import(float* points, int d1)
 	{
-		return Get().ImportImpl(points, d1);
+		Get().m_world.Import(points, d1);
 	}
 
-private:
-	AStar astar;
+	/// <summary>
+	/// Writing a binary snapshot of the current grid into the passed buffer.
+	/// </summary>
+	/// <param name="buffer">The buffer, left untouched if null or too small</param>
+	/// <param name="capacity">The number of bytes the buffer holds</param>
+	/// <returns>The number of bytes of the snapshot</returns>
+	static int ExportSnapshot(uint8_t* buffer, int capacity)
+	{
+		return ExportSnapshot(Get().m_world, buffer, capacity);
+	}
 
 	/// <summary>
-	/// Initializes a new instance of the <see cref="Linker"/> class.
+	/// Initializing the grid from the passed binary snapshot.
 	/// </summary>
-	Linker();
+	/// <param name="data">The snapshot bytes</param>
+	/// <param name="size">The number of bytes</param>
+	/// <returns>Whether the snapshot was valid and loaded</returns>
+	static bool ImportSnapshot(const uint8_t* data, int size)
+	{
+		return ImportSnapshot(Get().m_world, data, size);
+	}
 
 	/// <summary>
-	/// Implements the destroy method.
+	/// Saving a binary snapshot of the current grid to the passed file.
 	/// </summary>
-	void DestroyImpl();
+	/// <param name="path">The file path</param>
+	/// <returns>Whether the file was written</returns>
+	static bool SaveSnapshot(const char* path)
+	{
+		return SaveSnapshot(Get().m_world, path);
+	}
 
 	/// <summary>
-	/// Implements the Setup method. Setting up the astar with the 
-	/// passed variables.
+	/// Initializing the grid from the binary snapshot in the passed file.
 	/// </summary>
-	/// <param name="gridSize">The grid size</param>
-	/// <param name="minPenalty">The minimum movement penalty</param>
-	/// <param name="maxPenalty">The maximum movement penalty</param>
-	/// <param name="worldOffset">The world offset</param>
-	void SetUpImpl(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset);
-	
+	/// <param name="path">The file path</param>
+	/// <returns>Whether the file held a valid snapshot and it was loaded</returns>
+	static bool LoadSnapshot(const char* path)
+	{
+		return LoadSnapshot(Get().m_world, path);
+	}
+
 	/// <summary>
-	/// Implements the clear grid method. Clearing the grid.
+	/// Retrieving the grid point of the passed world at the passed grid coordinates
 	/// </summary>
-	void ClearGridImpl();
+	/// <param name="world">The world</param>
+	/// <param name="xGrid">The x grid coordinate</param>
+	/// <param name="yGrid">The x grid coordinate</param>
+	/// <returns>The collection of float values making up the closest point</returns>
+	static float* GetGridPoint(World& world, unsigned int xGrid, unsigned int yGrid)
+	{
+		return ConvertGridPoint(world.GetGridPoint(xGrid, yGrid));
+	}
 
 	/// <summary>
-	/// Implements the add grid point method. Adding the grid to the grid
-	/// with the passed variables.
+	/// Finding the shortest path within the passed world from the start to the end coordinates.
 	/// </summary>
-	/// <param name="coordinate">The point world coordinate</param>
-	/// <param name="gridCoord">The point grid coordiante</param>
-	/// <param name="walkable">Whether the point is walkable</param>
-	/// <param name="movementPenalty">The points movement penalty</param>
-	void AddGridPointImpl(Vec3 coordinate, Vec2 gridCoord, bool walkable, int movementPenalty);
-	
+	/// <param name="world">The world</param>
+	/// <param name="context">The search context owned by the calling thread</param>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="smooth">Whether to smooth the path</param>
+	/// <param name="turnDist">The turn distance (for smoothing)</param>
+	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <param name="partial">Whether to return the partial path once a budget runs out, otherwise none</param>
+	/// <returns>A collection of float values representing the path</returns>
+	static float* FindPath(World& world, SearchContext& context, Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist, int flags,
+						   const SearchOptions& options = SearchOptions(), bool partial = false);
+
 	/// <summary>
-	/// Implements the add grid points method. Adding the collection of points
-	/// to the grid.
+	/// Finding the shortest path within the passed world from the start to the end
+	/// coordinates, written into the passed caller-owned buffer.
 	/// </summary>
-	/// <param name="points">The collection of points to add</param>
-	/// <param name="d1">The dimensions of the collection</param>
-	void AddGridPointsImpl(float* points, int d1);
+	/// <param name="world">The world</param>
+	/// <param name="context">The search context owned by the calling thread</param>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <param name="info">The struct to write the bound and partial flag of the path into (null - skipped)</param>
+	/// <param name="buffer">The buffer to write the waypoints into</param>
+	/// <param name="capacity">The number of waypoints the buffer holds</param>
+	/// <returns>The number of waypoints, nothing written if it exceeds the capacity</returns>
+	static int FindPath(World& world, SearchContext& context, Vec3 start, Vec3 end, int flags, const SearchOptions& options, NativePathInfo* info, NativeWaypoint* buffer, int capacity);
 
 	/// <summary>
-	/// Implements the get grid point method. Retrieving the grid point
-	/// closest to the passed coordinate.
+	/// Finding the shortest path within the passed tiled world from the start to the end coordinates.
 	/// </summary>
-	/// <param name="coordinate">The coordinate</param>
-	/// <returns>The collection of float values making up the closest point</returns>
-	float* GetGridPointImpl(Vec3 coordinate);
-	
+	/// <param name="world">The tiled world</param>
+	/// <param name="context">The tiled search context owned by the calling thread</param>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="smooth">Whether to smooth the path</param>
+	/// <param name="turnDist">The turn distance (for smoothing)</param>
+	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <param name="options">The budgets of the search</param>
+	/// <returns>A collection of float values representing the path</returns>
+	static float* FindPath(TiledWorld& world, TiledContext& context, Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist, const SearchOptions& options = SearchOptions());
+
 	/// <summary>
-	/// Implements the get grid point method. Retrieving the grid point
-	/// at the passed grid coordinates
+	/// Finding the shortest path within the passed tiled world from the start to the
+	/// end coordinates, written into the passed caller-owned buffer.
 	/// </summary>
-	/// <param name="xGrid">The x grid coordinate</param>
-	/// <param name="yGrid">The x grid coordinate</param>
-	/// <returns>The collection of float values making up the closest point</returns>
-	float* GetGridPointImpl(unsigned int xGrid, unsigned int yGrid);
-	
+	/// <param name="world">The tiled world</param>
+	/// <param name="context">The tiled search context owned by the calling thread</param>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="options">The budgets of the search</param>
+	/// <param name="info">The struct to write the bound and partial flag of the path into (null - skipped)</param>
+	/// <param name="buffer">The buffer to write the waypoints into</param>
+	/// <param name="capacity">The number of waypoints the buffer holds</param>
+	/// <returns>The number of waypoints, nothing written if it exceeds the capacity</returns>
+	static int FindPath(TiledWorld& world, TiledContext& context, Vec3 start, Vec3 end, const SearchOptions& options, NativePathInfo* info, NativeWaypoint* buffer, int capacity);
+
 	/// <summary>
-	/// Implements the get neartest neighbor method. Retrieving the nearest
-	/// neighbors to the passed coordinate.
+	/// Finding the smoothed shortest path within the passed world from the start to
+	/// the end coordinates, written into the passed caller-owned buffer.
 	/// </summary>
-	/// <param name="coordinate">The world coordinate</param>
-	/// <returns>The collection of floats representing the neartest neighbor points</returns>
-	float* GetNearestNeighborImpl(Vec3 coordinate);
+	/// <param name="world">The world</param>
+	/// <param name="context">The search context owned by the calling thread</param>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="end">The end coordinate</param>
+	/// <param name="turnDist">The turn distance</param>
+	/// <param name="stopDist">The stopping distance</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <param name="info">The struct to write the indices, bound and partial flag of the path into</param>
+	/// <param name="buffer">The buffer to write the turn points into</param>
+	/// <param name="capacity">The number of turn points the buffer holds</param>
+	/// <returns>The number of turn points, nothing written if it exceeds the capacity</returns>
+	static int FindSmoothPath(World& world, SearchContext& context, Vec3 start, Vec3 end, float turnDist, float stopDist, int flags, const SearchOptions& options,
+							  NativePathInfo* info, NativeTurnPoint* buffer, int capacity);
 
 	/// <summary>
-	/// Implements the find path method. Finding the shortest path from 
-	/// the start to the end coordinates.
+	/// Finding the shortest path within the passed world from the start to the end
+	/// coordinates, repairing the previous search of the passed incremental planner.
 	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="planner">The incremental planner of the agent</param>
 	/// <param name="start">The start coordinate</param>
 	/// <param name="end">The end coordinate</param>
 	/// <param name="smooth">Whether to smooth the path</param>
 	/// <param name="turnDist">The turn distance (for smoothing)</param>
 	/// <param name="stopDist">The stopping distance (for smoothing)</param>
 	/// <returns>A collection of float values representing the path</returns>
-	float* FindPathImpl(Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist);
-	
+	static float* FindPath(World& world, IncrementalPlanner& planner, Vec3 start, Vec3 end, bool smooth, float turnDist, float stopDist);
+
+	/// <summary>
+	/// Retrieving the path found by the passed search within the passed world,
+	/// or the path towards the target found so far while it is still running.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="search">The started search</param>
+	/// <param name="smooth">Whether to smooth the path</param>
+	/// <param name="turnDist">The turn distance (for smoothing)</param>
+	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <returns>A collection of float values representing the path</returns>
+	static float* GetSearchResult(World& world, SteppedSearch& search, bool smooth, float turnDist, float stopDist);
+
+	/// <summary>
+	/// Finding the shortest paths of a batch of requests within the passed world,
+	/// spread across the worker pool. The result holds the total size, the request
+	/// count and the offset of every path, followed by the paths - each packed
+	/// exactly like the result of a single path query. A request running out of
+	/// the default budget receives no path.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="requests">The start and end coordinates of every request (6 values per request)</param>
+	/// <param name="count">The number of requests</param>
+	/// <param name="smooth">Whether to smooth the paths</param>
+	/// <param name="turnDist">The turn distance (for smoothing)</param>
+	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <returns>A collection of float values representing the paths</returns>
+	static float* FindPaths(World& world, const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags);
+
 	/// <summary>
-	/// Implements the blur weights method. Blurring the weights.
+	/// Blurring the weights of the passed world.
 	/// </summary>
+	/// <param name="world">The world</param>
 	/// <param name="size">The blurring window size</param>
 	/// <returns>Collection of int values representing the new min and max movement penalties</returns>
-	int* const BlurWeightsImpl(int size);
+	static int* BlurWeights(World& world, int size);
+
+	/// <summary>
+	/// Re-blurring the weights of the passed world around the cells edited since the last blur.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <returns>Collection of int values representing the new min and max movement penalties</returns>
+	static int* ReblurWeights(World& world);
 
 	/// <summary>
-	/// Implements the export method. Exporting the current grid state.
+	/// Exporting the grid state of the passed world.
 	/// </summary>
+	/// <param name="world">The world</param>
 	/// <returns>The collection of float representing the grid</returns>
-	float* ExportImpl();
-	
+	static float* Export(World& world);
+
 	/// <summary>
-	/// Implement the import method. Initializing the grid with the passed values.
+	/// Writing a binary snapshot of the grid of the passed world into the passed buffer.
 	/// </summary>
-	/// <param name="points">The collection of values making up the grid</param>
-	/// <param name="d1">The dimension of the collection</param>
-	void ImportImpl(float* points, int d1);
+	/// <param name="world">The world</param>
+	/// <param name="buffer">The buffer, left untouched if null or too small</param>
+	/// <param name="capacity">The number of bytes the buffer holds</param>
+	/// <returns>The number of bytes of the snapshot</returns>
+	static int ExportSnapshot(World& world, uint8_t* buffer, int capacity);
+
+	/// <summary>
+	/// Initializing the grid of the passed world from the passed binary snapshot.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="data">The snapshot bytes</param>
+	/// <param name="size">The number of bytes</param>
+	/// <returns>Whether the snapshot was valid and loaded</returns>
+	static bool ImportSnapshot(World& world, const uint8_t* data, int size);
+
+	/// <summary>
+	/// Saving a binary snapshot of the grid of the passed world to the passed file.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="path">The file path</param>
+	/// <returns>Whether the file was written</returns>
+	static bool SaveSnapshot(World& world, const char* path);
+
+	/// <summary>
+	/// Initializing the grid of the passed world from the binary snapshot in the passed file.
+	/// </summary>
+	/// <param name="world">The world</param>
+	/// <param name="path">The file path</param>
+	/// <returns>Whether the file held a valid snapshot and it was loaded</returns>
+	static bool LoadSnapshot(World& world, const char* path);
 
 private:
+	World m_world;
+	std::unique_ptr<ThreadPool> m_pool;
+	std::mutex m_poolLock;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Linker"/> class.
+	/// </summary>
+	Linker();
+
+	/// <summary>
+	/// Implements the destroy method.
+	/// </summary>
+	void DestroyImpl();
+
+	/// <summary>
+	/// Retrieves the search context of the calling thread, utilized
+	/// by path queries against the default world.
+	/// </summary>
+	/// <returns>The search context of the calling thread</returns>
+	static SearchContext& LocalContext();
+
+	/// <summary>
+	/// Retrieves the worker pool executing batched queries, starting it on first use.
+	/// </summary>
+	/// <returns>The worker pool</returns>
+	ThreadPool& Pool();
+
+private:
+
+	/// <summary>
+	/// Unpacks the path into a collection of float values, smoothing it
+	/// if requested.
+	/// </summary>
+	/// <param name="points">The path waypoints</param>
+	/// <param name="start">The start coordinate</param>
+	/// <param name="smooth">Whether to smooth the path</param>
+	/// <param name="turnDist">The turn distance (for smoothing)</param>
+	/// <param name="stopDist">The stopping distance (for smoothing)</param>
+	/// <param name="unpacked">The collection of float values to append to</param>
+	static void UnpackPath(const std::vector<Vec3>& points, Vec3 start, bool smooth, float turnDist, float stopDist, std::vector<float>& unpacked);
 
 	/// <summary>
 	/// Unpacks the smooth path into a collection of float values, 
 	/// representing the smooth path.
 	/// </summary>
 	/// <param name="path">The path to convert</param>
-	/// <returns>A collection of float values representing the path</returns>
-	float* UnpackSmoothPath(const SmoothPath& path);
+	/// <param name="unpacked">The collection of float values to append to</param>
+	static void UnpackSmoothPath(const SmoothPath& path, std::vector<float>& unpacked);
 	
 	/// <summary>
 	/// Converting the passed grid point to a collection of float values.
 	/// </summary>
 	/// <param name="point">The point to convert</param>
 	/// <returns>The collection of float values making up the closest point</returns>
-	float* ConvertGridPoint(const PathPoint& point);
+	static float* ConvertGridPoint(const PathPoint& point);
 	
 	/// <summary>
 	/// Converts a collecion of path points into a collection of float values.
 	/// </summary>
 	/// <param name="points">The collection path points</param>
 	/// <returns>The collection of float values making up the path point collection</returns>
-	float* ConvertToFloatArray(const std::vector<PathPoint>& points);
+	static float* ConvertToFloatArray(const std::vector<PathPoint>& points);
 	
 	/// <summary>
-	/// Converts a collection of vertices into a collection of float values.
+	/// Unpacks a collection of vertices into a collection of float values.
 	/// </summary>
 	/// <param name="vertices">The collection of vertices</param>
-	/// <returns>The collection of float values making up the collection of vertices</returns>
-	float* ConvertToFloatArray(const std::vector<Vec3>& vertices);
+	/// <param name="unpacked">The collection of float values to append to</param>
+	static void UnpackVertices(const std::vector<Vec3>& vertices, std::vector<float>& unpacked);
+
+	/// <summary>
+	/// Writes the passed grid point into the passed struct.
+	/// </summary>
+	/// <param name="point">The point to write</param>
+	/// <param name="written">The struct to write into</param>
+	static void WriteGridPoint(const PathPoint& point, NativeGridPoint* written);
+
+	/// <summary>
+	/// Writes a collection of vertices into a caller-owned buffer.
+	/// </summary>
+	/// <param name="vertices">The collection of vertices</param>
+	/// <param name="bound">The bound of the search that found the path</param>
+	/// <param name="partial">Whether a budget of the search ran out</param>
+	/// <param name="info">The struct to write the bound and partial flag of the path into</param>
+	/// <param name="buffer">The buffer to write into</param>
+	/// <param name="capacity">The number of waypoints the buffer holds</param>
+	/// <returns>The number of vertices, nothing written if it exceeds the capacity</returns>
+	static int WriteVertices(const std::vector<Vec3>& vertices, float bound, bool partial, NativePathInfo* info, NativeWaypoint* buffer, int capacity);
+
+	/// <summary>
+	/// Writes the smooth path into a caller-owned buffer.
+	/// </summary>
+	/// <param name="path">The path to write</param>
+	/// <param name="context">The search context that found the path</param>
+	/// <param name="info">The struct to write the indices, bound and partial flag of the path into</param>
+	/// <param name="buffer">The buffer to write into</param>
+	/// <param name="capacity">The number of turn points the buffer holds</param>
+	/// <returns>The number of turn points, nothing written if it exceeds the capacity</returns>
+	static int WriteSmoothPath(const SmoothPath& path, const SearchContext& context, NativePathInfo* info, NativeTurnPoint* buffer, int capacity);
+
+	/// <summary>
+	/// Copies the collection of float values into an array released by the caller.
+	/// </summary>
+	/// <param name="unpacked">The collection of float values</param>
+	/// <returns>The array of float values</returns>
+	static float* ToArray(const std::vector<float>& unpacked);
 };
\ No newline at end of file
@@ -1,17 +1,21 @@
 #pragma once
 
 #include "pch.h"
+#include "MatrixLayout.h"
 
 /// <summary>
 /// Class representing a dynamic matrix containing
-/// templated objects.
+/// templated objects. Elements are addressed by row and column or by the
+/// flattened index (row + col * width) whatever order the layout stores them in.
 /// </summary>
 /// <typeparam name="T">The type of objects</typeparam>
-template<typename T>
+/// <typeparam name="Layout">The storage order of the elements</typeparam>
+template<typename T, typename Layout = GRID_LAYOUT>
 class Matrix
 {
 private:
 	size_t m_width, m_height;
+	Layout m_layout;
 	std::vector<T> m_data;
 public:
 
@@ -21,10 +25,11 @@ public:
 	/// <param name="width">The width of the matrix</param>
 	/// <param name="height">The height of the matrix</param>
 	Matrix(size_t width, size_t height)
-		: m_width(width), m_height(height), m_data(std::vector<T>())
+		: m_width(width), m_height(height), m_layout(width, height), m_data(std::vector<T>())
 	{
-		m_data.reserve(width * height);
-		for (int i = 0; i < width * height; i++)
+		size_t capacity = m_layout.Capacity(height);
+		m_data.reserve(capacity);
+		for (size_t i = 0; i < capacity; i++)
 		{
 			m_data.emplace_back(T());
 		}
@@ -34,13 +39,19 @@ public:
 	/// Retrieves the width of the matrix.
 	/// </summary>
 	/// <returns>The width of the matrix</returns>
-	const size_t const GetWidth() { return m_width; }
+	const size_t GetWidth() { return m_width; }
 
 	/// <summary>
 	/// Retrieves the height of the matrix.
 	/// </summary>
 	/// <returns>The height of the matrix</returns>
-	const size_t const GetHeight() { return m_height; }
+	const size_t GetHeight() { return m_height; }
+
+	/// <summary>
+	/// Retrieves the number of elements within the matrix.
+	/// </summary>
+	/// <returns>The number of elements</returns>
+	const size_t GetSize() { return m_width * m_height; }
 
 	/// <summary>
 	/// Retrieves the element within the matrix at the passed
@@ -51,9 +62,68 @@ public:
 	/// <returns>The reference to the element at the index</returns>
 	T& operator()(const size_t row, const size_t col)
 	{
-		return m_data[row + (col * m_width)];
+		return m_data[m_layout.Offset(row, col)];
+	}
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed
+	/// flattened index (row + col * width).
+	/// </summary>
+	/// <param name="index">The flattened index</param>
+	/// <returns>The reference to the element at the index</returns>
+	T& operator[](const size_t index)
+	{
+		return m_data[m_layout.Offset(index)];
+	}
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed
+	/// row and column index for reading.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The reference to the element at the index</returns>
+	const T& Get(const size_t row, const size_t col) const
+	{
+		return m_data[m_layout.Offset(row, col)];
+	}
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed
+	/// flattened index (row + col * width) for reading.
+	/// </summary>
+	/// <param name="index">The flattened index</param>
+	/// <returns>The reference to the element at the index</returns>
+	const T& Get(const size_t index) const
+	{
+		return m_data[m_layout.Offset(index)];
 	}
 
+	/// <summary>
+	/// Sets the element within the matrix at the passed row and column index.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <param name="value">The element</param>
+	void Set(const size_t row, const size_t col, const T& value)
+	{
+		m_data[m_layout.Offset(row, col)] = value;
+	}
+
+	/// <summary>
+	/// Sets the element read back from cells never written, ignored
+	/// as every cell of a dense matrix is stored.
+	/// </summary>
+	/// <param name="value">The empty element (unused)</param>
+	/// <returns>Whether the empty element was taken over</returns>
+	const bool SetEmpty(const T&) { return false; }
+
+	/// <summary>
+	/// Retrieves the number of elements held in memory, padding included.
+	/// </summary>
+	/// <returns>The number of stored elements</returns>
+	const size_t GetStored() const { return m_data.size(); }
+
 	/// <summary>
 	/// Overloads the stream operator retrieving the matrix's string.
 	/// </summary>
@@ -65,4 +135,194 @@ public:
 		stream << "Matrix of Row: " << other.m_width << " Column: " << other.m_height << std::endl;
 		return stream;
 	}
-};
\ No newline at end of file
+};
+
+/// <summary>
+/// Struct deciding which elements a sparse <see cref="Matrix"/> may leave
+/// to its empty element instead of storing them. By default only elements
+/// equal to the empty element are left out.
+/// </summary>
+/// <typeparam name="T">The type of elements</typeparam>
+template<typename T>
+struct SparseCell
+{
+	/// <summary>
+	/// Determines whether the passed element reads the same as the empty element.
+	/// </summary>
+	/// <param name="value">The element written</param>
+	/// <param name="empty">The empty element</param>
+	/// <returns>Whether the element need not be stored</returns>
+	static const bool IsEmpty(const T& value, const T& empty) { return value == empty; }
+};
+
+/// <summary>
+/// Class representing a block-sparse matrix containing templated objects.
+/// Blocks are allocated the first time an element within them is accessed
+/// for writing, every cell of a block never stored reads as the empty
+/// element. Reading through <see cref="Get"/> never allocates, while the
+/// mutable accessors store the block they reach - like a map - so callers
+/// that only read, and readers running concurrently, go through <see cref="Get"/>.
+/// </summary>
+/// <typeparam name="T">The type of objects</typeparam>
+/// <typeparam name="Shift">The log2 of the cells per block side</typeparam>
+template<typename T, int Shift>
+class Matrix<T, SparseLayout<Shift>>
+{
+private:
+	size_t m_width, m_height;
+	SparseLayout<Shift> m_layout;
+	std::vector<std::unique_ptr<T[]>> m_blocks;
+	size_t m_stored;
+	T m_empty;
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Matrix"/> class
+	/// without any stored blocks.
+	/// </summary>
+	/// <param name="width">The width of the matrix</param>
+	/// <param name="height">The height of the matrix</param>
+	Matrix(size_t width, size_t height)
+		: m_width(width), m_height(height), m_layout(width, height), m_blocks(m_layout.Blocks()), m_stored(0), m_empty(T())
+	{
+	}
+
+	Matrix(const Matrix& other)
+		: m_width(other.m_width), m_height(other.m_height), m_layout(other.m_layout),
+			m_blocks(other.m_blocks.size()), m_stored(other.m_stored), m_empty(other.m_empty)
+	{
+		for (size_t block = 0; block < m_blocks.size(); block++)
+		{
+			if (!other.m_blocks[block]) { continue; }
+			m_blocks[block].reset(new T[SparseLayout<Shift>::BlockCells()]);
+			std::copy(other.m_blocks[block].get(), other.m_blocks[block].get() + SparseLayout<Shift>::BlockCells(), m_blocks[block].get());
+		}
+	}
+
+	Matrix(Matrix&& other) = default;
+
+	Matrix& operator=(const Matrix& other)
+	{
+		Matrix copy(other);
+		return *this = std::move(copy);
+	}
+
+	Matrix& operator=(Matrix&& other) = default;
+
+	/// <summary>
+	/// Retrieves the width of the matrix.
+	/// </summary>
+	/// <returns>The width of the matrix</returns>
+	const size_t GetWidth() const { return m_width; }
+
+	/// <summary>
+	/// Retrieves the height of the matrix.
+	/// </summary>
+	/// <returns>The height of the matrix</returns>
+	const size_t GetHeight() const { return m_height; }
+
+	/// <summary>
+	/// Retrieves the number of elements within the matrix.
+	/// </summary>
+	/// <returns>The number of elements</returns>
+	const size_t GetSize() const { return m_width * m_height; }
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed
+	/// row and column index, storing its block if needed.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The reference to the element at the index</returns>
+	T& operator()(const size_t row, const size_t col)
+	{
+		std::unique_ptr<T[]>& block = m_blocks[m_layout.Block(row, col)];
+		if (!block)
+		{
+			block.reset(new T[SparseLayout<Shift>::BlockCells()]);
+			std::fill(block.get(), block.get() + SparseLayout<Shift>::BlockCells(), m_empty);
+			m_stored++;
+		}
+		return block[m_layout.Cell(row, col)];
+	}
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed flattened
+	/// index (row + col * width), storing its block if needed.
+	/// </summary>
+	/// <param name="index">The flattened index</param>
+	/// <returns>The reference to the element at the index</returns>
+	T& operator[](const size_t index)
+	{
+		return (*this)(index % m_width, index / m_width);
+	}
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed
+	/// row and column index for reading.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The reference to the element, the empty element within blocks never stored</returns>
+	const T& Get(const size_t row, const size_t col) const
+	{
+		const std::unique_ptr<T[]>& block = m_blocks[m_layout.Block(row, col)];
+		return block ? block[m_layout.Cell(row, col)] : m_empty;
+	}
+
+	/// <summary>
+	/// Retrieves the element within the matrix at the passed
+	/// flattened index (row + col * width) for reading.
+	/// </summary>
+	/// <param name="index">The flattened index</param>
+	/// <returns>The reference to the element, the empty element within blocks never stored</returns>
+	const T& Get(const size_t index) const
+	{
+		return Get(index % m_width, index / m_width);
+	}
+
+	/// <summary>
+	/// Sets the element within the matrix at the passed row and column
+	/// index. Elements reading as the empty element are not stored.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <param name="value">The element</param>
+	void Set(const size_t row, const size_t col, const T& value)
+	{
+		if (!m_blocks[m_layout.Block(row, col)] && SparseCell<T>::IsEmpty(value, m_empty)) { return; }
+		(*this)(row, col) = value;
+	}
+
+	/// <summary>
+	/// Sets the element read back from cells never written, only
+	/// taken over while no block is stored yet.
+	/// </summary>
+	/// <param name="value">The empty element</param>
+	/// <returns>Whether the empty element was taken over</returns>
+	const bool SetEmpty(const T& value)
+	{
+		if (m_stored > 0) { return false; }
+		m_empty = value;
+		return true;
+	}
+
+	/// <summary>
+	/// Retrieves the number of elements held in memory, padding included.
+	/// </summary>
+	/// <returns>The number of stored elements</returns>
+	const size_t GetStored() const { return m_stored * SparseLayout<Shift>::BlockCells(); }
+
+	/// <summary>
+	/// Overloads the stream operator retrieving the matrix's string.
+	/// </summary>
+	/// <param name="stream">The stream to append to</param>
+	/// <param name="other">The matrix to convert</param>
+	/// <returns>The modified stream</returns>
+	friend std::ostream& operator<<(std::ostream& stream, const Matrix& other)
+	{
+		stream << "Sparse Matrix of Row: " << other.m_width << " Column: " << other.m_height
+			   << " Blocks: " << other.m_stored << "/" << other.m_blocks.size() << std::endl;
+		return stream;
+	}
+};
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "pch.h"
+
+/// <summary>
+/// Struct representing the row-major layout of a <see cref="Matrix"/>, every
+/// row of the grid stored after the previous one (row + col * width).
+/// </summary>
+struct RowMajorLayout
+{
+	size_t width;
+
+	RowMajorLayout(size_t _width, size_t) : width(_width) { }
+
+	/// <summary>
+	/// Retrieves the number of elements to allocate.
+	/// </summary>
+	/// <param name="height">The height of the matrix</param>
+	/// <returns>The number of elements</returns>
+	inline const size_t Capacity(size_t height) const { return width * height; }
+
+	/// <summary>
+	/// Retrieves the storage offset of the passed row and column index.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The storage offset</returns>
+	inline const size_t Offset(size_t row, size_t col) const { return row + col * width; }
+
+	/// <summary>
+	/// Retrieves the storage offset of the passed flattened index (row + col * width).
+	/// </summary>
+	/// <param name="index">The flattened index</param>
+	/// <returns>The storage offset</returns>
+	inline const size_t Offset(size_t index) const { return index; }
+
+	static const char* Name() { return "RowMajor"; }
+};
+
+/// <summary>
+/// Struct representing a blocked layout of a <see cref="Matrix"/>. The grid is
+/// split into square blocks of 2^Shift cells per side, stored one after the
+/// other in row-major order with their cells row-major within them, so the
+/// 3x3 neighbourhood of a cell mostly lies within a few cache lines. The last
+/// row and column of blocks are padded.
+/// </summary>
+/// <typeparam name="Shift">The log2 of the cells per block side</typeparam>
+template<int Shift = 3>
+struct BlockedLayout
+{
+	size_t width, blocksX;
+
+	BlockedLayout(size_t _width, size_t)
+		: width(_width), blocksX((_width + (1 << Shift) - 1) >> Shift) { }
+
+	inline const size_t Capacity(size_t height) const
+	{
+		return blocksX * ((height + (1 << Shift) - 1) >> Shift) << (2 * Shift);
+	}
+
+	inline const size_t Offset(size_t row, size_t col) const
+	{
+		const size_t mask = (1 << Shift) - 1;
+		return ((((col >> Shift) * blocksX + (row >> Shift)) << (2 * Shift)) | ((col & mask) << Shift) | (row & mask));
+	}
+
+	inline const size_t Offset(size_t index) const { return Offset(index % width, index / width); }
+
+	static const char* Name() { return "Blocked"; }
+};
+
+/// <summary>
+/// Struct representing the Z-order (Morton) layout of a <see cref="Matrix"/>.
+/// The bits of the row and column index are interleaved, so cells close in
+/// both directions stay close in memory at every scale. Each side is padded
+/// to a power of two, the excess bits of the longer side placed above the
+/// interleaved ones, so at most four times the cells are allocated.
+/// </summary>
+struct MortonLayout
+{
+	size_t width;
+	int rowBits, colBits, sharedBits;
+
+	MortonLayout(size_t _width, size_t _height)
+		: width(_width), rowBits(Bits(_width)), colBits(Bits(_height)), sharedBits(std::min(Bits(_width), Bits(_height))) { }
+
+	inline const size_t Capacity(size_t) const { return (size_t)1 << (rowBits + colBits); }
+
+	inline const size_t Offset(size_t row, size_t col) const
+	{
+		const size_t mask = ((size_t)1 << sharedBits) - 1;
+		size_t interleaved = Spread(row & mask) | (Spread(col & mask) << 1);
+		return interleaved | (((row >> sharedBits) | (col >> sharedBits)) << (2 * sharedBits));
+	}
+
+	inline const size_t Offset(size_t index) const { return Offset(index % width, index / width); }
+
+	static const char* Name() { return "Morton"; }
+
+	/// <summary>
+	/// Spreads the lower 32 bits of the passed value to the even bits.
+	/// </summary>
+	/// <param name="value">The value</param>
+	/// <returns>The spread value</returns>
+	inline static const size_t Spread(uint64_t value)
+	{
+		value &= 0xFFFFFFFFull;
+		value = (value | (value << 16)) & 0x0000FFFF0000FFFFull;
+		value = (value | (value << 8)) & 0x00FF00FF00FF00FFull;
+		value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		value = (value | (value << 2)) & 0x3333333333333333ull;
+		value = (value | (value << 1)) & 0x5555555555555555ull;
+		return (size_t)value;
+	}
+
+	/// <summary>
+	/// Retrieves the bits needed to index the passed number of cells.
+	/// </summary>
+	/// <param name="size">The number of cells along a side</param>
+	/// <returns>The number of bits</returns>
+	inline static const int Bits(size_t size)
+	{
+		int bits = 0;
+		while (((size_t)1 << bits) < size) { bits++; }
+		return bits;
+	}
+};
+
+/// <summary>
+/// Struct representing the block geometry of a sparse <see cref="Matrix"/>.
+/// The grid is split into square blocks of 2^Shift cells per side, and a
+/// block is only stored once a cell other than the empty cell is written to
+/// it, so a world mostly made of void only pays for the blocks it uses.
+/// </summary>
+/// <typeparam name="Shift">The log2 of the cells per block side</typeparam>
+template<int Shift = 4>
+struct SparseLayout
+{
+	size_t width, blocksX, blocksY;
+
+	SparseLayout(size_t _width, size_t _height)
+		: width(_width), blocksX((_width + (1 << Shift) - 1) >> Shift), blocksY((_height + (1 << Shift) - 1) >> Shift) { }
+
+	/// <summary>
+	/// Retrieves the number of blocks covering the grid.
+	/// </summary>
+	/// <returns>The number of blocks</returns>
+	inline const size_t Blocks() const { return blocksX * blocksY; }
+
+	/// <summary>
+	/// Retrieves the block holding the passed row and column index.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The block index</returns>
+	inline const size_t Block(size_t row, size_t col) const { return (col >> Shift) * blocksX + (row >> Shift); }
+
+	/// <summary>
+	/// Retrieves the offset of the passed row and column index within its block.
+	/// </summary>
+	/// <param name="row">The row index</param>
+	/// <param name="col">The column index</param>
+	/// <returns>The offset within the block</returns>
+	inline const size_t Cell(size_t row, size_t col) const
+	{
+		const size_t mask = (1 << Shift) - 1;
+		return ((col & mask) << Shift) | (row & mask);
+	}
+
+	inline static const size_t BlockCells() { return (size_t)1 << (2 * Shift); }
+
+	static const char* Name() { return "Sparse"; }
+};
+
+// The layout of every matrix unless chosen explicitly, a build may define
+// it as BlockedLayout<>, MortonLayout or SparseLayout<> instead
+#ifndef GRID_LAYOUT
+#define GRID_LAYOUT RowMajorLayout
+#endif
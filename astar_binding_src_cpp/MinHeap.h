@@ -215,7 +215,7 @@ private:
 	/// </summary>
 	/// <param name="item">The item to get the parent of</param>
 	/// <returns>The parent index</returns>
-	const int Parent(HeapItem<T> item) { return (item.GetIndex() - 1) / 2.0f; }
+	const int Parent(HeapItem<T> item) { return ((int)item.GetIndex() - 1) / 2; }
 	
 	/// <summary>
 	/// Retrieves the left child index of the passed heap item.
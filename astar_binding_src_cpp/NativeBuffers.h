@@ -0,0 +1,53 @@
+#pragma once
+
+#include "pch.h"
+
+/// <summary>
+/// Struct representing a waypoint written into a caller-owned buffer.
+/// </summary>
+struct NativeWaypoint
+{
+	float x, y, z;
+};
+
+/// <summary>
+/// Struct representing a waypoint of a smoothed path and the turn boundary
+/// the agent crosses on its way to it, written into a caller-owned buffer.
+/// </summary>
+struct NativeTurnPoint
+{
+	float x, y, z;
+	float gradient;
+	float perpGradient;
+	float point1X, point1Y;
+	float point2X, point2Y;
+	int approachSide;
+};
+
+/// <summary>
+/// Struct representing the indices of a smoothed path written alongside
+/// its turn points, and how the search that found it ended. Written
+/// alongside waypoints the indices are -1.
+/// </summary>
+struct NativePathInfo
+{
+	int count;
+	int finishLineIndex;
+	int slowDownIndex;
+
+	// The path costs at most this many times the cheapest one (0 - unproven)
+	float bound;
+
+	// Whether a budget ran out, the path only leading to the cell closest to the target
+	int partial;
+};
+
+/// <summary>
+/// Struct representing a grid point written into a caller-owned buffer.
+/// </summary>
+struct NativeGridPoint
+{
+	float x, y, z;
+	int movementPenalty;
+	int walkable;
+};
@@ -0,0 +1,112 @@
+#include "pch.h"
+
+#include "PathCache.h"
+#include "AStar.h"
+
+PathCache::PathCache(size_t capacity)
+	: m_capacity(capacity), m_hits(0), m_misses(0)
+{
+}
+
+const bool PathCache::Find(AStar& astar, int start, int target, int flags, std::vector<Vec3>& waypoints, std::vector<int>& cells)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (m_capacity == 0) { return false; }
+
+	auto found = m_lookup.find({ start, target, flags });
+	if (found == m_lookup.end())
+	{
+		m_misses++;
+		return false;
+	}
+
+	// Drop the path once any tile it crosses was edited
+	std::list<Entry>::iterator entry = found->second;
+	for (const std::pair<int, unsigned int>& tile : entry->tiles)
+	{
+		if (astar.GetTileVersion(tile.first) != tile.second)
+		{
+			m_entries.erase(entry);
+			m_lookup.erase(found);
+			m_misses++;
+			return false;
+		}
+	}
+
+	m_entries.splice(m_entries.begin(), m_entries, entry);
+	waypoints = entry->waypoints;
+	cells = entry->cells;
+	m_hits++;
+	return true;
+}
+
+void PathCache::Insert(AStar& astar, int start, int target, int flags, const std::vector<Vec3>& waypoints, const std::vector<int>& cells)
+{
+	std::vector<int> tiles;
+	tiles.reserve(cells.size() + 1);
+	tiles.push_back(astar.GetTile(start));
+	for (int cell : cells)
+	{
+		tiles.push_back(astar.GetTile(cell));
+	}
+	std::sort(tiles.begin(), tiles.end());
+	tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+	Entry entry{ { start, target, flags }, waypoints, cells, {} };
+	entry.tiles.reserve(tiles.size());
+	for (int tile : tiles)
+	{
+		entry.tiles.emplace_back(tile, astar.GetTileVersion(tile));
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (m_capacity == 0) { return; }
+
+	// Another thread may have cached the same query meanwhile
+	auto found = m_lookup.find(entry.key);
+	if (found != m_lookup.end())
+	{
+		m_entries.erase(found->second);
+		m_lookup.erase(found);
+	}
+
+	m_entries.push_front(std::move(entry));
+	m_lookup[m_entries.front().key] = m_entries.begin();
+	Trim();
+}
+
+void PathCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_entries.clear();
+	m_lookup.clear();
+}
+
+void PathCache::SetCapacity(size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_capacity = capacity;
+	Trim();
+}
+
+const std::tuple<size_t, size_t, size_t> PathCache::GetStats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return std::make_tuple(m_hits, m_misses, m_entries.size());
+}
+
+void PathCache::ResetStats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_hits = 0;
+	m_misses = 0;
+}
+
+void PathCache::Trim()
+{
+	while (m_entries.size() > m_capacity)
+	{
+		m_lookup.erase(m_entries.back().key);
+		m_entries.pop_back();
+	}
+}
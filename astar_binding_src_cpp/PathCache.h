@@ -0,0 +1,130 @@
+#pragma once
+
+#include "pch.h"
+#include "Vec3.h"
+
+class AStar;
+
+// Number of paths kept by a cache unless configured otherwise
+#define DEFAULT_PATH_CACHE_CAPACITY 1024
+
+/// <summary>
+/// Class representing a bounded least recently used cache of path query
+/// results, keyed by the start cell, target cell and search flags. Every
+/// entry records the version stamps of the tiles its path crosses and is
+/// dropped once one of them changes. Edits outside those tiles keep the
+/// cached path walkable at an unchanged cost, so it is still returned even
+/// if a cheaper route opened up elsewhere. Failed queries are not cached.
+/// </summary>
+class PathCache
+{
+private:
+
+	/// <summary>
+	/// Struct representing the key of a cached path.
+	/// </summary>
+	struct Key
+	{
+		int start, target, flags;
+
+		bool operator == (const Key& other) const
+		{
+			return start == other.start && target == other.target && flags == other.flags;
+		}
+	};
+
+	/// <summary>
+	/// Struct hashing the key of a cached path.
+	/// </summary>
+	struct KeyHash
+	{
+		size_t operator () (const Key& key) const
+		{
+			size_t hash = std::hash<int>()(key.start);
+			hash = hash * 31 + std::hash<int>()(key.target);
+			return hash * 31 + std::hash<int>()(key.flags);
+		}
+	};
+
+	/// <summary>
+	/// Struct representing a cached path and the tile stamps it was found against.
+	/// </summary>
+	struct Entry
+	{
+		Key key;
+		std::vector<Vec3> waypoints;
+		std::vector<int> cells;
+		std::vector<std::pair<int, unsigned int>> tiles;
+	};
+
+	// Most recently used entries first
+	std::list<Entry> m_entries;
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_lookup;
+	size_t m_capacity;
+	size_t m_hits, m_misses;
+	std::mutex m_lock;
+
+public:
+
+	// Prevent copying, the lookup references the entries
+	PathCache(const PathCache&) = delete;
+	void operator = (const PathCache&) = delete;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="PathCache"/> class.
+	/// </summary>
+	/// <param name="capacity">The maximum number of cached paths (0 - disabled)</param>
+	PathCache(size_t capacity = DEFAULT_PATH_CACHE_CAPACITY);
+
+	/// <summary>
+	/// Looks up the path between the passed cells, counting a hit or a miss.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> of the query</param>
+	/// <param name="waypoints">The cached waypoints</param>
+	/// <param name="cells">The cached cells of the path, excluding the start</param>
+	/// <returns>Whether a current path was cached</returns>
+	const bool Find(AStar& astar, int start, int target, int flags, std::vector<Vec3>& waypoints, std::vector<int>& cells);
+
+	/// <summary>
+	/// Caches the passed path, evicting the least recently used path when full.
+	/// </summary>
+	/// <param name="astar">The astar owning the grid</param>
+	/// <param name="start">The start cell index</param>
+	/// <param name="target">The target cell index</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> of the query</param>
+	/// <param name="waypoints">The waypoints of the path</param>
+	/// <param name="cells">The cells of the path, excluding the start</param>
+	void Insert(AStar& astar, int start, int target, int flags, const std::vector<Vec3>& waypoints, const std::vector<int>& cells);
+
+	/// <summary>
+	/// Removes every cached path.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Sets the maximum number of cached paths, evicting any above it.
+	/// </summary>
+	/// <param name="capacity">The maximum number of cached paths (0 - disabled)</param>
+	void SetCapacity(size_t capacity);
+
+	/// <summary>
+	/// Retrieves the counters of the cache.
+	/// </summary>
+	/// <returns>A tuple containing the hits, misses and cached paths</returns>
+	const std::tuple<size_t, size_t, size_t> GetStats();
+
+	/// <summary>
+	/// Resets the hit and miss counters.
+	/// </summary>
+	void ResetStats();
+
+private:
+
+	/// <summary>
+	/// Evicts the least recently used paths above the capacity.
+	/// </summary>
+	void Trim();
+};
@@ -25,7 +25,7 @@ const float PathPoint::DistanceTo(const PathPoint& otherNode)
 	return ceil(m_worldCoord.DistanceTo(otherNode.GetPosition()));
 }
 
-const float PathPoint::ManhattenDistanceTo(const PathPoint& otherNode)
+const float PathPoint::ManhattenDistanceTo(const PathPoint& otherNode) const
 {
 	return ceil(m_worldCoord.ManhattenDistanceTo(otherNode.GetPosition()));
 }
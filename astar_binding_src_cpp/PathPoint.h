@@ -156,7 +156,7 @@ public:
 	/// </summary>
 	/// <param name="otherNode">The other path point to calculate to</param>
 	/// <returns>The manhatten distance between the path points</returns>
-	const float ManhattenDistanceTo(const PathPoint& otherNode);
+	const float ManhattenDistanceTo(const PathPoint& otherNode) const;
 
 #pragma endregion Methods
 
@@ -0,0 +1,28 @@
+#include "pch.h"
+
+#include "SearchArena.h"
+
+SearchArena::SearchArena()
+	: m_nodes(std::vector<SearchNode>()), m_generation(0)
+{
+}
+
+void SearchArena::Begin(size_t size)
+{
+	if (m_nodes.size() != size)
+	{
+		m_nodes.assign(size, SearchNode{ 0, 0, -1, 0, NodeState::Unvisited });
+		m_generation = 0;
+	}
+
+	m_generation++;
+	if (m_generation == 0)
+	{
+		// Generation counter wrapped, stale stamps could alias the new search
+		for (SearchNode& node : m_nodes)
+		{
+			node.generation = 0;
+		}
+		m_generation = 1;
+	}
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "pch.h"
+
+/// <summary>
+/// Enum representing the state of a cell within a search.
+/// </summary>
+enum class NodeState : unsigned char
+{
+	Unvisited,
+	Open,
+	Closed,
+
+	// Reached by an earlier pass of an anytime search,
+	// its costs are known but it is neither open nor closed
+	Reached
+};
+
+/// <summary>
+/// Struct representing the per-search state of a single grid cell.
+/// </summary>
+struct SearchNode
+{
+	int gCost, hCost;
+	int parent;
+	unsigned int generation;
+	NodeState state;
+};
+
+/// <summary>
+/// Struct representing an entry of the open list, referring
+/// to a grid cell by its dense index.
+/// </summary>
+struct OpenNode
+{
+	int index;
+	int fCost, hCost;
+
+	/// <summary>
+	/// Less than operator override.
+	/// </summary>
+	/// <param name="other">The other object to compare to</param>
+	/// <returns>Whether the node is less than the passed node</returns>
+	const bool operator<(const OpenNode& other) const
+	{
+		return fCost == other.fCost ? hCost < other.hCost : fCost < other.fCost;
+	}
+
+	/// <summary>
+	/// Greater than operator override.
+	/// </summary>
+	/// <param name="other">The other object to compare to</param>
+	/// <returns>Whether the node is greater than the passed node</returns>
+	const bool operator>(const OpenNode& other) const
+	{
+		return fCost == other.fCost ? hCost > other.hCost : fCost > other.fCost;
+	}
+
+	/// <summary>
+	/// Equality operator override.
+	/// </summary>
+	/// <param name="other">The other object to compare to</param>
+	/// <returns>Whether they refer to the same cell</returns>
+	const bool operator==(const OpenNode& other) const { return index == other.index; }
+};
+
+/// <summary>
+/// Class representing a reusable arena of per-cell search state
+/// indexed by dense cell index. Each search bumps the generation
+/// counter instead of clearing the arena, so consecutive searches
+/// neither allocate nor touch cells they do not visit.
+/// </summary>
+class SearchArena
+{
+private:
+	std::vector<SearchNode> m_nodes;
+	unsigned int m_generation;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="SearchArena"/> class.
+	/// </summary>
+	SearchArena();
+
+	/// <summary>
+	/// Starts a new search over the passed number of cells,
+	/// invalidating the state of every previous search.
+	/// </summary>
+	/// <param name="size">The number of cells within the grid</param>
+	void Begin(size_t size);
+
+	/// <summary>
+	/// Retrieves the number of cells the arena is sized for.
+	/// </summary>
+	/// <returns>The number of cells</returns>
+	inline const size_t Size() const { return m_nodes.size(); }
+
+	/// <summary>
+	/// Retrieves the state of the cell within the current search.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The state of the cell</returns>
+	inline const NodeState GetState(int index) const
+	{
+		const SearchNode& node = m_nodes[index];
+		return node.generation == m_generation ? node.state : NodeState::Unvisited;
+	}
+
+	/// <summary>
+	/// Determines whether the cell is within the open set of the current search.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the cell is open</returns>
+	inline const bool IsOpen(int index) const { return GetState(index) == NodeState::Open; }
+
+	/// <summary>
+	/// Determines whether the cell is within the closed set of the current search.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the cell is closed</returns>
+	inline const bool IsClosed(int index) const { return GetState(index) == NodeState::Closed; }
+
+	/// <summary>
+	/// Determines whether the cell has been reached within the current search.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>Whether the costs and parent of the cell are known</returns>
+	inline const bool IsReached(int index) const { return GetState(index) != NodeState::Unvisited; }
+
+	/// <summary>
+	/// Marks the cell as open with the passed costs and parent.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <param name="gCost">The G cost of the cell</param>
+	/// <param name="hCost">The H cost of the cell</param>
+	/// <param name="parent">The parent cell index</param>
+	inline void Open(int index, int gCost, int hCost, int parent)
+	{
+		SearchNode& node = m_nodes[index];
+		node.gCost = gCost;
+		node.hCost = hCost;
+		node.parent = parent;
+		node.generation = m_generation;
+		node.state = NodeState::Open;
+	}
+
+	/// <summary>
+	/// Marks the cell as closed.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	inline void Close(int index)
+	{
+		SearchNode& node = m_nodes[index];
+		node.generation = m_generation;
+		node.state = NodeState::Closed;
+	}
+
+	/// <summary>
+	/// Takes the cell out of the closed set, keeping its costs and parent.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	inline void Release(int index)
+	{
+		SearchNode& node = m_nodes[index];
+		node.generation = m_generation;
+		node.state = NodeState::Reached;
+	}
+
+	/// <summary>
+	/// Retrieves the search state of the cell. Only meaningful
+	/// when the cell has been visited within the current search.
+	/// </summary>
+	/// <param name="index">The cell index</param>
+	/// <returns>The reference to the search state</returns>
+	inline SearchNode& operator[](int index) { return m_nodes[index]; }
+};
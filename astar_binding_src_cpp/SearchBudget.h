@@ -0,0 +1,77 @@
+#pragma once
+
+#include "pch.h"
+#include "SearchArena.h"
+#include "SearchOptions.h"
+
+/// <summary>
+/// Class representing the budgets of a single path search, started with
+/// the search. The clock is only read every 64 expansions.
+/// </summary>
+class SearchBudget
+{
+private:
+	std::chrono::steady_clock::time_point m_begin;
+	unsigned int m_expansions;
+	unsigned int m_maxExpansions;
+	long long m_maxMicroseconds;
+	size_t m_maxNodes;
+	bool m_exhausted;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="SearchBudget"/> class,
+	/// starting the clock.
+	/// </summary>
+	/// <param name="options">The options holding the budgets</param>
+	SearchBudget(const SearchOptions& options)
+		: m_begin(std::chrono::steady_clock::now()), m_expansions(0),
+			m_maxExpansions(options.maxExpansions > 0 ? options.maxExpansions : UINT_MAX),
+			m_maxMicroseconds(options.maxMicroseconds > 0 ? options.maxMicroseconds : 0),
+			m_maxNodes(options.maxBytes > 0 ? options.maxBytes / (sizeof(SearchNode) + sizeof(OpenNode)) : 0),
+			m_exhausted(false)
+	{
+	}
+
+	/// <summary>
+	/// Counts the expansion of a cell, unless a budget has run out.
+	/// </summary>
+	/// <param name="open">The number of cells within the open lists</param>
+	/// <returns>Whether the cell may be expanded</returns>
+	inline const bool Expand(size_t open)
+	{
+		if (m_exhausted) { return false; }
+
+		// Every visited cell is either expanded or still open
+		if (m_expansions >= m_maxExpansions || (m_maxNodes > 0 && m_expansions + open > m_maxNodes)
+			|| (m_maxMicroseconds > 0 && (m_expansions & 63) == 63 && GetElapsed() > m_maxMicroseconds))
+		{
+			m_exhausted = true;
+			return false;
+		}
+		m_expansions++;
+		return true;
+	}
+
+	/// <summary>
+	/// Determines whether a budget has run out.
+	/// </summary>
+	/// <returns>Whether the search was cut short</returns>
+	inline const bool IsExhausted() const { return m_exhausted; }
+
+	/// <summary>
+	/// Retrieves the number of expansions counted.
+	/// </summary>
+	/// <returns>The number of expansions</returns>
+	inline const unsigned int GetExpansions() const { return m_expansions; }
+
+	/// <summary>
+	/// Retrieves the time since the search started.
+	/// </summary>
+	/// <returns>The elapsed microseconds</returns>
+	inline const long long GetElapsed() const
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_begin).count();
+	}
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "pch.h"
+#include "SearchArena.h"
+#include "IndexedHeap.h"
+#include "BucketQueue.h"
+
+/// <summary>
+/// Struct representing the scratch memory of a single path query - the
+/// per cell search state and the open lists. A search only writes into its
+/// context, so queries holding separate contexts can run concurrently
+/// against the same grid. Contexts keep their capacity between queries.
+/// </summary>
+struct SearchContext
+{
+	SearchArena arena;
+	IndexedHeap heap;
+	BucketQueue buckets;
+
+	// Secondary state for searches confined to a single
+	// cluster while refining a hierarchical path
+	SearchArena clusterArena;
+	IndexedHeap clusterHeap;
+
+	// Backward frontier of a bidirectional search
+	SearchArena reverseArena;
+	IndexedHeap reverseHeap;
+	BucketQueue reverseBuckets;
+
+	// Cells reached by an anytime search, and the closed cells
+	// it found cheaper paths to during the current pass
+	std::vector<int> visited;
+	std::vector<int> inconsistent;
+
+	// Cells of the last path found, from the target back
+	// to (and excluding) the start
+	std::vector<int> cells;
+
+	// The last path costs at most this many times the cheapest
+	// one (1 - exact, 0 - unknown for hierarchical paths)
+	float bound = 1.0f;
+
+	// Whether a budget ran out and the last path only leads
+	// to the expanded cell closest to the target
+	bool partial = false;
+
+	// Cells expanded by the last search, across both frontiers,
+	// every anytime pass and the cluster searches of a hierarchical path
+	int expansions = 0;
+};
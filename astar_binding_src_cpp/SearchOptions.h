@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pch.h"
+
+// Heuristic weight of weighted and anytime searches when none is passed
+#define DEFAULT_SEARCH_WEIGHT 2.0f
+
+// Time an anytime search keeps improving its path when none is passed (microseconds)
+#define DEFAULT_ANYTIME_LIMIT 1000
+
+// Expansions a search may spend when no budget is passed
+#define DEFAULT_EXPANSION_BUDGET 10000
+
+/// <summary>
+/// Struct representing the per query parameters of a path search - trading
+/// optimality for speed, and bounding the work spent before the search
+/// settles for a partial path. Laid out as five 32-bit fields, so callers
+/// across the native interface may pass a matching struct.
+/// </summary>
+struct SearchOptions
+{
+	// Heuristic weight (epsilon) of a weighted search, and the starting
+	// weight of an anytime search - the path costs at most this many
+	// times the cheapest one
+	float weight;
+
+	// Time an anytime search keeps improving its path
+	// after the first one is found (microseconds)
+	int timeLimit;
+
+	// Budgets of the search, 0 - unlimited: the expansions, the
+	// wall-clock time (microseconds) and the memory of the visited
+	// cells (bytes). Once one runs out the search returns the path
+	// to the expanded cell closest to the target instead
+	int maxExpansions;
+	int maxMicroseconds;
+	int maxBytes;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="SearchOptions"/> struct.
+	/// </summary>
+	/// <param name="weight">The heuristic weight (clamped to at least 1)</param>
+	/// <param name="timeLimit">The time limit of an anytime search (microseconds)</param>
+	/// <param name="maxExpansions">The maximum number of expanded cells (0 - unlimited)</param>
+	/// <param name="maxMicroseconds">The maximum search time (microseconds, 0 - unlimited)</param>
+	/// <param name="maxBytes">The maximum memory of the visited cells (bytes, 0 - unlimited)</param>
+	SearchOptions(float weight = DEFAULT_SEARCH_WEIGHT, int timeLimit = DEFAULT_ANYTIME_LIMIT,
+		int maxExpansions = DEFAULT_EXPANSION_BUDGET, int maxMicroseconds = 0, int maxBytes = 0)
+		: weight(std::max(1.0f, weight)), timeLimit(std::max(timeLimit, 0)), maxExpansions(std::max(maxExpansions, 0)),
+			maxMicroseconds(std::max(maxMicroseconds, 0)), maxBytes(std::max(maxBytes, 0))
+	{
+	}
+
+	/// <summary>
+	/// Clamps the passed options as the constructor does, options handed over the native
+	/// boundary arrive as raw memory and would otherwise skip the clamping.
+	/// </summary>
+	/// <param name="options">The options (null - the defaults)</param>
+	/// <returns>The clamped options</returns>
+	static SearchOptions Normalize(const SearchOptions* options)
+	{
+		return options ? SearchOptions(options->weight, options->timeLimit, options->maxExpansions, options->maxMicroseconds, options->maxBytes)
+			: SearchOptions();
+	}
+};
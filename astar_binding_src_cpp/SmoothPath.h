@@ -23,19 +23,19 @@ public:
 	/// <param name="start">The start coordinate</param>
 	/// <param name="turnDist">The turn distance</param>
 	/// <param name="stoppingDist">The stopping distance</param>
-	SmoothPath(std::vector<Vec3> points, Vec3 start, float turnDist, float stoppingDist);
+	SmoothPath(const std::vector<Vec3>& points, Vec3 start, float turnDist, float stoppingDist);
 
 	/// <summary>
 	/// Retrieves the look points of the smooth path.
 	/// </summary>
 	/// <returns>The collection of look points</returns>
-	inline const std::vector<Vec3> GetLookPoints() const { return m_lookPoints; }
+	inline const std::vector<Vec3>& GetLookPoints() const { return m_lookPoints; }
 	
 	/// <summary>
 	/// Retrieves the turn boundaries of the smooth path.
 	/// </summary>
 	/// <returns>The collection of turn boundaries</returns>
-	inline const std::vector<Line> GetTurnBoundaries() const { return m_turnBoundaries; }
+	inline const std::vector<Line>& GetTurnBoundaries() const { return m_turnBoundaries; }
 
 	/// <summary>
 	/// Retrieves size of the turn boundaries of the smooth path.
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "pch.h"
+#include "Vec3.h"
+#include "SearchContext.h"
+
+class AStar;
+
+/// <summary>
+/// Enum representing the progress of a <see cref="SteppedSearch"/>.
+/// </summary>
+enum class SearchStatus : int
+{
+	Idle = 0,		// Never started
+	Running = 1,	// Expanding, the result leads towards the target so far
+	Found = 2,		// The target was reached
+	NotFound = 3	// The target is unreachable
+};
+
+/// <summary>
+/// Struct representing a path search spread across several calls. The open
+/// list and the per cell state persist in its own context between steps, so
+/// a caller may give every search a few expansions per frame and interleave
+/// any number of them. A grid edit between steps restarts the search against
+/// the edited grid. A search must not be stepped by several threads at once.
+/// </summary>
+struct SteppedSearch
+{
+	SearchContext context;
+	SearchStatus status = SearchStatus::Idle;
+
+	// The query as passed, the cells it resolved to
+	// and the search mode chosen when it (re)started
+	Vec3 startCoordinate, targetCoordinate;
+	int flags = 0;
+	float weight = 1.0f;
+	int start = -1, target = -1;
+	bool jump = false, buckets = false;
+
+	// The grid the state was computed against, and
+	// the expanded cell closest to the target so far
+	const AStar* astar = nullptr;
+	unsigned int version = 0;
+	int closest = -1;
+};
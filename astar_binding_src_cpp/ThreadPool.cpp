@@ -0,0 +1,128 @@
+#include "pch.h"
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threads)
+	: m_job(nullptr), m_remaining(0), m_batch(0), m_stop(false)
+{
+	if (threads == 0)
+	{
+		threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	}
+
+	// The last queue belongs to the thread calling ParallelFor
+	for (unsigned int i = 0; i <= threads; i++)
+	{
+		m_queues.push_back(std::make_unique<WorkQueue>());
+	}
+	for (unsigned int i = 0; i < threads; i++)
+	{
+		m_threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stop = true;
+	}
+	m_wake.notify_all();
+	for (std::thread& thread : m_threads)
+	{
+		thread.join();
+	}
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& job)
+{
+	if (count <= 0) { return; }
+
+	std::lock_guard<std::mutex> batch(m_batchLock);
+
+	// Hand every thread a contiguous run of indices, stealing evens out the rest
+	int queues = m_queues.size();
+	int chunk = (count + queues - 1) / queues;
+	m_job = &job;
+	m_remaining = count;
+	for (int queue = 0; queue < queues; queue++)
+	{
+		WorkQueue& work = *m_queues[queue];
+		std::lock_guard<std::mutex> lock(work.lock);
+		for (int index = queue * chunk; index < std::min((queue + 1) * chunk, count); index++)
+		{
+			work.indices.push_back(index);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_batch++;
+	}
+	m_wake.notify_all();
+
+	Drain(queues - 1);
+
+	std::unique_lock<std::mutex> lock(m_lock);
+	m_done.wait(lock, [this] { return m_remaining == 0; });
+	m_job = nullptr;
+}
+
+void ThreadPool::WorkerLoop(int queue)
+{
+	unsigned int batch = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			m_wake.wait(lock, [this, batch] { return m_stop || m_batch != batch; });
+			if (m_stop) { return; }
+			batch = m_batch;
+		}
+		Drain(queue);
+	}
+}
+
+void ThreadPool::Drain(int queue)
+{
+	int index;
+	while (Pop(queue, index))
+	{
+		// The job is published before the indices, popping one orders the read after it
+		(*m_job)(index);
+
+		if (--m_remaining == 0)
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			m_done.notify_all();
+		}
+	}
+}
+
+const bool ThreadPool::Pop(int queue, int& index)
+{
+	{
+		WorkQueue& own = *m_queues[queue];
+		std::lock_guard<std::mutex> lock(own.lock);
+		if (!own.indices.empty())
+		{
+			index = own.indices.front();
+			own.indices.pop_front();
+			return true;
+		}
+	}
+
+	int queues = m_queues.size();
+	for (int i = 1; i < queues; i++)
+	{
+		WorkQueue& other = *m_queues[(queue + i) % queues];
+		std::lock_guard<std::mutex> lock(other.lock);
+		if (!other.indices.empty())
+		{
+			index = other.indices.back();
+			other.indices.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "pch.h"
+
+/// <summary>
+/// Class representing a fixed pool of worker threads executing indexed
+/// batches of work. Every worker (and the calling thread) owns a queue of
+/// indices, popping from its front and stealing from the back of the other
+/// queues once its own runs dry, so uneven work items balance out.
+/// </summary>
+class ThreadPool
+{
+private:
+
+	/// <summary>
+	/// Struct representing the work queue of a single thread.
+	/// </summary>
+	struct WorkQueue
+	{
+		std::deque<int> indices;
+		std::mutex lock;
+	};
+
+	std::vector<std::thread> m_threads;
+	std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+	std::mutex m_lock, m_batchLock;
+	std::condition_variable m_wake, m_done;
+	const std::function<void(int)>* m_job;
+	std::atomic<int> m_remaining;
+	unsigned int m_batch;
+	bool m_stop;
+
+public:
+
+	// Prevent copying, the workers reference the pool
+	ThreadPool(const ThreadPool&) = delete;
+	void operator = (const ThreadPool&) = delete;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="ThreadPool"/> class.
+	/// </summary>
+	/// <param name="threads">The number of worker threads (0 - one less than the hardware threads)</param>
+	ThreadPool(unsigned int threads = 0);
+
+	/// <summary>
+	/// Finalizes an instance of the <see cref="ThreadPool"/> class, joining the workers.
+	/// </summary>
+	~ThreadPool();
+
+	/// <summary>
+	/// Retrieves the number of threads executing a batch, including the calling thread.
+	/// </summary>
+	/// <returns>The number of threads</returns>
+	inline const size_t GetThreadCount() const { return m_queues.size(); }
+
+	/// <summary>
+	/// Executes the passed job for every index in [0, count) across the pool,
+	/// returning once every index has been processed.
+	/// </summary>
+	/// <param name="count">The number of indices</param>
+	/// <param name="job">The job to execute per index</param>
+	void ParallelFor(int count, const std::function<void(int)>& job);
+
+private:
+
+	/// <summary>
+	/// The loop of a worker thread, waiting for and executing batches.
+	/// </summary>
+	/// <param name="queue">The queue index owned by the worker</param>
+	void WorkerLoop(int queue);
+
+	/// <summary>
+	/// Executes indices from the owned queue, then steals from the other
+	/// queues until no work is left.
+	/// </summary>
+	/// <param name="queue">The queue index owned by the thread</param>
+	void Drain(int queue);
+
+	/// <summary>
+	/// Pops an index from the front of the owned queue or the back of another queue.
+	/// </summary>
+	/// <param name="queue">The queue index owned by the thread</param>
+	/// <param name="index">The popped index</param>
+	/// <returns>Whether an index was popped</returns>
+	const bool Pop(int queue, int& index);
+};
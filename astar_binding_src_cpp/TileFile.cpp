@@ -0,0 +1,211 @@
+#include "pch.h"
+#include <cstring>
+
+#include "TileFile.h"
+#include "GridSnapshot.h"
+
+TileFile::TileFile()
+	: m_header(), m_writable(false)
+{
+}
+
+TileFile::~TileFile()
+{
+	Close();
+}
+
+const bool TileFile::Open(const char* path, bool writable)
+{
+	Close();
+	m_file.open(path, writable ? std::ios::in | std::ios::out | std::ios::binary : std::ios::in | std::ios::binary);
+	if (!m_file.is_open()) { return false; }
+
+	size_t walkable, penalties, positions;
+	m_file.read(reinterpret_cast<char*>(&m_header), sizeof(TileFileHeader));
+	if (!m_file.good() || m_header.magic != TILE_FILE_MAGIC || m_header.version != TILE_FILE_VERSION
+		|| m_header.width < 0 || m_header.height < 0 || m_header.tileSize <= 0
+		|| m_header.tilesX != (m_header.width + m_header.tileSize - 1) / m_header.tileSize
+		|| m_header.tilesY != (m_header.height + m_header.tileSize - 1) / m_header.tileSize
+		|| (int64_t)m_header.tilesX * m_header.tilesY > INT_MAX
+		|| m_header.recordSize != RecordLayout(m_header.tileSize, walkable, penalties, positions))
+	{
+		m_file.close();
+		m_header = TileFileHeader();
+		return false;
+	}
+	m_writable = writable;
+	return true;
+}
+
+const bool TileFile::Create(const char* path, int width, int height, int tileSize, Vec3 offset)
+{
+	Close();
+	size_t walkable, penalties, positions;
+	TileFileHeader header = {};
+	header.magic = TILE_FILE_MAGIC;
+	header.version = TILE_FILE_VERSION;
+	header.width = std::max(width, 0);
+	header.height = std::max(height, 0);
+	header.tileSize = tileSize > 0 ? tileSize : DEFAULT_TILE_FILE_SIZE;
+	header.tilesX = (header.width + header.tileSize - 1) / header.tileSize;
+	header.tilesY = (header.height + header.tileSize - 1) / header.tileSize;
+	header.minPenalty = INT_MAX;
+	header.maxPenalty = 0;
+	header.offsetX = offset.x;
+	header.offsetY = offset.y;
+	header.offsetZ = offset.z;
+	header.recordSize = RecordLayout(header.tileSize, walkable, penalties, positions);
+	if ((int64_t)header.tilesX * header.tilesY > INT_MAX) { return false; }
+
+	m_file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!m_file.is_open()) { return false; }
+
+	// Records of zeroes are blocked tiles, so extending the file is
+	// enough, leaving unwritten tiles as holes on sparse file systems
+	m_header = header;
+	m_writable = true;
+	m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(TileFileHeader));
+	uint64_t size = sizeof(TileFileHeader) + (uint64_t)header.tilesX * header.tilesY * header.recordSize;
+	if (size > sizeof(TileFileHeader))
+	{
+		m_file.seekp((std::streamoff)size - 1);
+		m_file.put(0);
+	}
+	return m_file.good();
+}
+
+void TileFile::Close()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (!m_file.is_open()) { return; }
+
+	if (m_writable)
+	{
+		m_file.seekp(0);
+		m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(TileFileHeader));
+	}
+	m_file.close();
+	m_writable = false;
+}
+
+const bool TileFile::ReadTile(int tile, GridTile& result)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return ReadRecord(tile, result);
+}
+
+const bool TileFile::WriteTile(int tile, const GridTile& source)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return WriteRecord(tile, source);
+}
+
+const bool TileFile::WritePoints(const float* points, int d1)
+{
+	// The leading size is read from the caller's buffer, so it must fit the collection passed
+	if (points == nullptr || d1 < 1 || points[0] < 1 || points[0] > d1) { return false; }
+
+	// Points are grouped by tile, so every touched record is read and written once
+	std::map<int, std::vector<int>> tiles;
+	for (int i = 0; i < (points[0] - 1) / 7; i++)
+	{
+		int base = (i * 7) + 1;
+		int x = (int)points[base], y = (int)points[base + 1];
+		if (x < 0 || x >= m_header.width || y < 0 || y >= m_header.height) { continue; }
+		tiles[x / m_header.tileSize + (y / m_header.tileSize) * m_header.tilesX].push_back(base);
+	}
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	bool written = true;
+	GridTile tile;
+	for (const std::pair<const int, std::vector<int>>& entry : tiles)
+	{
+		ReadRecord(entry.first, tile);
+		for (int base : entry.second)
+		{
+			int cell = (int)points[base] % m_header.tileSize + ((int)points[base + 1] % m_header.tileSize) * m_header.tileSize;
+			tile.positions[cell] = Vec3(points[base + 2], points[base + 3], points[base + 4]);
+			tile.walkable[cell] = points[base + 5] != 0;
+			tile.penalties[cell] = (int32_t)points[base + 6];
+		}
+		written = WriteRecord(entry.first, tile) && written;
+	}
+	return written;
+}
+
+void TileFile::ResetTile(GridTile& tile) const
+{
+	size_t cells = (size_t)m_header.tileSize * m_header.tileSize;
+	tile.walkable.assign(cells, 0);
+	tile.penalties.assign(cells, 0);
+	tile.positions.assign(cells, Vec3());
+}
+
+const uint64_t TileFile::RecordLayout(int tileSize, size_t& walkable, size_t& penalties, size_t& positions)
+{
+	// A leading checksum, then the walkability bytes, the penalties and the positions
+	size_t cells = (size_t)tileSize * tileSize;
+	walkable = sizeof(uint64_t);
+	penalties = walkable + Align(cells);
+	positions = penalties + Align(cells * sizeof(int32_t));
+	return positions + Align(cells * 3 * sizeof(float));
+}
+
+const bool TileFile::ReadRecord(int tile, GridTile& result)
+{
+	ResetTile(result);
+	if (!m_file.is_open() || tile < 0 || tile >= m_header.tilesX * m_header.tilesY) { return false; }
+
+	size_t walkable, penalties, positions;
+	std::vector<uint64_t> record(RecordLayout(m_header.tileSize, walkable, penalties, positions) / sizeof(uint64_t));
+	m_file.seekg((std::streamoff)(sizeof(TileFileHeader) + (uint64_t)tile * m_header.recordSize));
+	m_file.read(reinterpret_cast<char*>(record.data()), record.size() * sizeof(uint64_t));
+	if (!m_file.good())
+	{
+		m_file.clear();
+		return false;
+	}
+	if (GridSnapshot::Checksum(record.data() + 1, record.size() - 1) != record[0]) { return false; }
+
+	// Positions are stored as floats in Vec3 order
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(record.data());
+	size_t cells = result.walkable.size();
+	std::memcpy(result.walkable.data(), bytes + walkable, cells);
+	std::memcpy(result.penalties.data(), bytes + penalties, cells * sizeof(int32_t));
+	const float* position = reinterpret_cast<const float*>(bytes + positions);
+	for (size_t cell = 0; cell < cells; cell++, position += 3)
+	{
+		result.positions[cell] = Vec3(position[0], position[1], position[2]);
+	}
+	return true;
+}
+
+const bool TileFile::WriteRecord(int tile, const GridTile& source)
+{
+	if (!m_writable || tile < 0 || tile >= m_header.tilesX * m_header.tilesY) { return false; }
+
+	size_t walkable, penalties, positions;
+	std::vector<uint64_t> record(RecordLayout(m_header.tileSize, walkable, penalties, positions) / sizeof(uint64_t), 0);
+	uint8_t* bytes = reinterpret_cast<uint8_t*>(record.data());
+	size_t cells = source.walkable.size();
+	std::memcpy(bytes + walkable, source.walkable.data(), cells);
+	std::memcpy(bytes + penalties, source.penalties.data(), cells * sizeof(int32_t));
+	float* position = reinterpret_cast<float*>(bytes + positions);
+	for (size_t cell = 0; cell < cells; cell++, position += 3)
+	{
+		position[0] = source.positions[cell].x;
+		position[1] = source.positions[cell].y;
+		position[2] = source.positions[cell].z;
+
+		if (source.walkable[cell])
+		{
+			m_header.minPenalty = std::min(m_header.minPenalty, source.penalties[cell]);
+		}
+		m_header.maxPenalty = std::max(m_header.maxPenalty, source.penalties[cell]);
+	}
+	record[0] = GridSnapshot::Checksum(record.data() + 1, record.size() - 1);
+
+	m_file.seekp((std::streamoff)(sizeof(TileFileHeader) + (uint64_t)tile * m_header.recordSize));
+	m_file.write(reinterpret_cast<const char*>(record.data()), record.size() * sizeof(uint64_t));
+	return m_file.good();
+}
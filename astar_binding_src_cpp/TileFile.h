@@ -0,0 +1,191 @@
+#pragma once
+
+#include "pch.h"
+#include <fstream>
+#include "Vec3.h"
+
+// Leading bytes of every tile file ("ATIL" read as a little endian word)
+#define TILE_FILE_MAGIC 0x4C495441u
+
+// Layout version written into new tile files, older layouts are rejected
+#define TILE_FILE_VERSION 1
+
+// Cells per tile side unless configured otherwise
+#define DEFAULT_TILE_FILE_SIZE 64
+
+/// <summary>
+/// Struct representing the fixed size header leading a tile file.
+/// </summary>
+struct TileFileHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	int32_t width, height;
+	int32_t tileSize;
+	int32_t tilesX, tilesY;
+
+	// The lowest penalty of any walkable cell (bounding the heuristic) and the highest penalty
+	int32_t minPenalty, maxPenalty;
+	float offsetX, offsetY, offsetZ;
+
+	// Bytes of every tile record following the header
+	uint64_t recordSize;
+};
+
+/// <summary>
+/// Struct representing the cells of a single tile, row by row with
+/// tileSize cells per row. Cells outside the grid are blocked.
+/// </summary>
+struct GridTile
+{
+	std::vector<uint8_t> walkable;
+	std::vector<int32_t> penalties;
+	std::vector<Vec3> positions;
+
+	/// <summary>
+	/// Retrieves the memory held by the tile.
+	/// </summary>
+	/// <returns>The bytes held</returns>
+	inline const size_t GetBytes() const
+	{
+		return sizeof(GridTile) + walkable.capacity() + penalties.capacity() * sizeof(int32_t) + positions.capacity() * sizeof(Vec3);
+	}
+};
+
+/// <summary>
+/// Class representing a grid stored on disk as fixed size square tiles, so
+/// a single tile is read or written at its computed offset without touching
+/// the rest of the file. Every record holds a checksum, the walkability of
+/// its cells as bytes, their penalties and their full world positions. A
+/// tile never written reads as zeroes, which is a valid record of blocked
+/// cells. Reads and writes through one file are serialized.
+/// </summary>
+class TileFile
+{
+private:
+	std::fstream m_file;
+	TileFileHeader m_header;
+	bool m_writable;
+	std::mutex m_lock;
+
+public:
+
+	// Prevent copying, the stream is owned by the file
+	TileFile(const TileFile&) = delete;
+	void operator = (const TileFile&) = delete;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="TileFile"/> class
+	/// without an open file.
+	/// </summary>
+	TileFile();
+
+	/// <summary>
+	/// Destroys the instance of the <see cref="TileFile"/> class, writing
+	/// the header of a writable file.
+	/// </summary>
+	~TileFile();
+
+	/// <summary>
+	/// Opens an existing tile file, validating its header.
+	/// </summary>
+	/// <param name="path">The file path</param>
+	/// <param name="writable">Whether tiles may be written</param>
+	/// <returns>Whether the file was opened</returns>
+	const bool Open(const char* path, bool writable = false);
+
+	/// <summary>
+	/// Creates a tile file of blocked cells, replacing any file at the path.
+	/// </summary>
+	/// <param name="path">The file path</param>
+	/// <param name="width">The grid width</param>
+	/// <param name="height">The grid height</param>
+	/// <param name="tileSize">The cells per tile side</param>
+	/// <param name="offset">The world offset</param>
+	/// <returns>Whether the file was created</returns>
+	const bool Create(const char* path, int width, int height, int tileSize, Vec3 offset);
+
+	/// <summary>
+	/// Writes the header and closes the file.
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// Determines whether a file is open.
+	/// </summary>
+	/// <returns>Whether a file is open</returns>
+	inline const bool IsOpen() const { return m_file.is_open(); }
+
+	/// <summary>
+	/// Retrieves the header of the file.
+	/// </summary>
+	/// <returns>The header</returns>
+	inline const TileFileHeader& GetHeader() const { return m_header; }
+
+	/// <summary>
+	/// Reads the passed tile.
+	/// </summary>
+	/// <param name="tile">The tile index (tileX + tileY * tilesX)</param>
+	/// <param name="result">The tile to fill</param>
+	/// <returns>Whether the record was read and its checksum matched</returns>
+	const bool ReadTile(int tile, GridTile& result);
+
+	/// <summary>
+	/// Writes the passed tile, widening the penalty range of the header.
+	/// </summary>
+	/// <param name="tile">The tile index (tileX + tileY * tilesX)</param>
+	/// <param name="source">The tile to write</param>
+	/// <returns>Whether the record was written</returns>
+	const bool WriteTile(int tile, const GridTile& source);
+
+	/// <summary>
+	/// Writes the passed points, laid out like the points passed to
+	/// <see cref="AStar::AddGridPoints"/>, into the tiles holding them.
+	/// </summary>
+	/// <param name="points">The collection of values making up the points</param>
+	/// <param name="d1">The dimension of the collection</param>
+	/// <returns>Whether every touched tile was written, false if the leading size exceeds the dimension</returns>
+	const bool WritePoints(const float* points, int d1);
+
+	/// <summary>
+	/// Resizes the passed tile to the cells of a tile of this file, all blocked.
+	/// </summary>
+	/// <param name="tile">The tile to reset</param>
+	void ResetTile(GridTile& tile) const;
+
+private:
+
+	/// <summary>
+	/// Calculates the byte offsets of the sections of a tile record.
+	/// </summary>
+	/// <param name="tileSize">The cells per tile side</param>
+	/// <param name="walkable">The offset of the walkability bytes</param>
+	/// <param name="penalties">The offset of the penalties</param>
+	/// <param name="positions">The offset of the positions</param>
+	/// <returns>The bytes of a record</returns>
+	static const uint64_t RecordLayout(int tileSize, size_t& walkable, size_t& penalties, size_t& positions);
+
+	/// <summary>
+	/// Rounds the passed byte count up to the next section boundary.
+	/// </summary>
+	/// <param name="bytes">The byte count</param>
+	/// <returns>The padded byte count</returns>
+	inline static const size_t Align(size_t bytes) { return (bytes + 7) & ~(size_t)7; }
+
+	/// <summary>
+	/// Reads the passed tile, the lock already held.
+	/// </summary>
+	/// <param name="tile">The tile index</param>
+	/// <param name="result">The tile to fill</param>
+	/// <returns>Whether the record was read and its checksum matched</returns>
+	const bool ReadRecord(int tile, GridTile& result);
+
+	/// <summary>
+	/// Writes the passed tile, the lock already held.
+	/// </summary>
+	/// <param name="tile">The tile index</param>
+	/// <param name="source">The tile to write</param>
+	/// <returns>Whether the record was written</returns>
+	const bool WriteRecord(int tile, const GridTile& source);
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "pch.h"
+#include "TileFile.h"
+
+// Tiles a query keeps pinned at once, so neighbouring cells
+// are read without going through the shared tile cache
+#define TILED_CONTEXT_SLOTS 16
+
+/// <summary>
+/// Struct representing the search state of a cell reached by a tiled search.
+/// </summary>
+struct TiledNode
+{
+	int gCost, hCost;
+	int64_t parent;
+	bool closed;
+};
+
+/// <summary>
+/// Struct representing an entry of the open list of a tiled search. An
+/// entry whose cost no longer matches its cell is stale and skipped.
+/// </summary>
+struct TiledOpenNode
+{
+	int64_t index;
+	int gCost;
+	int fCost, hCost;
+
+	const bool operator>(const TiledOpenNode& other) const
+	{
+		return fCost == other.fCost ? hCost > other.hCost : fCost > other.fCost;
+	}
+};
+
+/// <summary>
+/// Struct representing the scratch memory of a single path query against a
+/// <see cref="TiledWorld"/>. The search state is keyed by cell, so it grows
+/// with the cells a query reaches rather than with the world, and the tiles
+/// the query read last stay pinned until it ends. Queries holding separate
+/// contexts run concurrently. Contexts keep their capacity between queries.
+/// </summary>
+struct TiledContext
+{
+	std::unordered_map<int64_t, TiledNode> nodes;
+	std::vector<TiledOpenNode> open;
+
+	// Pinned tiles, direct mapped by tile index
+	std::array<std::pair<int, std::shared_ptr<const GridTile>>, TILED_CONTEXT_SLOTS> tiles;
+
+	// Cells of the last path found, from the target back
+	// to (and excluding) the start
+	std::vector<int64_t> cells;
+
+	// Whether a budget ran out and the last path only leads
+	// to the expanded cell closest to the target
+	bool partial = false;
+};
@@ -0,0 +1,267 @@
+#include "pch.h"
+
+#include "TiledWorld.h"
+#include "Grid.h"
+
+TiledWorld::TiledWorld(size_t budget)
+	: m_header(), m_budget(budget), m_resident(0), m_hits(0), m_faults(0)
+{
+}
+
+const bool TiledWorld::Open(const char* path)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_tiles.clear();
+	m_lookup.clear();
+	m_resident = 0;
+
+	bool opened = m_file.Open(path);
+	m_header = m_file.GetHeader();
+	return opened;
+}
+
+const std::vector<Vec3> TiledWorld::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, TiledContext& context, const SearchOptions& options)
+{
+	context.cells.clear();
+	context.partial = false;
+	if (m_header.width == 0 || m_header.height == 0) { return {}; }
+
+	int64_t start = GetIndex(startCoordinate);
+	int64_t target = GetIndex(targetCoordinate);
+
+	int startCell, targetCell;
+	if (!GetTile(context, start, startCell).walkable[startCell] || !GetTile(context, target, targetCell).walkable[targetCell])
+	{
+		ReleaseTiles(context);
+		return {};
+	}
+
+	SearchBudget budget(options);
+	int64_t closest = start;
+	std::vector<Vec3> waypoints;
+	if (Search(start, target, context, budget, closest))
+	{
+		waypoints = RetracePath(start, target, context);
+	}
+	else if (budget.IsExhausted())
+	{
+		// A search cut short by its budget settles for the path to
+		// the expanded cell closest to the target
+		context.partial = true;
+		if (closest != start)
+		{
+			waypoints = RetracePath(start, closest, context);
+		}
+	}
+
+	// The state is dropped with the tiles, a context
+	// only holds on to its capacity between queries
+	context.nodes.clear();
+	context.open.clear();
+	ReleaseTiles(context);
+	return waypoints;
+}
+
+void TiledWorld::SetBudget(size_t budget)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_budget = budget;
+	Trim();
+}
+
+const std::tuple<size_t, size_t, size_t, size_t> TiledWorld::GetStats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	return std::make_tuple(m_resident, m_tiles.size(), m_hits, m_faults);
+}
+
+void TiledWorld::ResetStats()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_hits = 0;
+	m_faults = 0;
+}
+
+const bool TiledWorld::Search(int64_t start, int64_t target, TiledContext& context, SearchBudget& budget, int64_t& closest)
+{
+	std::unordered_map<int64_t, TiledNode>& nodes = context.nodes;
+	std::vector<TiledOpenNode>& open = context.open;
+	nodes.clear();
+	open.clear();
+
+	// Same costs as the in-memory search, bounded by the lowest walkable penalty of the file
+	int minPenalty = m_header.minPenalty == INT_MAX ? 0 : std::max(m_header.minPenalty, 0);
+	int cell;
+	Vec3 targetPosition = GetTile(context, target, cell).positions[cell];
+	int targetX = (int)(target % m_header.width), targetY = (int)(target / m_header.width);
+	auto heuristic = [&](int64_t index, const Vec3& position)
+	{
+		int steps = std::max(abs((int)(index % m_header.width) - targetX), abs((int)(index / m_header.width) - targetY));
+		return (int)ceil(position.ManhattenDistanceTo(targetPosition)) + steps * minPenalty;
+	};
+
+	int startH = heuristic(start, GetTile(context, start, cell).positions[cell]);
+	nodes[start] = { 0, startH, -1, false };
+	open.push_back({ start, 0, startH, startH });
+
+	while (open.size() > 0)
+	{
+		std::pop_heap(open.begin(), open.end(), std::greater<TiledOpenNode>());
+		TiledOpenNode entry = open.back();
+		open.pop_back();
+
+		// Cheaper paths found later push a new entry instead of reordering the heap
+		TiledNode& current = nodes[entry.index];
+		if (current.closed || entry.gCost != current.gCost) { continue; }
+
+		// This path is taking too long to compute so finding stops short
+		if (!budget.Expand(open.size())) { break; }
+
+		current.closed = true;
+		if (entry.index == target)
+		{
+			return true;
+		}
+		if (current.hCost < nodes[closest].hCost)
+		{
+			closest = entry.index;
+		}
+
+		Vec3 position = GetTile(context, entry.index, cell).positions[cell];
+		int row = (int)(entry.index % m_header.width), col = (int)(entry.index / m_header.width);
+		for (int x = -1; x <= 1; x++)
+		{
+			for (int y = -1; y <= 1; y++)
+			{
+				if (x == 0 && y == 0) { continue; }
+				if (row + x < 0 || row + x >= m_header.width || col + y < 0 || col + y >= m_header.height) { continue; }
+
+				int64_t neighbor = entry.index + x + (int64_t)y * m_header.width;
+				const GridTile& tile = GetTile(context, neighbor, cell);
+				if (!tile.walkable[cell]) { continue; }
+
+				auto found = nodes.find(neighbor);
+				if (found != nodes.end() && found->second.closed) { continue; }
+
+				int newMoveCost = current.gCost + (int)ceil(position.ManhattenDistanceTo(tile.positions[cell])) + tile.penalties[cell];
+				if (found != nodes.end())
+				{
+					if (newMoveCost >= found->second.gCost) { continue; }
+
+					found->second.gCost = newMoveCost;
+					found->second.parent = entry.index;
+					open.push_back({ neighbor, newMoveCost, newMoveCost + found->second.hCost, found->second.hCost });
+				}
+				else
+				{
+					int hCost = heuristic(neighbor, tile.positions[cell]);
+					nodes[neighbor] = { newMoveCost, hCost, entry.index, false };
+					open.push_back({ neighbor, newMoveCost, newMoveCost + hCost, hCost });
+				}
+				std::push_heap(open.begin(), open.end(), std::greater<TiledOpenNode>());
+			}
+		}
+	}
+	return false;
+}
+
+const std::vector<Vec3> TiledWorld::RetracePath(int64_t start, int64_t end, TiledContext& context)
+{
+	std::vector<int64_t>& nodes = context.cells;
+	nodes.clear();
+	for (int64_t current = end; current != start; current = context.nodes[current].parent)
+	{
+		nodes.push_back(current);
+	}
+
+	// Simplified like the in-memory path, keeping the cells where the direction changes
+	std::vector<Vec3> waypoints;
+	waypoints.reserve(nodes.size());
+	float oldDir = FLT_EPSILON; // Impossible direction
+	int cell;
+	Vec3 previous;
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		Vec3 position = GetTile(context, nodes[i], cell).positions[cell];
+		if (i == 0)
+		{
+			waypoints.push_back(position);
+			previous = position;
+			continue;
+		}
+
+		float newDir = previous.DirectionTo(position);
+		if (!(abs(oldDir - newDir) < FLT_EPSILON))
+		{
+			waypoints.push_back(position);
+		}
+		oldDir = newDir;
+		previous = position;
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+	return waypoints;
+}
+
+const int64_t TiledWorld::GetIndex(const Vec3& coordinate) const
+{
+	float width = (float)m_header.width, height = (float)m_header.height;
+	float xPercent = clamp((coordinate.x + (width / 2.0f)) / width, 0.0f, 1.0f);
+	float yPercent = clamp((coordinate.z + (height / 2.0f)) / height, 0.0f, 1.0f);
+
+	return (int64_t)std::round((width - 1) * xPercent) + (int64_t)std::round((height - 1) * yPercent) * m_header.width;
+}
+
+std::shared_ptr<const GridTile> TiledWorld::AcquireTile(int tile)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		auto found = m_lookup.find(tile);
+		if (found != m_lookup.end())
+		{
+			m_tiles.splice(m_tiles.begin(), m_tiles, found->second);
+			m_hits++;
+			return found->second->second;
+		}
+	}
+
+	// Faulted in outside the cache lock, so queries on resident tiles carry on meanwhile
+	std::shared_ptr<GridTile> loaded = std::make_shared<GridTile>();
+	m_file.ReadTile(tile, *loaded);
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	m_faults++;
+
+	// Another query may have faulted in the same tile meanwhile
+	auto found = m_lookup.find(tile);
+	if (found != m_lookup.end())
+	{
+		m_tiles.splice(m_tiles.begin(), m_tiles, found->second);
+		return found->second->second;
+	}
+
+	m_tiles.emplace_front(tile, loaded);
+	m_lookup[tile] = m_tiles.begin();
+	m_resident += loaded->GetBytes();
+	Trim();
+	return loaded;
+}
+
+void TiledWorld::ReleaseTiles(TiledContext& context)
+{
+	for (std::pair<int, std::shared_ptr<const GridTile>>& slot : context.tiles)
+	{
+		slot.first = -1;
+		slot.second.reset();
+	}
+}
+
+void TiledWorld::Trim()
+{
+	// The most recently used tile always stays, the query faulting it in reads it next
+	while (m_resident > m_budget && m_tiles.size() > 1)
+	{
+		m_resident -= m_tiles.back().second->GetBytes();
+		m_lookup.erase(m_tiles.back().first);
+		m_tiles.pop_back();
+	}
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "pch.h"
+#include "Vec3.h"
+#include "TileFile.h"
+#include "TiledContext.h"
+#include "SearchOptions.h"
+#include "SearchBudget.h"
+
+// Bytes of resident tiles kept by a tiled world unless configured otherwise
+#define DEFAULT_TILE_CACHE_BUDGET (256ull * 1024 * 1024)
+
+/// <summary>
+/// Class representing a pathfinding world backed by a <see cref="TileFile"/>
+/// instead of an in-memory grid, for worlds larger than the memory at hand.
+/// Tiles are read on demand the first time a query reaches one of their cells
+/// and kept in a least recently used cache under a byte budget. Queries keep
+/// their state in a <see cref="TiledContext"/> and run concurrently. A tile
+/// that fails to read or whose checksum does not match is searched as blocked.
+/// </summary>
+class TiledWorld
+{
+private:
+	TileFile m_file;
+	TileFileHeader m_header;
+
+	// Most recently used tiles first
+	std::list<std::pair<int, std::shared_ptr<const GridTile>>> m_tiles;
+	std::unordered_map<int, std::list<std::pair<int, std::shared_ptr<const GridTile>>>::iterator> m_lookup;
+	size_t m_budget, m_resident;
+	size_t m_hits, m_faults;
+	std::mutex m_lock;
+
+public:
+
+	// Prevent copying, the lookup references the tiles
+	TiledWorld(const TiledWorld&) = delete;
+	void operator = (const TiledWorld&) = delete;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="TiledWorld"/> class
+	/// without a tile file.
+	/// </summary>
+	/// <param name="budget">The maximum bytes of resident tiles</param>
+	TiledWorld(size_t budget = DEFAULT_TILE_CACHE_BUDGET);
+
+	/// <summary>
+	/// Opens the passed tile file, dropping every resident tile.
+	/// </summary>
+	/// <param name="path">The file path</param>
+	/// <returns>Whether the file was opened</returns>
+	const bool Open(const char* path);
+
+	/// <summary>
+	/// Finds the shortest path between the passed coordinates.
+	/// </summary>
+	/// <param name="startCoordinate">The starting world coordinate</param>
+	/// <param name="targetCoordinate">The target world coordinate</param>
+	/// <param name="context">The search context of the calling thread</param>
+	/// <param name="options">The budgets of the query</param>
+	/// <returns>The collection of waypoints</returns>
+	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, TiledContext& context, const SearchOptions& options = SearchOptions());
+
+	/// <summary>
+	/// Sets the maximum bytes of resident tiles, evicting any above it.
+	/// Tiles pinned by a running query stay alive until it ends.
+	/// </summary>
+	/// <param name="budget">The maximum bytes of resident tiles</param>
+	void SetBudget(size_t budget);
+
+	/// <summary>
+	/// Retrieves the counters of the tile cache.
+	/// </summary>
+	/// <returns>A tuple containing the resident bytes, resident tiles, hits and faults</returns>
+	const std::tuple<size_t, size_t, size_t, size_t> GetStats();
+
+	/// <summary>
+	/// Resets the hit and fault counters.
+	/// </summary>
+	void ResetStats();
+
+	/// <summary>
+	/// Retrieves the header of the tile file.
+	/// </summary>
+	/// <returns>The header</returns>
+	inline const TileFileHeader& GetHeader() const { return m_header; }
+
+private:
+
+	/// <summary>
+	/// The A* search over the cells of the tiles.
+	/// </summary>
+	/// <param name="start">The starting cell</param>
+	/// <param name="target">The target cell</param>
+	/// <param name="context">The search context</param>
+	/// <param name="budget">The budgets of the query</param>
+	/// <param name="closest">The expanded cell closest to the target</param>
+	/// <returns>Whether the target was reached</returns>
+	const bool Search(int64_t start, int64_t target, TiledContext& context, SearchBudget& budget, int64_t& closest);
+
+	/// <summary>
+	/// Retraces and simplifies the path from the passed end cell back to the start.
+	/// </summary>
+	/// <param name="start">The starting cell</param>
+	/// <param name="end">The end cell</param>
+	/// <param name="context">The search context</param>
+	/// <returns>The collection of waypoints</returns>
+	const std::vector<Vec3> RetracePath(int64_t start, int64_t end, TiledContext& context);
+
+	/// <summary>
+	/// Retrieves the cell at the estimated index to the passed world
+	/// coordinate, matching <see cref="Grid::GetIndex"/>.
+	/// </summary>
+	/// <param name="coordinate">The world coordinate</param>
+	/// <returns>The cell index (x + y * width)</returns>
+	const int64_t GetIndex(const Vec3& coordinate) const;
+
+	/// <summary>
+	/// Retrieves the passed tile, faulting it in when not resident.
+	/// </summary>
+	/// <param name="tile">The tile index</param>
+	/// <returns>The tile</returns>
+	std::shared_ptr<const GridTile> AcquireTile(int tile);
+
+	/// <summary>
+	/// Retrieves the tile holding the passed cell, pinning it in the context.
+	/// </summary>
+	/// <param name="context">The search context</param>
+	/// <param name="index">The cell index</param>
+	/// <param name="cell">The index of the cell within the tile</param>
+	/// <returns>The tile</returns>
+	inline const GridTile& GetTile(TiledContext& context, int64_t index, int& cell)
+	{
+		int x = (int)(index % m_header.width), y = (int)(index / m_header.width);
+		int size = m_header.tileSize;
+		int tile = x / size + (y / size) * m_header.tilesX;
+		cell = x % size + (y % size) * size;
+
+		std::pair<int, std::shared_ptr<const GridTile>>& slot = context.tiles[tile % TILED_CONTEXT_SLOTS];
+		if (slot.first != tile || !slot.second)
+		{
+			slot.first = tile;
+			slot.second = AcquireTile(tile);
+		}
+		return *slot.second;
+	}
+
+	/// <summary>
+	/// Unpins every tile held by the passed context.
+	/// </summary>
+	/// <param name="context">The search context</param>
+	void ReleaseTiles(TiledContext& context);
+
+	/// <summary>
+	/// Evicts the least recently used tiles above the budget.
+	/// </summary>
+	void Trim();
+};
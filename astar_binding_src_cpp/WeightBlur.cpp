@@ -0,0 +1,147 @@
+#include "pch.h"
+
+#include "WeightBlur.h"
+
+/// <summary>
+/// Runs the passed job for every chunk, across the pool when one is given.
+/// </summary>
+/// <param name="pool">The pool (null - calling thread only)</param>
+/// <param name="count">The number of chunks</param>
+/// <param name="job">The job run per chunk</param>
+static void RunChunks(ThreadPool* pool, int count, const std::function<void(int)>& job)
+{
+	if (pool != nullptr && count > 1)
+	{
+		pool->ParallelFor(count, job);
+		return;
+	}
+	for (int chunk = 0; chunk < count; chunk++)
+	{
+		job(chunk);
+	}
+}
+
+WeightBlur::WeightBlur()
+	: m_width(0), m_height(0), m_radius(-1), m_minX(INT_MAX), m_minY(INT_MAX), m_maxX(INT_MIN), m_maxY(INT_MIN),
+		m_regionX(0), m_regionY(0), m_regionWidth(0), m_regionHeight(0)
+{
+}
+
+void WeightBlur::Blur(const int* penalties, int width, int height, int radius, ThreadPool* pool)
+{
+	m_width = width;
+	m_height = height;
+	m_radius = std::max(radius, 0);
+	m_source.assign(penalties, penalties + (size_t)width * height);
+	m_minX = m_minY = INT_MAX;
+	m_maxX = m_maxY = INT_MIN;
+
+	m_regionWidth = m_regionHeight = 0;
+	if (width > 0 && height > 0)
+	{
+		BlurRegion(0, 0, width - 1, height - 1, pool);
+	}
+}
+
+const bool WeightBlur::Reblur(ThreadPool* pool)
+{
+	if (!IsDirty()) { return false; }
+
+	// Every cell within the kernel radius of an edit sees it
+	int minX = std::max(m_minX - m_radius, 0), minY = std::max(m_minY - m_radius, 0);
+	int maxX = std::min(m_maxX + m_radius, m_width - 1), maxY = std::min(m_maxY + m_radius, m_height - 1);
+	m_minX = m_minY = INT_MAX;
+	m_maxX = m_maxY = INT_MIN;
+
+	BlurRegion(minX, minY, maxX, maxY, pool);
+	return true;
+}
+
+void WeightBlur::Invalidate()
+{
+	m_radius = -1;
+	m_minX = m_minY = INT_MAX;
+	m_maxX = m_maxY = INT_MIN;
+	m_regionWidth = m_regionHeight = 0;
+	std::vector<int>().swap(m_source);
+	std::vector<int>().swap(m_rows);
+	std::vector<int>().swap(m_blurred);
+}
+
+void WeightBlur::BlurRegion(int minX, int minY, int maxX, int maxY, ThreadPool* pool)
+{
+	const int radius = m_radius;
+	const int width = maxX - minX + 1, height = maxY - minY + 1;
+	const int span = width + 2 * radius;
+	const float area = (float)((radius * 2 + 1) * (radius * 2 + 1));
+
+	// Rows of the source the vertical pass reads, edges repeated past the grid
+	const int firstRow = std::max(minY - radius, 0), lastRow = std::min(maxY + radius, m_height - 1);
+	const int rows = lastRow - firstRow + 1;
+
+	m_regionX = minX;
+	m_regionY = minY;
+	m_regionWidth = width;
+	m_regionHeight = height;
+	m_rows.resize((size_t)rows * width);
+	m_blurred.resize((size_t)width * height);
+
+	// Horizontal pass, each row summed through its prefix sums so the
+	// window sums are a single subtraction per cell
+	RunChunks(pool, (rows + BLUR_CHUNK - 1) / BLUR_CHUNK, [&](int chunk)
+	{
+		std::vector<int> prefix(span + 1, 0);
+		for (int row = chunk * BLUR_CHUNK; row < std::min((chunk + 1) * BLUR_CHUNK, rows); row++)
+		{
+			const int* source = &m_source[(size_t)(firstRow + row) * m_width];
+			for (int i = 0; i < span; i++)
+			{
+				prefix[i + 1] = prefix[i] + source[std::min(std::max(minX - radius + i, 0), m_width - 1)];
+			}
+
+			int* sums = &m_rows[(size_t)row * width];
+			const int* lower = prefix.data();
+			const int* upper = prefix.data() + 2 * radius + 1;
+			for (int x = 0; x < width; x++)
+			{
+				sums[x] = upper[x] - lower[x];
+			}
+		}
+	});
+
+	// Vertical pass, a running window sum per column slid down strips of columns
+	RunChunks(pool, (width + BLUR_CHUNK - 1) / BLUR_CHUNK, [&](int chunk)
+	{
+		const int begin = chunk * BLUR_CHUNK, count = std::min(BLUR_CHUNK, width - begin);
+		auto rowAt = [&](int y) { return &m_rows[(size_t)(std::min(std::max(y, 0), m_height - 1) - firstRow) * width + begin]; };
+
+		int window[BLUR_CHUNK] = {};
+		for (int y = minY - radius; y <= minY + radius; y++)
+		{
+			const int* added = rowAt(y);
+			for (int x = 0; x < count; x++)
+			{
+				window[x] += added[x];
+			}
+		}
+
+		for (int y = minY; y <= maxY; y++)
+		{
+			if (y > minY)
+			{
+				const int* added = rowAt(y + radius);
+				const int* removed = rowAt(y - radius - 1);
+				for (int x = 0; x < count; x++)
+				{
+					window[x] += added[x] - removed[x];
+				}
+			}
+
+			int* blurred = &m_blurred[(size_t)(y - minY) * width + begin];
+			for (int x = 0; x < count; x++)
+			{
+				blurred[x] = (int)std::round(window[x] / area);
+			}
+		}
+	});
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "pch.h"
+#include "ThreadPool.h"
+
+// Rows or columns of a blur handed to a worker at once
+#define BLUR_CHUNK 64
+
+/// <summary>
+/// Class representing the box blur of the movement penalties of a grid.
+/// The blur runs as two separable passes of running sums over a compact
+/// row-major penalty array, rows split across threads for the horizontal
+/// pass and column strips for the vertical one, each inner loop a straight
+/// pass over contiguous integers the compiler vectorises. The penalties as
+/// they were before blurring are kept, with edits applied as they come in,
+/// so an edit only re-blurs its rectangle grown by the kernel radius.
+/// </summary>
+class WeightBlur
+{
+private:
+	int m_width, m_height;
+
+	// Kernel radius of the last blur (-1 - not blurred)
+	int m_radius;
+
+	// Penalties before blurring (x + y * width), edits applied
+	std::vector<int> m_source;
+
+	// Cells edited since the last blur (empty while minX > maxX)
+	int m_minX, m_minY, m_maxX, m_maxY;
+
+	// Rectangle written by the last blur, its horizontal sums and blurred penalties
+	int m_regionX, m_regionY, m_regionWidth, m_regionHeight;
+	std::vector<int> m_rows;
+	std::vector<int> m_blurred;
+
+public:
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="WeightBlur"/> class.
+	/// </summary>
+	WeightBlur();
+
+	/// <summary>
+	/// Blurs every cell of the passed penalties, keeping them as
+	/// the source of later re-blurs.
+	/// </summary>
+	/// <param name="penalties">The penalties (x + y * width)</param>
+	/// <param name="width">The width of the grid</param>
+	/// <param name="height">The height of the grid</param>
+	/// <param name="radius">The kernel radius</param>
+	/// <param name="pool">The pool to spread the passes across (null - calling thread only)</param>
+	void Blur(const int* penalties, int width, int height, int radius, ThreadPool* pool);
+
+	/// <summary>
+	/// Re-blurs the cells affected by the edits since the last blur.
+	/// </summary>
+	/// <param name="pool">The pool to spread the passes across (null - calling thread only)</param>
+	/// <returns>Whether anything was re-blurred</returns>
+	const bool Reblur(ThreadPool* pool);
+
+	/// <summary>
+	/// Records the unblurred penalty of an edited cell.
+	/// </summary>
+	/// <param name="x">The x grid coordinate</param>
+	/// <param name="y">The y grid coordinate</param>
+	/// <param name="penalty">The movement penalty</param>
+	inline void Update(int x, int y, int penalty)
+	{
+		if (m_radius < 0) { return; }
+
+		m_source[x + y * m_width] = penalty;
+		m_minX = std::min(m_minX, x);
+		m_minY = std::min(m_minY, y);
+		m_maxX = std::max(m_maxX, x);
+		m_maxY = std::max(m_maxY, y);
+	}
+
+	/// <summary>
+	/// Forgets the unblurred penalties, the grid having been replaced.
+	/// </summary>
+	void Invalidate();
+
+	/// <summary>
+	/// Determines whether cells were edited since the last blur.
+	/// </summary>
+	/// <returns>Whether a re-blur is pending</returns>
+	inline const bool IsDirty() const { return m_radius >= 0 && m_minX <= m_maxX; }
+
+	/// <summary>
+	/// Retrieves the rectangle written by the last blur.
+	/// </summary>
+	/// <returns>A tuple containing the minimum x, minimum y, maximum x and maximum y</returns>
+	inline const std::tuple<int, int, int, int> GetRegion() const
+	{
+		return std::make_tuple(m_regionX, m_regionY, m_regionX + m_regionWidth - 1, m_regionY + m_regionHeight - 1);
+	}
+
+	/// <summary>
+	/// Retrieves the blurred penalty of a cell within the rectangle written by the last blur.
+	/// </summary>
+	/// <param name="x">The x grid coordinate</param>
+	/// <param name="y">The y grid coordinate</param>
+	/// <returns>The blurred movement penalty</returns>
+	inline const int GetBlurred(int x, int y) const { return m_blurred[(x - m_regionX) + (y - m_regionY) * m_regionWidth]; }
+
+private:
+
+	/// <summary>
+	/// Blurs the cells within the passed rectangle from the source penalties.
+	/// </summary>
+	/// <param name="minX">The minimum x grid coordinate</param>
+	/// <param name="minY">The minimum y grid coordinate</param>
+	/// <param name="maxX">The maximum x grid coordinate</param>
+	/// <param name="maxY">The maximum y grid coordinate</param>
+	/// <param name="pool">The pool to spread the passes across (null - calling thread only)</param>
+	void BlurRegion(int minX, int minY, int maxX, int maxY, ThreadPool* pool);
+};
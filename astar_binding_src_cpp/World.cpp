@@ -0,0 +1,293 @@
+#include "pch.h"
+
+#include "World.h"
+
+World::World(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset)
+	: m_astar(gridSize, minPenalty, maxPenalty, worldOffset)
+{
+}
+
+World::World(float* points, int d1)
+	: m_astar(points, d1)
+{
+}
+
+void World::SetUp(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset)
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	OpenList openList = m_astar.GetOpenList();
+	int landmarks = m_astar.GetLandmarkCount();
+	m_astar = AStar(gridSize, minPenalty, maxPenalty, worldOffset);
+	m_cache.Clear();
+	m_astar.SetOpenList(openList);
+	m_astar.SetLandmarkCount(landmarks);
+}
+
+void World::Import(float* points, int d1)
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	OpenList openList = m_astar.GetOpenList();
+	int landmarks = m_astar.GetLandmarkCount();
+	m_astar = AStar(points, d1);
+	m_cache.Clear();
+	m_astar.SetOpenList(openList);
+	m_astar.SetLandmarkCount(landmarks);
+}
+
+const bool World::ImportSnapshot(const uint8_t* data, size_t size)
+{
+	// Validation reads only the passed bytes, so it runs before taking the lock
+	GridSnapshot snapshot(data, size);
+	if (!snapshot.IsValid()) { return false; }
+
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	OpenList openList = m_astar.GetOpenList();
+	int landmarks = m_astar.GetLandmarkCount();
+	m_astar = AStar(snapshot);
+	m_cache.Clear();
+	m_astar.SetOpenList(openList);
+	m_astar.SetLandmarkCount(landmarks);
+	return true;
+}
+
+void World::Clear()
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	m_astar.Clear();
+	m_cache.Clear();
+}
+
+void World::AddGridPoint(PathPoint point)
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	m_astar.AddGridPoint(point);
+}
+
+void World::AddGridPoints(float* points, int d1)
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	m_astar.AddGridPoints(points, d1);
+}
+
+void World::SetOpenList(OpenList type)
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	m_astar.SetOpenList(type);
+}
+
+const std::tuple<int, int> World::BlurWeights(int size, ThreadPool* pool)
+{
+	// The pool may be running queries on this world that wait for the gate, so
+	// the blur runs into scratch with no lock held and is only swapped in after
+	std::vector<int> penalties;
+	int width, height;
+	unsigned int version;
+	{
+		std::shared_lock<std::shared_mutex> lock = ReadLock();
+		CompactGrid& grid = m_astar.GetGrid();
+		width = (int)grid.GetWidth();
+		height = (int)grid.GetHeight();
+		penalties.assign(m_astar.GetCells().GetPenalties(), m_astar.GetCells().GetPenalties() + grid.GetSize());
+		version = m_astar.GetVersion();
+	}
+	WeightBlur blur;
+	blur.Blur(penalties.data(), width, height, size, pool);
+
+	// A grid edited meanwhile is blurred again on the calling thread
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	if (m_astar.GetVersion() != version) { return m_astar.BlurWeights(size); }
+	return m_astar.AdoptBlur(blur);
+}
+
+const std::tuple<int, int> World::ReblurWeights(ThreadPool* pool)
+{
+	// Re-blurred on a copy of the blur with no lock held, as a blur of every cell
+	WeightBlur blur;
+	unsigned int version;
+	{
+		std::shared_lock<std::shared_mutex> lock = ReadLock();
+		if (m_astar.GetBlur().IsDirty())
+		{
+			blur = m_astar.GetBlur();
+		}
+		version = m_astar.GetVersion();
+	}
+	bool reblurred = blur.Reblur(pool);
+
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	if (!reblurred || m_astar.GetVersion() != version) { return m_astar.ReblurWeights(); }
+	return m_astar.AdoptReblur(blur);
+}
+
+PathPoint World::GetGridPoint(Vec3 coordinate)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	return m_astar.GetGridPoint(coordinate);
+}
+
+PathPoint World::GetGridPoint(unsigned xGrid, unsigned yGrid)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	return m_astar.GetGridPoint(xGrid, yGrid);
+}
+
+std::vector<PathPoint> World::GetNearestNeighbors(const Vec3& coordinate)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	return m_astar.GetNearestNeighbors(coordinate);
+}
+
+const std::vector<Vec3> World::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SearchContext& context, const SearchOptions& options)
+{
+	std::shared_lock<std::shared_mutex> lock = PreparedLock(flags);
+
+	// Approximate paths depend on their options, so they are never cached
+	if (flags & (SEARCH_WEIGHTED | SEARCH_ANYTIME))
+	{
+		return m_astar.FindPath(startCoordinate, targetCoordinate, flags, context, options);
+	}
+
+	CompactGrid& grid = m_astar.GetGrid();
+	int start = grid.GetIndex(startCoordinate);
+	int target = grid.GetIndex(targetCoordinate);
+
+	std::vector<Vec3> waypoints;
+	if (m_cache.Find(m_astar, start, target, flags, waypoints, context.cells))
+	{
+		context.expansions = 0;
+		context.bound = (flags & SEARCH_HIERARCHICAL) ? 0.0f : 1.0f;
+		context.partial = false;
+		return waypoints;
+	}
+
+	// Paths cut short by a budget are kept out of the cache, so a later
+	// query with a larger budget searches again
+	waypoints = m_astar.FindPath(startCoordinate, targetCoordinate, flags, context, options);
+	bool complete = !context.partial && (context.bound == 1.0f || (flags & SEARCH_HIERARCHICAL));
+	if (!waypoints.empty() && complete)
+	{
+		m_cache.Insert(m_astar, start, target, flags, waypoints, context.cells);
+	}
+	return waypoints;
+}
+
+const bool World::IsReachable(const Vec3& startCoordinate, const Vec3& targetCoordinate)
+{
+	std::shared_lock<std::shared_mutex> lock = PreparedLock(SEARCH_DEFAULT);
+	return m_astar.IsReachable(startCoordinate, targetCoordinate);
+}
+
+const std::vector<Vec3> World::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, IncrementalPlanner& planner)
+{
+	std::shared_lock<std::shared_mutex> lock = PreparedLock(SEARCH_DEFAULT);
+	return m_astar.FindPath(startCoordinate, targetCoordinate, planner);
+}
+
+void World::StartSearch(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SteppedSearch& search, float weight)
+{
+	std::shared_lock<std::shared_mutex> lock = PreparedLock(flags);
+	m_astar.StartSearch(startCoordinate, targetCoordinate, flags, search, weight);
+}
+
+const SearchStatus World::StepSearch(SteppedSearch& search, int maxExpansions, int maxMicroseconds)
+{
+	std::shared_lock<std::shared_mutex> lock = PreparedLock(search.flags);
+	return m_astar.StepSearch(search, maxExpansions, maxMicroseconds);
+}
+
+const std::vector<Vec3> World::GetSearchResult(SteppedSearch& search)
+{
+	std::shared_lock<std::shared_mutex> lock = PreparedLock(search.flags);
+	return m_astar.GetSearchResult(search);
+}
+
+void World::SetPathCacheCapacity(size_t capacity)
+{
+	m_cache.SetCapacity(capacity);
+}
+
+const std::tuple<size_t, size_t, size_t> World::GetPathCacheStats()
+{
+	return m_cache.GetStats();
+}
+
+void World::ResetPathCacheStats()
+{
+	m_cache.ResetStats();
+}
+
+void World::SetLandmarkCount(int count)
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::unique_lock<std::shared_mutex> lock(m_lock);
+	m_astar.SetLandmarkCount(count);
+	m_astar.Prepare(SEARCH_DEFAULT);
+}
+
+const std::tuple<int, size_t, double> World::GetLandmarkStats()
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	return m_astar.GetLandmarkStats();
+}
+
+void World::ComputeFlowField(FlowField& field, const Vec3& targetCoordinate)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	field.Compute(m_astar, m_astar.GetGrid().GetIndex(targetCoordinate));
+}
+
+const bool World::GetFlowStep(const FlowField& field, const Vec3& coordinate, Vec3& next)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	CompactGrid& grid = m_astar.GetGrid();
+	if (field.GetVersion() != m_astar.GetVersion()) { return false; }
+
+	int index = field.GetNext(grid.GetIndex(coordinate));
+	if (index < 0) { return false; }
+
+	next = grid.GetPosition(index);
+	return true;
+}
+
+const std::tuple<std::vector<PathPoint>, Vec3, int, int, int, int> World::ExportGrid()
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	return m_astar.ExportGrid();
+}
+
+void World::ExportSnapshot(std::vector<uint8_t>& data)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	m_astar.ExportSnapshot(data);
+}
+
+const bool World::ExportTiles(const char* path, int tileSize)
+{
+	std::shared_lock<std::shared_mutex> lock = ReadLock();
+	return m_astar.ExportTiles(path, tileSize);
+}
+
+std::shared_lock<std::shared_mutex> World::PreparedLock(int flags)
+{
+	// The first query after an edit rebuilds the lazy search structures,
+	// every later query holding the shared lock finds them prepared
+	std::lock_guard<std::mutex> gate(m_gate);
+	std::shared_lock<std::shared_mutex> lock(m_lock);
+	m_astar.Prepare(flags);
+	return lock;
+}
+
+std::shared_lock<std::shared_mutex> World::ReadLock()
+{
+	std::lock_guard<std::mutex> gate(m_gate);
+	return std::shared_lock<std::shared_mutex>(m_lock);
+}
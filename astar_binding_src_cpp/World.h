@@ -0,0 +1,281 @@
+#pragma once
+
+#include "pch.h"
+#include "AStar.h"
+#include "SearchContext.h"
+#include "FlowField.h"
+#include "PathCache.h"
+
+/// <summary>
+/// Class representing a shareable pathfinding world - a grid and its
+/// search structures guarded by a reader/writer lock. Path queries hold
+/// the shared lock and write only into the caller's <see cref="SearchContext"/>,
+/// so they run concurrently. Grid edits hold the exclusive lock. Found
+/// paths are kept in a <see cref="PathCache"/> until their tiles are edited.
+/// </summary>
+class World
+{
+private:
+	AStar m_astar;
+	PathCache m_cache;
+	std::shared_mutex m_lock;
+
+	// Taken briefly by readers before the shared lock and held by writers,
+	// so a waiting edit is not starved by a stream of queries. Also guards
+	// the lazy rebuild of the search structures.
+	std::mutex m_gate;
+
+public:
+
+	// Prevent copying, the locks are owned by the world
+	World(const World&) = delete;
+	void operator = (const World&) = delete;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="World"/> class.
+	/// </summary>
+	/// <param name="gridSize">The grid size</param>
+	/// <param name="minPenalty">The minimum movement penalty</param>
+	/// <param name="maxPenalty">The maximum movement penalty</param>
+	/// <param name="worldOffset">The world offset</param>
+	World(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset);
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="World"/> class
+	/// from an exported grid.
+	/// </summary>
+	/// <param name="points">The collection of values making up the grid</param>
+	/// <param name="d1">The dimension of the collection</param>
+	World(float* points, int d1);
+
+	/// <summary>
+	/// Replaces the grid with an empty grid of the passed variables.
+	/// </summary>
+	/// <param name="gridSize">The grid size</param>
+	/// <param name="minPenalty">The minimum movement penalty</param>
+	/// <param name="maxPenalty">The maximum movement penalty</param>
+	/// <param name="worldOffset">The world offset</param>
+	void SetUp(Vec2 gridSize, int minPenalty, int maxPenalty, Vec3 worldOffset);
+
+	/// <summary>
+	/// Replaces the grid with the passed exported grid.
+	/// </summary>
+	/// <param name="points">The collection of values making up the grid</param>
+	/// <param name="d1">The dimension of the collection</param>
+	void Import(float* points, int d1);
+
+	/// <summary>
+	/// Replaces the grid with the passed binary snapshot.
+	/// </summary>
+	/// <param name="data">The snapshot bytes</param>
+	/// <param name="size">The number of bytes</param>
+	/// <returns>Whether the snapshot was valid and loaded</returns>
+	const bool ImportSnapshot(const uint8_t* data, size_t size);
+
+	/// <summary>
+	/// Clears the grid.
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Adds a grid point to the grid.
+	/// </summary>
+	/// <param name="point">The point to add</param>
+	void AddGridPoint(PathPoint point);
+
+	/// <summary>
+	/// Adds a collection of grid points to the grid.
+	/// </summary>
+	/// <param name="points">The collection of points to add</param>
+	/// <param name="d1">The dimension of the collection</param>
+	void AddGridPoints(float* points, int d1);
+
+	/// <summary>
+	/// Selects the open list implementation utilized by the search.
+	/// </summary>
+	/// <param name="type">The open list implementation</param>
+	void SetOpenList(OpenList type);
+
+	/// <summary>
+	/// Blurs the weight map of the grid. The blur runs without holding the
+	/// locks of the world, so the pool may be running queries on it.
+	/// </summary>
+	/// <param name="size">The blur window size</param>
+	/// <param name="pool">The pool to spread the blur across (null - calling thread only)</param>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> BlurWeights(int size, ThreadPool* pool = nullptr);
+
+	/// <summary>
+	/// Re-blurs the weight map around the cells edited since the last blur,
+	/// without holding the locks of the world like <see cref="BlurWeights"/>.
+	/// </summary>
+	/// <param name="pool">The pool to spread the blur across (null - calling thread only)</param>
+	/// <returns>The new minimum and maximum movement penalty</returns>
+	const std::tuple<int, int> ReblurWeights(ThreadPool* pool = nullptr);
+
+	/// <summary>
+	/// Retrieves the grid point closest to the passed world coordinate.
+	/// </summary>
+	/// <param name="coordinate">The world coordinate</param>
+	/// <returns>The grid point closest to the coordinate</returns>
+	PathPoint GetGridPoint(Vec3 coordinate);
+
+	/// <summary>
+	/// Retrieves the grid point at the passed grid coordinates.
+	/// </summary>
+	/// <param name="xGrid">X grid coordinate</param>
+	/// <param name="yGrid">Y grid coordinate</param>
+	/// <returns>The grid point at the passed grid coordinate</returns>
+	PathPoint GetGridPoint(unsigned xGrid, unsigned yGrid);
+
+	/// <summary>
+	/// Retrieves the nearest neighbors to the passed coordinate.
+	/// </summary>
+	/// <param name="coordinate">The coordinate</param>
+	/// <returns>A collection of points near the coordinate</returns>
+	std::vector<PathPoint> GetNearestNeighbors(const Vec3& coordinate);
+
+	/// <summary>
+	/// Finds the shortest path from the passed starting coordinate to the
+	/// passed target coordinate. Safe to call concurrently with distinct contexts.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="context">The search context owned by the calling thread</param>
+	/// <param name="options">The weight, time limit and budgets of the search</param>
+	/// <returns>The collection of the points outlining the shortest path</returns>
+	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SearchContext& context, const SearchOptions& options = SearchOptions());
+
+	/// <summary>
+	/// Determines whether a path from the passed starting coordinate to the
+	/// passed target coordinate exists, in constant time.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <returns>Whether a path exists</returns>
+	const bool IsReachable(const Vec3& startCoordinate, const Vec3& targetCoordinate);
+
+	/// <summary>
+	/// Finds the shortest path from the passed starting coordinate to the
+	/// passed target coordinate, repairing the previous search of the passed
+	/// planner. Safe to call concurrently with distinct planners.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="planner">The incremental planner of the agent</param>
+	/// <returns>The collection of the points outlining the shortest path</returns>
+	const std::vector<Vec3> FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, IncrementalPlanner& planner);
+
+	/// <summary>
+	/// Starts a search from the passed starting coordinate to the passed target
+	/// coordinate, expanded by later calls to <see cref="StepSearch"/>.
+	/// </summary>
+	/// <param name="startCoordinate">The starting coordinate</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	/// <param name="flags">The <see cref="SearchFlags"/> selecting the search mode</param>
+	/// <param name="search">The search to start</param>
+	/// <param name="weight">The heuristic weight of a weighted search</param>
+	void StartSearch(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SteppedSearch& search, float weight = DEFAULT_SEARCH_WEIGHT);
+
+	/// <summary>
+	/// Continues the passed search within the passed step budgets. The lock is
+	/// only held for the step, so edits may land between steps.
+	/// </summary>
+	/// <param name="search">The started search</param>
+	/// <param name="maxExpansions">The maximum number of cells expanded by this step (0 - unlimited)</param>
+	/// <param name="maxMicroseconds">The maximum time spent by this step (microseconds, 0 - unlimited)</param>
+	/// <returns>The status of the search</returns>
+	const SearchStatus StepSearch(SteppedSearch& search, int maxExpansions, int maxMicroseconds = 0);
+
+	/// <summary>
+	/// Retrieves the path found by the passed search, or the path towards the
+	/// target found so far while it is still running.
+	/// </summary>
+	/// <param name="search">The started search</param>
+	/// <returns>The collection of the points outlining the path</returns>
+	const std::vector<Vec3> GetSearchResult(SteppedSearch& search);
+
+	/// <summary>
+	/// Sets the maximum number of paths kept by the path cache.
+	/// </summary>
+	/// <param name="capacity">The maximum number of cached paths (0 - disabled)</param>
+	void SetPathCacheCapacity(size_t capacity);
+
+	/// <summary>
+	/// Retrieves the counters of the path cache.
+	/// </summary>
+	/// <returns>A tuple containing the hits, misses and cached paths</returns>
+	const std::tuple<size_t, size_t, size_t> GetPathCacheStats();
+
+	/// <summary>
+	/// Resets the hit and miss counters of the path cache.
+	/// </summary>
+	void ResetPathCacheStats();
+
+	/// <summary>
+	/// Sets the number of landmarks tightening the search heuristic and
+	/// builds their distance tables, rebuilt lazily after every edit.
+	/// </summary>
+	/// <param name="count">The number of landmarks (0 - disabled)</param>
+	void SetLandmarkCount(int count);
+
+	/// <summary>
+	/// Retrieves the size and build time of the landmark distance tables.
+	/// </summary>
+	/// <returns>A tuple containing the landmarks, bytes held and preprocessing milliseconds</returns>
+	const std::tuple<int, size_t, double> GetLandmarkStats();
+
+	/// <summary>
+	/// Computes the passed flow field towards the passed target coordinate.
+	/// </summary>
+	/// <param name="field">The flow field to compute</param>
+	/// <param name="targetCoordinate">The target coordinate</param>
+	void ComputeFlowField(FlowField& field, const Vec3& targetCoordinate);
+
+	/// <summary>
+	/// Retrieves the position of the next cell along the passed flow field.
+	/// </summary>
+	/// <param name="field">The computed flow field</param>
+	/// <param name="coordinate">The current coordinate</param>
+	/// <param name="next">The position of the next cell</param>
+	/// <returns>Whether a next cell exists</returns>
+	const bool GetFlowStep(const FlowField& field, const Vec3& coordinate, Vec3& next);
+
+	/// <summary>
+	/// Exports the grid.
+	/// </summary>
+	/// <returns>A tuple containing the points and necessary information
+	///			 for reconstructing the grid</returns>
+	const std::tuple<std::vector<PathPoint>, Vec3, int, int, int, int> ExportGrid();
+
+	/// <summary>
+	/// Writes a binary snapshot of the grid.
+	/// </summary>
+	/// <param name="data">The bytes to replace with the snapshot</param>
+	void ExportSnapshot(std::vector<uint8_t>& data);
+
+	/// <summary>
+	/// Writes the grid into a new tile file.
+	/// </summary>
+	/// <param name="path">The file path</param>
+	/// <param name="tileSize">The cells per tile side</param>
+	/// <returns>Whether every tile was written</returns>
+	const bool ExportTiles(const char* path, int tileSize);
+
+private:
+
+	/// <summary>
+	/// Acquires the shared lock behind any waiting writer.
+	/// </summary>
+	/// <returns>The held shared lock</returns>
+	std::shared_lock<std::shared_mutex> ReadLock();
+
+	/// <summary>
+	/// Acquires the shared lock behind any waiting writer, after preparing
+	/// the search structures required by the passed flags.
+	/// </summary>
+	/// <param name="flags">The <see cref="SearchFlags"/> of the query</param>
+	/// <returns>The held shared lock</returns>
+	std::shared_lock<std::shared_mutex> PreparedLock(int flags);
+};
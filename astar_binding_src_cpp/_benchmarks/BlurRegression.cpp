@@ -0,0 +1,115 @@
+// BlurRegression.cpp : Checks that blurring a world never deadlocks with a path batch on the same pool.
+
+#include "../pch.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include "../World.h"
+#include "../ThreadPool.h"
+
+/// <summary>
+/// Grid size, penalty range and blur window of the checked world, large
+/// enough for the blur to split into chunks across the pool.
+/// </summary>
+#define REGRESSION_SIZE 256
+#define REGRESSION_MIN_PENALTY 3
+#define REGRESSION_MAX_PENALTY 20
+#define REGRESSION_BLUR 3
+
+/// <summary>
+/// Number of path batches, the paths per batch, and the seconds
+/// they may take before the run is reported as deadlocked.
+/// </summary>
+#define REGRESSION_BATCHES 5
+#define REGRESSION_PATHS 400
+#define REGRESSION_TIMEOUT 60
+
+/// <summary>
+/// Converts the passed grid coordinate into its world coordinate.
+/// </summary>
+/// <param name="x">The x grid coordinate</param>
+/// <param name="y">The y grid coordinate</param>
+/// <returns>The world coordinate</returns>
+Vec3 ToWorld(int x, int y)
+{
+	return Vec3(x - (REGRESSION_SIZE / 2.0f) + 0.5f, 0, y - (REGRESSION_SIZE / 2.0f) + 0.5f);
+}
+
+int main()
+{
+	std::mt19937 random(1234);
+	World world(Vec2(REGRESSION_SIZE, REGRESSION_SIZE), REGRESSION_MIN_PENALTY, REGRESSION_MAX_PENALTY, Vec3());
+
+	// Packed as the count followed by (gridX, gridY, x, y, z, walkable, penalty) per point
+	std::vector<float> points(1 + REGRESSION_SIZE * REGRESSION_SIZE * 7);
+	points[0] = (float)points.size();
+	for (int y = 0; y < REGRESSION_SIZE; y++)
+	{
+		for (int x = 0; x < REGRESSION_SIZE; x++)
+		{
+			Vec3 position = ToWorld(x, y);
+			float penalty = (float)(REGRESSION_MIN_PENALTY + random() % (REGRESSION_MAX_PENALTY - REGRESSION_MIN_PENALTY + 1));
+			float values[7] = { (float)x, (float)y, position.x, position.y, position.z, random() % 8 != 0 ? 1.0f : 0.0f, penalty };
+			std::copy(values, values + 7, &points[1 + (x + y * REGRESSION_SIZE) * 7]);
+		}
+	}
+	world.AddGridPoints(points.data(), (int)points.size());
+
+	// Give up on the run if the batches and blurs stop making progress
+	std::atomic<bool> finished(false);
+	std::thread watchdog([&]()
+	{
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(REGRESSION_TIMEOUT);
+		while (!finished && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		}
+		if (!finished)
+		{
+			std::cout << "no progress within " << REGRESSION_TIMEOUT << " seconds, blur and path batch deadlocked" << std::endl;
+			std::_Exit(1);
+		}
+	});
+
+	// Blurs keep running on the shared pool while it runs the path batches
+	ThreadPool pool;
+	std::atomic<bool> batching(true);
+	std::atomic<int> blurs(0);
+	std::thread blurring([&]()
+	{
+		while (batching)
+		{
+			world.BlurWeights(REGRESSION_BLUR, &pool);
+			blurs++;
+		}
+	});
+
+	int found = 0;
+	for (int batch = 0; batch < REGRESSION_BATCHES; batch++)
+	{
+		std::vector<int> lengths(REGRESSION_PATHS);
+		pool.ParallelFor(REGRESSION_PATHS, [&](int i)
+		{
+			std::mt19937 query(batch * REGRESSION_PATHS + i);
+			SearchContext context;
+			Vec3 start = ToWorld(query() % REGRESSION_SIZE, query() % REGRESSION_SIZE);
+			Vec3 target = ToWorld(query() % REGRESSION_SIZE, query() % REGRESSION_SIZE);
+			lengths[i] = (int)world.FindPath(start, target, SEARCH_DEFAULT, context).size();
+		});
+		for (int length : lengths)
+		{
+			found += length > 0 ? 1 : 0;
+		}
+	}
+
+	batching = false;
+	blurring.join();
+	finished = true;
+	watchdog.join();
+
+	std::cout << REGRESSION_BATCHES * REGRESSION_PATHS << " paths (" << found << " found) alongside " << blurs << " blurs" << std::endl;
+	return blurs > 0 ? 0 : 1;
+}
@@ -0,0 +1,741 @@
+// GridBenchmark.cpp : Benchmarks every search mode of the grid engine on standard and synthetic maps.
+//
+// Worlds are loaded from MovingAI .map files, queried with the problems of their .scen files, or
+// generated as an open field, random obstacles, a maze and weighted terrain mimicking the terrain
+// types of the grid scene. Every algorithm answers the same queries, reporting its expansions,
+// latency percentiles, throughput and path cost against plain A*, as a table and optionally as JSON
+// so results can be compared between releases. Built on Linux by the Makefile next to this file.
+//
+// Usage: GridBenchmark [--map file.map [--scen file.scen]]... [--synthetic] [--size n] [--queries n]
+//                      [--seed n] [--landmarks n] [--algorithms a,b,...] [--json file]
+
+#include "../pch.h"
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "../AStar.h"
+
+// Version of the JSON report, raised whenever a field changes meaning
+#define REPORT_SCHEMA 1
+
+/// <summary>
+/// Movement penalties mirroring the terrain types of the grid scene,
+/// a negative penalty marks unwalkable terrain (rock and water).
+/// </summary>
+static const int TerrainPenalties[] = { 8, 8, 8, 3, 20, 20, -1, -1 };
+
+/// <summary>
+/// Movement penalties of the passable MovingAI tiles, plain ground and swamp.
+/// Trees, water and out of bounds tiles are unwalkable.
+/// </summary>
+static const int GroundPenalty = 0;
+static const int SwampPenalty = 20;
+
+/// <summary>
+/// Struct representing a search mode under test.
+/// </summary>
+struct Algorithm
+{
+	const char* name;
+	int flags;
+	OpenList openList;
+};
+
+static const Algorithm Algorithms[] =
+{
+	{ "astar", SEARCH_DEFAULT, OpenList::BinaryHeap },
+	{ "astar-buckets", SEARCH_DEFAULT, OpenList::Buckets },
+	{ "jps", SEARCH_JUMP_POINT, OpenList::BinaryHeap },
+	{ "bidirectional", SEARCH_BIDIRECTIONAL, OpenList::BinaryHeap },
+	{ "hierarchical", SEARCH_HIERARCHICAL, OpenList::BinaryHeap },
+	{ "weighted", SEARCH_WEIGHTED, OpenList::BinaryHeap },
+	{ "anytime", SEARCH_ANYTIME, OpenList::BinaryHeap }
+};
+
+/// <summary>
+/// Struct representing a path problem in grid coordinates.
+/// </summary>
+struct Query
+{
+	int startX, startY;
+	int targetX, targetY;
+
+	// Optimal octile length given by the scenario (-1 - unknown), not compared
+	// against since the engine prices steps by penalty and 3D distance
+	double optimal;
+};
+
+/// <summary>
+/// Struct representing a world under test, a penalty per cell in
+/// row-major order (x + y * width), negative where unwalkable.
+/// </summary>
+struct Terrain
+{
+	std::string name;
+	std::string source;
+	int width = 0, height = 0;
+	std::vector<int> penalties;
+	std::vector<Query> queries;
+};
+
+/// <summary>
+/// Struct representing the measurements of one algorithm on one world.
+/// </summary>
+struct Result
+{
+	const Algorithm* algorithm;
+	int solved = 0, partial = 0;
+	std::vector<double> latencies;
+	std::vector<double> expansions;
+	std::vector<double> ratios;
+	double total = 0;
+};
+
+/// <summary>
+/// Struct representing the command line settings.
+/// </summary>
+struct Settings
+{
+	std::vector<std::pair<std::string, std::string>> maps;
+	bool synthetic = false;
+	int size = 256;
+	int queries = 200;
+	unsigned int seed = 1234;
+	int landmarks = 0;
+	std::vector<const Algorithm*> algorithms;
+	std::string json;
+};
+
+/// <summary>
+/// Converts the passed grid coordinate into its world coordinate.
+/// </summary>
+/// <param name="x">The x grid coordinate</param>
+/// <param name="y">The y grid coordinate</param>
+/// <param name="width">The grid width</param>
+/// <param name="height">The grid height</param>
+/// <returns>The world coordinate</returns>
+Vec3 ToWorld(int x, int y, int width, int height)
+{
+	return Vec3(x - (width / 2.0f) + 0.5f, 0, y - (height / 2.0f) + 0.5f);
+}
+
+/// <summary>
+/// Reads the value of a MovingAI header line.
+/// </summary>
+/// <param name="file">The map file</param>
+/// <param name="key">The expected key</param>
+/// <param name="value">The value read</param>
+/// <returns>Whether the line held the key</returns>
+bool ReadHeader(std::istream& file, const std::string& key, std::string& value)
+{
+	std::string read;
+	return (file >> read) && read == key && (key == "map" || (file >> value));
+}
+
+/// <summary>
+/// Loads a MovingAI .map file.
+/// </summary>
+/// <param name="path">The map file path</param>
+/// <param name="terrain">The terrain to load into</param>
+/// <returns>Whether the map was loaded</returns>
+bool LoadMap(const std::string& path, Terrain& terrain)
+{
+	std::ifstream file(path);
+	std::string type, height, width, unused;
+	if (!ReadHeader(file, "type", type) || !ReadHeader(file, "height", height)
+		|| !ReadHeader(file, "width", width) || !ReadHeader(file, "map", unused))
+	{
+		std::cerr << path << ": not a MovingAI map" << std::endl;
+		return false;
+	}
+
+	terrain.name = path.substr(path.find_last_of("/\\") + 1);
+	terrain.source = path;
+	terrain.width = std::stoi(width);
+	terrain.height = std::stoi(height);
+	terrain.penalties.assign((size_t)terrain.width * terrain.height, -1);
+	std::string row;
+	for (int y = 0; y < terrain.height; y++)
+	{
+		if (!(file >> row) || (int)row.size() < terrain.width)
+		{
+			std::cerr << path << ": row " << y << " is missing or short" << std::endl;
+			return false;
+		}
+		for (int x = 0; x < terrain.width; x++)
+		{
+			char tile = row[x];
+			int& penalty = terrain.penalties[x + (size_t)y * terrain.width];
+			penalty = tile == '.' || tile == 'G' ? GroundPenalty : tile == 'S' ? SwampPenalty : -1;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// Loads the problems of a MovingAI .scen file posed on the passed terrain,
+/// skipping those that do not fit it.
+/// </summary>
+/// <param name="path">The scenario file path</param>
+/// <param name="terrain">The terrain to add the queries to</param>
+/// <param name="limit">The maximum number of queries (0 - all)</param>
+/// <returns>Whether the scenario was read</returns>
+bool LoadScenario(const std::string& path, Terrain& terrain, int limit)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		std::cerr << path << ": cannot open scenario" << std::endl;
+		return false;
+	}
+
+	int skipped = 0;
+	std::string line;
+	while (std::getline(file, line) && (limit == 0 || (int)terrain.queries.size() < limit))
+	{
+		if (line.empty() || line.compare(0, 7, "version") == 0) { continue; }
+
+		std::istringstream fields(line);
+		int bucket, width, height;
+		std::string map;
+		Query query;
+		if (!(fields >> bucket >> map >> width >> height >> query.startX >> query.startY
+			>> query.targetX >> query.targetY >> query.optimal))
+		{
+			skipped++;
+			continue;
+		}
+
+		auto walkable = [&](int x, int y)
+		{
+			return x >= 0 && y >= 0 && x < terrain.width && y < terrain.height
+				&& terrain.penalties[x + (size_t)y * terrain.width] >= 0;
+		};
+		if (!walkable(query.startX, query.startY) || !walkable(query.targetX, query.targetY))
+		{
+			skipped++;
+			continue;
+		}
+		terrain.queries.push_back(query);
+	}
+	if (skipped > 0)
+	{
+		std::cerr << path << ": skipped " << skipped << " problems not fitting " << terrain.name << std::endl;
+	}
+	return true;
+}
+
+/// <summary>
+/// Generates an open field, every cell walkable at the same penalty.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <returns>The generated terrain</returns>
+Terrain GenerateOpen(int size)
+{
+	Terrain terrain;
+	terrain.name = "open";
+	terrain.width = terrain.height = size;
+	terrain.penalties.assign((size_t)size * size, GroundPenalty);
+	return terrain;
+}
+
+/// <summary>
+/// Generates a field with a quarter of its cells blocked at random.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <param name="random">The random generator</param>
+/// <returns>The generated terrain</returns>
+Terrain GenerateObstacles(int size, std::mt19937& random)
+{
+	Terrain terrain = GenerateOpen(size);
+	terrain.name = "obstacles";
+	for (int& penalty : terrain.penalties)
+	{
+		if (random() % 4 == 0) { penalty = -1; }
+	}
+	return terrain;
+}
+
+/// <summary>
+/// Generates a perfect maze of single cell corridors, carved by a
+/// randomised depth first walk over the cells of odd coordinates.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <param name="random">The random generator</param>
+/// <returns>The generated terrain</returns>
+Terrain GenerateMaze(int size, std::mt19937& random)
+{
+	Terrain terrain;
+	terrain.name = "maze";
+	terrain.width = terrain.height = size;
+	terrain.penalties.assign((size_t)size * size, -1);
+	auto at = [&](int x, int y) -> int& { return terrain.penalties[x + (size_t)y * size]; };
+
+	const int steps[4][2] = { { 2, 0 }, { -2, 0 }, { 0, 2 }, { 0, -2 } };
+	std::vector<std::pair<int, int>> stack = { { 1, 1 } };
+	at(1, 1) = GroundPenalty;
+	while (!stack.empty())
+	{
+		int x = stack.back().first, y = stack.back().second;
+		int options[4], count = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			int nx = x + steps[i][0], ny = y + steps[i][1];
+			if (nx > 0 && ny > 0 && nx < size - 1 && ny < size - 1 && at(nx, ny) < 0)
+			{
+				options[count++] = i;
+			}
+		}
+		if (count == 0)
+		{
+			stack.pop_back();
+			continue;
+		}
+
+		const int* step = steps[options[random() % count]];
+		at(x + step[0] / 2, y + step[1] / 2) = GroundPenalty;
+		at(x + step[0], y + step[1]) = GroundPenalty;
+		stack.push_back(std::make_pair(x + step[0], y + step[1]));
+	}
+	return terrain;
+}
+
+/// <summary>
+/// Generates weighted terrain, laid out in patches of the terrain types of
+/// the grid scene so that penalties vary the way they do in a real scene.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <param name="random">The random generator</param>
+/// <returns>The generated terrain</returns>
+Terrain GenerateWeighted(int size, std::mt19937& random)
+{
+	const int patch = 8;
+	const int patches = (size / patch) + 1;
+	std::vector<int> types;
+	for (int i = 0; i < patches * patches; i++)
+	{
+		types.push_back(TerrainPenalties[random() % 8]);
+	}
+
+	Terrain terrain;
+	terrain.name = "weighted";
+	terrain.width = terrain.height = size;
+	terrain.penalties.resize((size_t)size * size);
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			int penalty = types[(x / patch) + ((y / patch) * patches)];
+			terrain.penalties[x + (size_t)y * size] = penalty >= 0 && random() % 10 != 0 ? penalty : -1;
+		}
+	}
+	return terrain;
+}
+
+/// <summary>
+/// Builds the engine for the passed terrain in a single batch.
+/// </summary>
+/// <param name="terrain">The terrain</param>
+/// <returns>The built astar</returns>
+std::unique_ptr<AStar> Build(const Terrain& terrain)
+{
+	int minPenalty = INT_MAX, maxPenalty = 0;
+	for (int penalty : terrain.penalties)
+	{
+		if (penalty < 0) { continue; }
+		minPenalty = std::min(minPenalty, penalty);
+		maxPenalty = std::max(maxPenalty, penalty);
+	}
+	if (minPenalty > maxPenalty) { minPenalty = 0; }
+
+	std::unique_ptr<AStar> astar = std::make_unique<AStar>(Vec2(terrain.width, terrain.height), minPenalty, maxPenalty, Vec3());
+	std::vector<float> points;
+	points.reserve(terrain.penalties.size() * 7 + 1);
+	points.push_back(0);
+	for (int y = 0; y < terrain.height; y++)
+	{
+		for (int x = 0; x < terrain.width; x++)
+		{
+			int penalty = terrain.penalties[x + (size_t)y * terrain.width];
+			Vec3 world = ToWorld(x, y, terrain.width, terrain.height);
+			points.insert(points.end(), { (float)x, (float)y, world.x, world.y, world.z, (float)(penalty >= 0), (float)(penalty >= 0 ? penalty : maxPenalty) });
+		}
+	}
+	points[0] = (float)points.size();
+	astar->AddGridPoints(points.data(), (int)points.size());
+	return astar;
+}
+
+/// <summary>
+/// Poses random queries between connected walkable cells, for worlds without a scenario.
+/// </summary>
+/// <param name="terrain">The terrain to add the queries to</param>
+/// <param name="astar">The astar built for the terrain</param>
+/// <param name="count">The number of queries</param>
+/// <param name="random">The random generator</param>
+void GenerateQueries(Terrain& terrain, AStar& astar, int count, std::mt19937& random)
+{
+	const int cells = terrain.width * terrain.height;
+	for (int attempt = 0; attempt < count * 1000 && (int)terrain.queries.size() < count; attempt++)
+	{
+		int start = random() % cells, target = random() % cells;
+		if (start == target || terrain.penalties[start] < 0 || terrain.penalties[target] < 0) { continue; }
+		if (!astar.IsReachable(start, target)) { continue; }
+
+		terrain.queries.push_back({ start % terrain.width, start / terrain.width,
+									target % terrain.width, target / terrain.width, -1 });
+	}
+}
+
+/// <summary>
+/// Sums the movement costs along the last path of the passed context.
+/// </summary>
+/// <param name="astar">The astar the path was found on</param>
+/// <param name="start">The start cell index</param>
+/// <param name="context">The context holding the path</param>
+/// <returns>The path cost</returns>
+long long PathCost(AStar& astar, int start, const SearchContext& context)
+{
+	long long cost = 0;
+	int previous = start;
+	for (auto cell = context.cells.rbegin(); cell != context.cells.rend(); cell++)
+	{
+		cost += astar.MoveCost(previous, *cell);
+		previous = *cell;
+	}
+	return cost;
+}
+
+/// <summary>
+/// Retrieves the passed percentile of the sorted values, by nearest rank.
+/// </summary>
+/// <param name="sorted">The sorted values</param>
+/// <param name="percentile">The percentile (0 - 100)</param>
+/// <returns>The value at the percentile (0 - no values)</returns>
+double Percentile(const std::vector<double>& sorted, double percentile)
+{
+	if (sorted.empty()) { return 0; }
+	size_t rank = (size_t)std::ceil(percentile / 100.0 * sorted.size());
+	return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+}
+
+/// <summary>
+/// Calculates the mean of the passed values.
+/// </summary>
+/// <param name="values">The values</param>
+/// <returns>The mean (0 - no values)</returns>
+double Mean(const std::vector<double>& values)
+{
+	double sum = 0;
+	for (double value : values) { sum += value; }
+	return values.empty() ? 0 : sum / values.size();
+}
+
+/// <summary>
+/// Runs every query of the passed terrain with the passed algorithm.
+/// </summary>
+/// <param name="terrain">The terrain</param>
+/// <param name="astar">The astar built for the terrain</param>
+/// <param name="algorithm">The algorithm</param>
+/// <param name="reference">The path costs of the reference algorithm, filled when empty</param>
+/// <returns>The measurements</returns>
+Result Run(const Terrain& terrain, AStar& astar, const Algorithm& algorithm, std::vector<long long>& reference)
+{
+	// No expansion budget, every query is searched to the end
+	SearchOptions options(DEFAULT_SEARCH_WEIGHT, DEFAULT_ANYTIME_LIMIT, 0);
+	SearchContext context;
+	astar.SetOpenList(algorithm.openList);
+
+	Result result;
+	result.algorithm = &algorithm;
+	bool fill = reference.empty();
+	for (const Query& query : terrain.queries)
+	{
+		Vec3 start = ToWorld(query.startX, query.startY, terrain.width, terrain.height);
+		Vec3 target = ToWorld(query.targetX, query.targetY, terrain.width, terrain.height);
+
+		auto begin = std::chrono::steady_clock::now();
+		std::vector<Vec3> path = astar.FindPath(start, target, algorithm.flags, context, options);
+		double latency = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+
+		result.latencies.push_back(latency);
+		result.expansions.push_back(context.expansions);
+		result.total += latency;
+
+		long long cost = -1;
+		if (context.partial)
+		{
+			result.partial++;
+		}
+		else if (!context.cells.empty())
+		{
+			result.solved++;
+			cost = PathCost(astar, query.startX + query.startY * terrain.width, context);
+		}
+
+		if (fill)
+		{
+			reference.push_back(cost);
+		}
+		else
+		{
+			long long best = reference[result.latencies.size() - 1];
+			if (cost >= 0 && best > 0) { result.ratios.push_back((double)cost / best); }
+		}
+	}
+
+	std::sort(result.latencies.begin(), result.latencies.end());
+	std::sort(result.expansions.begin(), result.expansions.end());
+	return result;
+}
+
+/// <summary>
+/// Escapes the passed text as a JSON string.
+/// </summary>
+/// <param name="text">The text</param>
+/// <returns>The quoted string</returns>
+std::string Quote(const std::string& text)
+{
+	std::string quoted = "\"";
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\') { quoted += '\\'; }
+		if ((unsigned char)c < 0x20) { quoted += ' '; continue; }
+		quoted += c;
+	}
+	return quoted + "\"";
+}
+
+/// <summary>
+/// Retrieves the name and version of the compiler the benchmark was built with.
+/// </summary>
+/// <returns>The compiler</returns>
+std::string Compiler()
+{
+#if defined(__clang__)
+	return "clang " __clang_version__;
+#elif defined(__GNUC__)
+	return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+	return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+	return "unknown";
+#endif
+}
+
+/// <summary>
+/// Struct representing the measurements of one world.
+/// </summary>
+struct WorldReport
+{
+	const Terrain* terrain;
+	int walkable;
+	double prepare;
+	std::vector<Result> results;
+};
+
+/// <summary>
+/// Writes the passed reports as JSON.
+/// </summary>
+/// <param name="out">The stream to write to</param>
+/// <param name="settings">The settings the benchmark ran with</param>
+/// <param name="reports">The reports</param>
+void WriteJson(std::ostream& out, const Settings& settings, const std::vector<WorldReport>& reports)
+{
+	out << "{\n";
+	out << "\t\"schema\": " << REPORT_SCHEMA << ",\n";
+	out << "\t\"layout\": " << Quote(GRID_LAYOUT::Name()) << ",\n";
+	out << "\t\"compiler\": " << Quote(Compiler()) << ",\n";
+	out << "\t\"seed\": " << settings.seed << ",\n";
+	out << "\t\"landmarks\": " << settings.landmarks << ",\n";
+	out << "\t\"worlds\": [";
+	for (size_t w = 0; w < reports.size(); w++)
+	{
+		const WorldReport& report = reports[w];
+		const Terrain& terrain = *report.terrain;
+		out << (w > 0 ? "," : "") << "\n\t\t{\n";
+		out << "\t\t\t\"name\": " << Quote(terrain.name) << ",\n";
+		out << "\t\t\t\"source\": " << Quote(terrain.source.empty() ? "synthetic" : terrain.source) << ",\n";
+		out << "\t\t\t\"width\": " << terrain.width << ",\n";
+		out << "\t\t\t\"height\": " << terrain.height << ",\n";
+		out << "\t\t\t\"walkable\": " << report.walkable << ",\n";
+		out << "\t\t\t\"queries\": " << terrain.queries.size() << ",\n";
+		out << "\t\t\t\"prepare_ms\": " << report.prepare << ",\n";
+		out << "\t\t\t\"results\": [";
+		for (size_t r = 0; r < report.results.size(); r++)
+		{
+			const Result& result = report.results[r];
+			out << (r > 0 ? "," : "") << "\n\t\t\t\t{\n";
+			out << "\t\t\t\t\t\"algorithm\": " << Quote(result.algorithm->name) << ",\n";
+			out << "\t\t\t\t\t\"solved\": " << result.solved << ",\n";
+			out << "\t\t\t\t\t\"partial\": " << result.partial << ",\n";
+			out << "\t\t\t\t\t\"expansions\": { \"mean\": " << Mean(result.expansions) << ", \"p50\": " << Percentile(result.expansions, 50)
+				<< ", \"p99\": " << Percentile(result.expansions, 99) << ", \"max\": " << Percentile(result.expansions, 100) << " },\n";
+			out << "\t\t\t\t\t\"latency_us\": { \"mean\": " << Mean(result.latencies) << ", \"p50\": " << Percentile(result.latencies, 50)
+				<< ", \"p90\": " << Percentile(result.latencies, 90) << ", \"p99\": " << Percentile(result.latencies, 99)
+				<< ", \"max\": " << Percentile(result.latencies, 100) << " },\n";
+			out << "\t\t\t\t\t\"throughput_qps\": " << (result.total > 0 ? result.latencies.size() * 1e6 / result.total : 0) << ",\n";
+			if (result.ratios.empty())
+			{
+				out << "\t\t\t\t\t\"cost_ratio\": null\n";
+			}
+			else
+			{
+				std::vector<double> ratios = result.ratios;
+				std::sort(ratios.begin(), ratios.end());
+				out << "\t\t\t\t\t\"cost_ratio\": { \"mean\": " << Mean(ratios) << ", \"max\": " << ratios.back() << " }\n";
+			}
+			out << "\t\t\t\t}";
+		}
+		out << "\n\t\t\t]\n\t\t}";
+	}
+	out << "\n\t]\n}\n";
+}
+
+/// <summary>
+/// Parses the command line.
+/// </summary>
+/// <param name="argc">The argument count</param>
+/// <param name="argv">The arguments</param>
+/// <param name="settings">The settings to fill</param>
+/// <returns>Whether the command line was valid</returns>
+bool ParseArguments(int argc, char** argv, Settings& settings)
+{
+	const std::set<std::string> valued = { "--map", "--scen", "--size", "--queries", "--seed", "--landmarks", "--json", "--algorithms" };
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+		if (argument == "--synthetic")
+		{
+			settings.synthetic = true;
+		}
+		else if (valued.count(argument) == 0 || i + 1 >= argc)
+		{
+			std::cerr << (valued.count(argument) == 0 ? "unknown argument " : "missing value for ") << argument << std::endl;
+			return false;
+		}
+		else if (argument == "--map")
+		{
+			settings.maps.push_back(std::make_pair(argv[++i], std::string()));
+		}
+		else if (argument == "--scen")
+		{
+			if (settings.maps.empty())
+			{
+				std::cerr << "--scen must follow the --map it poses problems on" << std::endl;
+				return false;
+			}
+			settings.maps.back().second = argv[++i];
+		}
+		else if (argument == "--size") { settings.size = std::max(atoi(argv[++i]), 8); }
+		else if (argument == "--queries") { settings.queries = std::max(atoi(argv[++i]), 0); }
+		else if (argument == "--seed") { settings.seed = (unsigned int)atoll(argv[++i]); }
+		else if (argument == "--landmarks") { settings.landmarks = std::max(atoi(argv[++i]), 0); }
+		else if (argument == "--json") { settings.json = argv[++i]; }
+		else if (argument == "--algorithms")
+		{
+			std::istringstream names(argv[++i]);
+			std::string name;
+			while (std::getline(names, name, ','))
+			{
+				auto found = std::find_if(std::begin(Algorithms), std::end(Algorithms),
+										  [&](const Algorithm& algorithm) { return name == algorithm.name; });
+				if (found == std::end(Algorithms))
+				{
+					std::cerr << "unknown algorithm " << name << std::endl;
+					return false;
+				}
+				settings.algorithms.push_back(found);
+			}
+		}
+	}
+
+	if (settings.algorithms.empty())
+	{
+		for (const Algorithm& algorithm : Algorithms) { settings.algorithms.push_back(&algorithm); }
+	}
+	settings.synthetic = settings.synthetic || settings.maps.empty();
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+	if (!ParseArguments(argc, argv, settings))
+	{
+		std::cerr << "usage: GridBenchmark [--map file.map [--scen file.scen]]... [--synthetic] [--size n] [--queries n]" << std::endl
+				  << "                     [--seed n] [--landmarks n] [--algorithms a,b,...] [--json file]" << std::endl;
+		return 2;
+	}
+
+	std::mt19937 random(settings.seed);
+	std::vector<Terrain> terrains;
+	for (const auto& map : settings.maps)
+	{
+		Terrain terrain;
+		if (!LoadMap(map.first, terrain)) { return 1; }
+		if (!map.second.empty() && !LoadScenario(map.second, terrain, settings.queries)) { return 1; }
+		terrains.push_back(std::move(terrain));
+	}
+	if (settings.synthetic)
+	{
+		terrains.push_back(GenerateOpen(settings.size));
+		terrains.push_back(GenerateObstacles(settings.size, random));
+		terrains.push_back(GenerateMaze(settings.size, random));
+		terrains.push_back(GenerateWeighted(settings.size, random));
+	}
+
+	const int allFlags = SEARCH_JUMP_POINT | SEARCH_HIERARCHICAL;
+	std::vector<WorldReport> reports;
+	std::cout << "world\t\talgorithm\tsolved\texpanded\tp50 (us)\tp90 (us)\tp99 (us)\tqueries/s\tcost ratio" << std::endl;
+	for (Terrain& terrain : terrains)
+	{
+		std::unique_ptr<AStar> astar = Build(terrain);
+		astar->SetLandmarkCount(settings.landmarks);
+
+		// The lazily built structures are prepared up front so no query pays for them
+		auto begin = std::chrono::steady_clock::now();
+		astar->Prepare(allFlags);
+		double prepare = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		if (terrain.queries.empty())
+		{
+			GenerateQueries(terrain, *astar, settings.queries, random);
+		}
+
+		WorldReport report = { &terrain, 0, prepare, {} };
+		for (int penalty : terrain.penalties) { report.walkable += penalty >= 0; }
+
+		// Costs are compared against plain A*, run first when it is not measured first
+		std::vector<long long> reference;
+		if (settings.algorithms[0] != &Algorithms[0])
+		{
+			Run(terrain, *astar, Algorithms[0], reference);
+		}
+		for (const Algorithm* algorithm : settings.algorithms)
+		{
+			Result result = Run(terrain, *astar, *algorithm, reference);
+			std::cout << terrain.name << "\t" << (terrain.name.size() < 8 ? "\t" : "") << algorithm->name << "\t" << (strlen(algorithm->name) < 8 ? "\t" : "")
+					  << result.solved << "/" << terrain.queries.size() << "\t" << Mean(result.expansions) << "\t\t"
+					  << Percentile(result.latencies, 50) << "\t\t" << Percentile(result.latencies, 90) << "\t\t"
+					  << Percentile(result.latencies, 99) << "\t\t" << (result.total > 0 ? result.latencies.size() * 1e6 / result.total : 0) << "\t\t";
+			if (result.ratios.empty()) { std::cout << "-" << std::endl; }
+			else { std::cout << Mean(result.ratios) << std::endl; }
+			report.results.push_back(std::move(result));
+		}
+		reports.push_back(std::move(report));
+	}
+
+	if (!settings.json.empty())
+	{
+		std::ofstream file(settings.json);
+		WriteJson(file, settings, reports);
+		if (!file)
+		{
+			std::cerr << settings.json << ": cannot write report" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,117 @@
+// HeapBenchmark.cpp : Compares the indexed open list heap against the generic minimum heap.
+
+#include "../pch.h"
+
+#include <chrono>
+#include <random>
+#include "../MinHeap.h"
+#include "../IndexedHeap.h"
+
+/// <summary>
+/// Number of decrease-key operations performed per open list size.
+/// Kept bounded since the generic heap scans linearly for every update.
+/// </summary>
+#define DECREASE_OPERATIONS 2000
+
+/// <summary>
+/// Struct representing a decrease-key operation, the F cost a node is lowered to.
+/// Repeated nodes are lowered again from their last cost, so both heaps see every update.
+/// </summary>
+struct Decrease
+{
+	int index;
+	int fCost;
+};
+
+/// <summary>
+/// Times the generic minimum heap with the passed workload. The heap is
+/// allocated before the clock starts, the same as the reused indexed heap.
+/// </summary>
+/// <param name="nodes">The nodes to push</param>
+/// <param name="updates">The decrease-key operations</param>
+/// <returns>The elapsed milliseconds</returns>
+double TimeMinHeap(const std::vector<OpenNode>& nodes, const std::vector<Decrease>& updates)
+{
+	MinHeap<OpenNode> heap(nodes.size());
+	auto begin = std::chrono::steady_clock::now();
+
+	for (const OpenNode& node : nodes)
+	{
+		heap.Add(node);
+	}
+	for (const Decrease& update : updates)
+	{
+		HeapItem<OpenNode>* found = heap.Find(OpenNode{ update.index, 0, 0 });
+		if (found == NULL) { continue; }
+
+		OpenNode* ptr = found->GetItemPtr();
+		ptr->fCost = update.fCost;
+		heap.UpdateItem(found);
+	}
+	while (heap.Size() > 0)
+	{
+		heap.RemoveFirst();
+	}
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/// <summary>
+/// Times the indexed heap with the passed workload.
+/// </summary>
+/// <param name="heap">The reused heap</param>
+/// <param name="nodes">The nodes to push</param>
+/// <param name="updates">The decrease-key operations</param>
+/// <returns>The elapsed milliseconds</returns>
+double TimeIndexedHeap(IndexedHeap& heap, const std::vector<OpenNode>& nodes, const std::vector<Decrease>& updates)
+{
+	heap.Reset(nodes.size());
+	auto begin = std::chrono::steady_clock::now();
+
+	for (const OpenNode& node : nodes)
+	{
+		heap.Add(node.index, node.fCost, node.hCost);
+	}
+	for (const Decrease& update : updates)
+	{
+		if (!heap.Contains(update.index)) { continue; }
+
+		heap.DecreaseKey(update.index, update.fCost, nodes[update.index].hCost);
+	}
+	while (heap.Size() > 0)
+	{
+		heap.RemoveFirst();
+	}
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main()
+{
+	std::mt19937 random(1234);
+	IndexedHeap indexed;
+
+	std::cout << "open size\tMinHeap (ms)\tIndexedHeap (ms)" << std::endl;
+	for (int size : { 1000, 5000, 10000, 50000, 100000 })
+	{
+		std::vector<OpenNode> nodes;
+		nodes.reserve(size);
+		for (int i = 0; i < size; i++)
+		{
+			int hCost = random() % 1000;
+			nodes.push_back(OpenNode{ i, hCost + (int)(random() % 1000), hCost });
+		}
+
+		std::vector<Decrease> updates;
+		std::vector<int> costs(size);
+		for (int i = 0; i < size; i++) { costs[i] = nodes[i].fCost; }
+		for (int i = 0; i < DECREASE_OPERATIONS; i++)
+		{
+			int index = random() % size;
+			updates.push_back(Decrease{ index, --costs[index] });
+		}
+
+		double minHeap = TimeMinHeap(nodes, updates);
+		double indexedHeap = TimeIndexedHeap(indexed, nodes, updates);
+		std::cout << size << "\t\t" << minHeap << "\t\t" << indexedHeap << std::endl;
+	}
+	return 0;
+}
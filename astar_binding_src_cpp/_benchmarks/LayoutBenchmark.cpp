@@ -0,0 +1,302 @@
+// LayoutBenchmark.cpp : Compares the row-major, blocked, Z-order and sparse matrix layouts on large grids.
+//
+// The matrix passes instantiate every dense layout directly. The A* and blur passes run the engine
+// with the layout it was built with, on an open world and on an island surrounded by void, so build
+// once per layout with GRID_LAYOUT defined as RowMajorLayout, BlockedLayout<>, MortonLayout or
+// SparseLayout<>. Cache misses are read from the hardware
+// counters where the platform exposes them, the cache lines spanned by a 3x3 neighbourhood
+// are counted on every platform.
+
+#include "../pch.h"
+
+#include <chrono>
+#include <random>
+#include "../AStar.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Movement penalties mirroring the terrain types of the grid scene,
+/// a negative penalty marks unwalkable terrain (rock and water).
+/// </summary>
+static const int TerrainPenalties[] = { 8, 8, 8, 3, 20, 20, -1, -1 };
+
+/// <summary>
+/// Class counting the last level cache misses of the calling thread,
+/// reporting -1 where no hardware counter is available.
+/// </summary>
+class CacheMisses
+{
+private:
+	int m_counter;
+
+public:
+	CacheMisses() : m_counter(-1)
+	{
+#ifdef __linux__
+		perf_event_attr attributes = {};
+		attributes.type = PERF_TYPE_HARDWARE;
+		attributes.size = sizeof(attributes);
+		attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+		attributes.disabled = 1;
+		attributes.exclude_kernel = 1;
+		attributes.exclude_hv = 1;
+		m_counter = (int)syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+	}
+
+	~CacheMisses()
+	{
+#ifdef __linux__
+		if (m_counter >= 0) { close(m_counter); }
+#endif
+	}
+
+	/// <summary>
+	/// Resets and starts the counter.
+	/// </summary>
+	void Start()
+	{
+#ifdef __linux__
+		if (m_counter >= 0)
+		{
+			ioctl(m_counter, PERF_EVENT_IOC_RESET, 0);
+			ioctl(m_counter, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+	}
+
+	/// <summary>
+	/// Stops the counter.
+	/// </summary>
+	/// <returns>The misses since the last start (-1 - not counted)</returns>
+	long long Stop()
+	{
+		long long misses = -1;
+#ifdef __linux__
+		if (m_counter >= 0)
+		{
+			ioctl(m_counter, PERF_EVENT_IOC_DISABLE, 0);
+			if (read(m_counter, &misses, sizeof(misses)) != sizeof(misses)) { misses = -1; }
+		}
+#endif
+		return misses;
+	}
+};
+
+/// <summary>
+/// Formats the passed miss count, n/a where it could not be counted.
+/// </summary>
+/// <param name="misses">The miss count</param>
+/// <returns>The formatted count</returns>
+std::string FormatMisses(long long misses)
+{
+	return misses < 0 ? "n/a" : std::to_string(misses);
+}
+
+/// <summary>
+/// Converts the passed grid coordinate into its world coordinate.
+/// </summary>
+/// <param name="x">The x grid coordinate</param>
+/// <param name="y">The y grid coordinate</param>
+/// <param name="size">The grid size</param>
+/// <returns>The world coordinate</returns>
+Vec3 ToWorld(int x, int y, int size)
+{
+	return Vec3(x - (size / 2.0f) + 0.5f, 0, y - (size / 2.0f) + 0.5f);
+}
+
+/// <summary>
+/// Times a blur-like 3x3 stencil sweep and an A*-like walk reading the
+/// neighbours of every visited cell through the flattened index.
+/// </summary>
+/// <typeparam name="Layout">The matrix layout</typeparam>
+/// <param name="size">The grid size</param>
+template<typename Layout>
+void BenchmarkMatrix(int size)
+{
+	std::mt19937 random(1234);
+	Matrix<PathPoint, Layout> matrix(size, size);
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			matrix(x, y) = PathPoint(ToWorld(x, y, size), Vec2(x, y), true, random() % 20);
+		}
+	}
+
+	CacheMisses counter;
+	long long sum = 0;
+	auto begin = std::chrono::steady_clock::now();
+	counter.Start();
+	for (int y = 1; y < size - 1; y++)
+	{
+		for (int x = 1; x < size - 1; x++)
+		{
+			for (int dy = -1; dy <= 1; dy++)
+			{
+				for (int dx = -1; dx <= 1; dx++)
+				{
+					sum += matrix(x + dx, y + dy).GetMovementPenalty();
+				}
+			}
+		}
+	}
+	long long stencilMisses = counter.Stop();
+	double stencil = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+	// A short random walk from random starts, the way a search frontier wanders
+	const int steps = 4 * 1024 * 1024;
+	int index = 0;
+	float distance = 0;
+	begin = std::chrono::steady_clock::now();
+	counter.Start();
+	for (int step = 0; step < steps; step++)
+	{
+		if (step % 256 == 0)
+		{
+			index = (1 + random() % (size - 2)) + (1 + random() % (size - 2)) * size;
+		}
+		const PathPoint& center = matrix[index];
+		for (int neighbor : { index - size - 1, index - size, index - size + 1, index - 1, index + 1, index + size - 1, index + size, index + size + 1 })
+		{
+			distance += center.GetPosition().ManhattenDistanceTo(matrix[neighbor].GetPosition());
+		}
+		int x = index % size + (int)(random() % 3) - 1, y = index / size + (int)(random() % 3) - 1;
+		index = std::min(std::max(x, 1), size - 2) + std::min(std::max(y, 1), size - 2) * size;
+	}
+	long long walkMisses = counter.Stop();
+	double walk = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+	// Distinct cache lines spanned by the 3x3 neighbourhood of a sample of cells
+	double lines = 0;
+	const int samples = 4096;
+	for (int sample = 0; sample < samples; sample++)
+	{
+		int x = 1 + random() % (size - 2), y = 1 + random() % (size - 2);
+		std::set<uintptr_t> touched;
+		for (int dy = -1; dy <= 1; dy++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+			{
+				uintptr_t address = reinterpret_cast<uintptr_t>(&matrix(x + dx, y + dy));
+				touched.insert(address / 64);
+				touched.insert((address + sizeof(PathPoint) - 1) / 64);
+			}
+		}
+		lines += touched.size();
+	}
+
+	std::cout << Layout::Name() << "\t" << size << "\t" << stencil << "\t\t" << FormatMisses(stencilMisses) << "\t\t"
+			  << walk << "\t\t" << FormatMisses(walkMisses) << "\t\t" << lines / samples
+			  << "\t(" << (sum + (long long)distance) % 10 << ")" << std::endl;
+}
+
+/// <summary>
+/// Generates a weighted terrain grid of the passed size in a single batch.
+/// Terrain is laid out in patches so that penalties vary the way they do in a real scene.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <param name="island">Whether only a disc in the middle is terrain, the rest unwalkable void</param>
+/// <param name="random">The random generator</param>
+/// <returns>The generated astar</returns>
+std::unique_ptr<AStar> Generate(int size, bool island, std::mt19937& random)
+{
+	const int patch = 8;
+	std::unique_ptr<AStar> astar = std::make_unique<AStar>(Vec2(size, size), 3, 20, Vec3());
+	std::vector<int> patches;
+	for (int i = 0; i < ((size / patch) + 1) * ((size / patch) + 1); i++)
+	{
+		patches.push_back(TerrainPenalties[random() % 8]);
+	}
+
+	std::vector<float> points;
+	points.reserve((size_t)size * size * 7 + 1);
+	points.push_back(0);
+	for (int x = 0; x < size; x++)
+	{
+		for (int y = 0; y < size; y++)
+		{
+			float dx = x - size / 2.0f, dy = y - size / 2.0f;
+			bool terrain = !island || dx * dx + dy * dy < size * size / 16.0f;
+			int penalty = terrain ? patches[(x / patch) + ((y / patch) * ((size / patch) + 1))] : -1;
+			bool walkable = penalty >= 0 && random() % 10 != 0;
+			Vec3 world = ToWorld(x, y, size);
+			points.insert(points.end(), { (float)x, (float)y, world.x, world.y, world.z, (float)walkable, (float)(walkable ? penalty : 20) });
+		}
+	}
+	points[0] = (float)points.size();
+	astar->AddGridPoints(points.data(), (int)points.size());
+	return astar;
+}
+
+/// <summary>
+/// Times A* queries and a full blur against the engine built with the configured layout.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <param name="island">Whether the world is an island surrounded by void</param>
+void BenchmarkEngine(int size, bool island)
+{
+	std::mt19937 random(1234);
+	std::unique_ptr<AStar> astar = Generate(size, island, random);
+	double stored = astar->GetGrid().GetBytes() / (1024.0 * 1024.0);
+	std::vector<std::pair<Vec3, Vec3>> queries;
+	while (queries.size() < 50)
+	{
+		int start = random() % (size * size), target = random() % (size * size);
+		if (!astar->IsWalkable(start) || !astar->IsWalkable(target)) { continue; }
+		queries.push_back(std::make_pair(ToWorld(start % size, start / size, size),
+										 ToWorld(target % size, target / size, size)));
+	}
+
+	CacheMisses counter;
+	std::vector<double> latencies;
+	counter.Start();
+	for (const auto& query : queries)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		astar->FindPath(query.first, query.second);
+		latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+	}
+	long long searchMisses = counter.Stop();
+	double total = 0;
+	for (double latency : latencies) { total += latency; }
+	std::sort(latencies.begin(), latencies.end());
+
+	auto begin = std::chrono::steady_clock::now();
+	counter.Start();
+	astar->BlurWeights(3);
+	long long blurMisses = counter.Stop();
+	double blur = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+	std::cout << GRID_LAYOUT::Name() << "\t" << (island ? "island" : "open") << "\t" << size << "\t" << stored << "\t\t" << total << "\t\t" << latencies[latencies.size() / 2] << "\t\t"
+			  << latencies[latencies.size() * 9 / 10] << "\t\t" << FormatMisses(searchMisses) << "\t\t"
+			  << blur << "\t\t" << FormatMisses(blurMisses) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<int> sizes = { 1024, 2048 };
+	if (argc > 1) { sizes.push_back(atoi(argv[1])); }
+
+	std::cout << "layout\tgrid\tstencil (ms)\tmisses\t\twalk (ms)\tmisses\t\tlines / 3x3" << std::endl;
+	for (int size : sizes)
+	{
+		BenchmarkMatrix<RowMajorLayout>(size);
+		BenchmarkMatrix<BlockedLayout<>>(size);
+		BenchmarkMatrix<MortonLayout>(size);
+	}
+
+	std::cout << std::endl << "layout\tworld\tgrid\tcells (MB)\tA* 50 (ms)\tp50 (ms)\tp90 (ms)\tmisses\t\tblur (ms)\tmisses" << std::endl;
+	for (int size : sizes)
+	{
+		BenchmarkEngine(size, false);
+		BenchmarkEngine(size, true);
+	}
+	return 0;
+}
@@ -0,0 +1,84 @@
+// OpenListBenchmark.cpp : Compares the binary heap and bucket queue open lists on weighted terrain.
+
+#include "../pch.h"
+
+#include <chrono>
+#include <random>
+#include "../AStar.h"
+
+/// <summary>
+/// Movement penalties mirroring the terrain types of the grid scene,
+/// a negative penalty marks unwalkable terrain (rock and water).
+/// </summary>
+static const int TerrainPenalties[] = { 8, 8, 8, 3, 20, 20, -1, -1 };
+
+/// <summary>
+/// Converts the passed grid coordinate into its world coordinate.
+/// </summary>
+/// <param name="x">The x grid coordinate</param>
+/// <param name="y">The y grid coordinate</param>
+/// <param name="size">The grid size</param>
+/// <returns>The world coordinate</returns>
+Vec3 ToWorld(int x, int y, int size)
+{
+	return Vec3(x - (size / 2.0f) + 0.5f, 0, y - (size / 2.0f) + 0.5f);
+}
+
+/// <summary>
+/// Generates a weighted terrain grid of the passed size. Terrain is laid
+/// out in patches so that penalties vary the way they do in a real scene.
+/// </summary>
+/// <param name="size">The grid size</param>
+/// <param name="random">The random generator</param>
+/// <returns>The generated astar</returns>
+AStar Generate(int size, std::mt19937& random)
+{
+	const int patch = 8;
+	AStar astar(Vec2(size, size), 3, 20, Vec3());
+	std::vector<int> patches;
+	for (int i = 0; i < ((size / patch) + 1) * ((size / patch) + 1); i++)
+	{
+		patches.push_back(TerrainPenalties[random() % 8]);
+	}
+	for (int x = 0; x < size; x++)
+	{
+		for (int y = 0; y < size; y++)
+		{
+			int penalty = patches[(x / patch) + ((y / patch) * ((size / patch) + 1))];
+			bool walkable = penalty >= 0 && random() % 10 != 0;
+			astar.AddGridPoint(PathPoint(ToWorld(x, y, size), Vec2(x, y), walkable, walkable ? penalty : 20));
+		}
+	}
+	return astar;
+}
+
+int main()
+{
+	std::mt19937 random(1234);
+
+	std::cout << "grid\tqueries\tBinaryHeap (ms)\tBuckets (ms)" << std::endl;
+	for (int size : { 64, 128, 256 })
+	{
+		AStar astar = Generate(size, random);
+		std::vector<std::pair<Vec3, Vec3>> queries;
+		for (int i = 0; i < 200; i++)
+		{
+			queries.push_back(std::make_pair(ToWorld(random() % size, random() % size, size),
+											 ToWorld(random() % size, random() % size, size)));
+		}
+
+		double elapsed[2] = { 0, 0 };
+		for (int type = 0; type < 2; type++)
+		{
+			astar.SetOpenList(type == 0 ? OpenList::BinaryHeap : OpenList::Buckets);
+			auto begin = std::chrono::steady_clock::now();
+			for (const auto& query : queries)
+			{
+				astar.FindPath(query.first, query.second);
+			}
+			elapsed[type] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		}
+		std::cout << size << "\t" << queries.size() << "\t" << elapsed[0] << "\t\t" << elapsed[1] << std::endl;
+	}
+	return 0;
+}
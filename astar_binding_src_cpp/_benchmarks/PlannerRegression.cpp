@@ -0,0 +1,124 @@
+// PlannerRegression.cpp : Checks the incremental planner against a fresh search while the grid is edited.
+
+#include "../pch.h"
+
+#include <random>
+#include "../AStar.h"
+#include "../IncrementalPlanner.h"
+
+/// <summary>
+/// Grid size, landmark count and penalty range of the checked worlds, small
+/// enough for many edits per world yet weighted enough for the landmark
+/// bound to differ from the grid heuristic.
+/// </summary>
+#define REGRESSION_SIZE 40
+#define REGRESSION_LANDMARKS 8
+#define REGRESSION_MIN_PENALTY 3
+#define REGRESSION_MAX_PENALTY 10
+
+/// <summary>
+/// Number of generated worlds, and the single cell edits replanned per world.
+/// </summary>
+#define REGRESSION_WORLDS 20
+#define REGRESSION_EDITS 200
+
+/// <summary>
+/// Converts the passed grid coordinate into its world coordinate.
+/// </summary>
+/// <param name="x">The x grid coordinate</param>
+/// <param name="y">The y grid coordinate</param>
+/// <returns>The world coordinate</returns>
+Vec3 ToWorld(int x, int y)
+{
+	return Vec3(x - (REGRESSION_SIZE / 2.0f) + 0.5f, 0, y - (REGRESSION_SIZE / 2.0f) + 0.5f);
+}
+
+/// <summary>
+/// Places a random cell at the passed grid coordinate.
+/// </summary>
+/// <param name="astar">The astar owning the grid</param>
+/// <param name="x">The x grid coordinate</param>
+/// <param name="y">The y grid coordinate</param>
+/// <param name="random">The random generator</param>
+void PlaceCell(AStar& astar, int x, int y, std::mt19937& random)
+{
+	bool walkable = random() % 5 != 0;
+	int penalty = REGRESSION_MIN_PENALTY + (random() % (REGRESSION_MAX_PENALTY - REGRESSION_MIN_PENALTY + 1));
+	astar.AddGridPoint(PathPoint(ToWorld(x, y), Vec2(x, y), walkable, penalty));
+}
+
+/// <summary>
+/// Sums the movement cost of the passed path.
+/// </summary>
+/// <param name="astar">The astar owning the grid</param>
+/// <param name="start">The start cell index</param>
+/// <param name="cells">The cells ordered from the target back to (and excluding) the start</param>
+/// <returns>The path cost</returns>
+long long PathCost(AStar& astar, int start, const std::vector<int>& cells)
+{
+	long long cost = 0;
+	int previous = start;
+	for (auto cell = cells.rbegin(); cell != cells.rend(); ++cell)
+	{
+		cost += astar.MoveCost(previous, *cell);
+		previous = *cell;
+	}
+	return cost;
+}
+
+int main()
+{
+	std::mt19937 random(1234);
+	int plans = 0, failures = 0;
+
+	for (int world = 0; world < REGRESSION_WORLDS; world++)
+	{
+		AStar astar(Vec2(REGRESSION_SIZE, REGRESSION_SIZE), REGRESSION_MIN_PENALTY, REGRESSION_MAX_PENALTY, Vec3());
+		for (int x = 0; x < REGRESSION_SIZE; x++)
+		{
+			for (int y = 0; y < REGRESSION_SIZE; y++)
+			{
+				PlaceCell(astar, x, y, random);
+			}
+		}
+		astar.SetLandmarkCount(REGRESSION_LANDMARKS);
+
+		// Both ends stay open, every other cell may change between plans
+		CompactGrid& grid = astar.GetGrid();
+		Vec3 from = ToWorld(0, 0), to = ToWorld(REGRESSION_SIZE - 1, REGRESSION_SIZE - 1);
+		astar.AddGridPoint(PathPoint(from, Vec2(0, 0), true, REGRESSION_MAX_PENALTY));
+		astar.AddGridPoint(PathPoint(to, Vec2(REGRESSION_SIZE - 1, REGRESSION_SIZE - 1), true, REGRESSION_MAX_PENALTY));
+		int start = grid.GetIndex(from), target = grid.GetIndex(to);
+		IncrementalPlanner planner;
+		SearchContext context;
+		SearchOptions exact(1.0f, 0, 0);
+		std::vector<int> cells;
+
+		for (int edit = 0; edit < REGRESSION_EDITS; edit++)
+		{
+			int x = random() % REGRESSION_SIZE, y = random() % REGRESSION_SIZE;
+			int index = grid.GetIndex(x, y);
+			if (index != start && index != target)
+			{
+				PlaceCell(astar, x, y, random);
+			}
+
+			astar.Prepare(SEARCH_DEFAULT);
+			bool planned = planner.Plan(astar, start, target, cells);
+			long long planCost = planned ? PathCost(astar, start, cells) : -1;
+
+			std::vector<Vec3> path = astar.FindPath(from, to, SEARCH_DEFAULT, context, exact);
+			long long bestCost = path.empty() ? -1 : PathCost(astar, start, context.cells);
+
+			plans++;
+			if (planCost != bestCost)
+			{
+				failures++;
+				std::cout << "world " << world << " edit " << edit << ": planned " << planCost << ", optimal " << bestCost << std::endl;
+			}
+		}
+	}
+
+	std::cout << plans << " plans, " << failures << " differing from a fresh search" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
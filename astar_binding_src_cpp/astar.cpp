@@ -2,140 +2,818 @@
 
 #include "AStar.h"
 
+/// <summary>
+/// Source of grid versions, shared by every instance so a rebuilt
+/// grid never repeats the version of the grid it replaced.
+/// </summary>
+static std::atomic<unsigned int> s_versions(0);
+
+/// <summary>
+/// Calculates the open list key of a cell under the passed heuristic weight.
+/// </summary>
+/// <param name="gCost">The G cost of the cell</param>
+/// <param name="hCost">The H cost of the cell</param>
+/// <param name="weight">The heuristic weight</param>
+/// <returns>The F cost of the cell</returns>
+static inline int WeightedCost(int gCost, int hCost, float weight)
+{
+	return weight == 1.0f ? gCost + hCost : gCost + (int)(hCost * weight);
+}
+
+/// <summary>
+/// Fits the height range of the grid to a batch and makes the most common
+/// height of its unwalkable cells the height of the empty cells of a grid
+/// nothing is stored in yet, so a sparse grid leaves out the void around
+/// the walkable area. Dense grids store every cell regardless.
+/// </summary>
+/// <param name="grid">The grid</param>
+/// <param name="count">The number of cells in the batch</param>
+/// <param name="cell">Retrieves the walkability and height of a cell of the batch</param>
+template<typename Cell>
+static void FitBatch(CompactGrid& grid, int count, Cell cell)
+{
+	if (count <= 0) { return; }
+
+	float lowest = FLT_MAX, highest = -FLT_MAX;
+	std::unordered_map<float, int> counts;
+	float height = 0.0f;
+	int most = 0;
+	for (int i = 0; i < count; i++)
+	{
+		std::pair<bool, float> current = cell(i);
+		lowest = std::min(lowest, current.second);
+		highest = std::max(highest, current.second);
+		if (current.first || grid.GetStored() > 0) { continue; }
+
+		int& seen = ++counts[current.second];
+		if (seen > most)
+		{
+			most = seen;
+			height = current.second;
+		}
+	}
+	grid.FitHeights(lowest, highest);
+	if (most > 0)
+	{
+		grid.SetEmptyHeight(height);
+	}
+}
+
+/// <summary>
+/// Picks the height code a sparse grid leaves unstored, the most common one
+/// among the blocked cells as <see cref="FitBatch"/> picks their height.
+/// </summary>
+/// <param name="grid">The grid to load the codes into</param>
+/// <param name="cells">The cell map holding the walkability</param>
+/// <param name="codes">The height codes of every cell</param>
+/// <returns>The empty code</returns>
+static uint16_t EmptyCode(CompactGrid& grid, const CellMap& cells, const uint16_t* codes)
+{
+	if (grid.GetStored() > 0) { return 0; }
+
+	std::unordered_map<uint16_t, int> counts;
+	uint16_t code = 0;
+	int most = 0;
+	for (int index = 0; index < (int)grid.GetSize(); index++)
+	{
+		if (cells.IsWalkable(index)) { continue; }
+
+		int& seen = ++counts[codes[index]];
+		if (seen > most)
+		{
+			most = seen;
+			code = codes[index];
+		}
+	}
+	return code;
+}
+
 AStar::AStar(Vec2 gridDimension, int minPenalty, int maxPenalty, Vec3 offset)
 	: m_minPenalty(minPenalty), m_maxPenalty(maxPenalty),
-		m_grid(Grid<PathPoint>((int)gridDimension.x, (int)gridDimension.y)),
-		m_worldOffset(offset)
+		m_grid(CompactGrid((int)gridDimension.x, (int)gridDimension.y)),
+		m_worldOffset(offset), m_openList(OpenList::BinaryHeap), m_version(0), m_journalBase(0)
 {
+	m_cells.Resize(m_grid.GetWidth(), m_grid.GetHeight());
+	StampTiles();
 }
 
 AStar::AStar(float* nodes, int d1)
-	: m_worldOffset(Vec3(nodes[2], nodes[3], nodes[4])), m_grid(Grid<PathPoint>(nodes[5], nodes[6])),
-		m_minPenalty(nodes[7]), m_maxPenalty(nodes[8])
+	: m_worldOffset(Vec3(nodes[2], nodes[3], nodes[4])), m_grid(CompactGrid(nodes[5], nodes[6])),
+		m_minPenalty(nodes[7]), m_maxPenalty(nodes[8]), m_openList(OpenList::BinaryHeap), m_version(0), m_journalBase(0)
 {
 	ImportGrid(nodes, d1);
 }
 
+AStar::AStar(const GridSnapshot& snapshot)
+	: m_worldOffset(Vec3(snapshot.GetHeader().offsetX, snapshot.GetHeader().offsetY, snapshot.GetHeader().offsetZ)),
+		m_grid(CompactGrid(snapshot.GetHeader().width, snapshot.GetHeader().height)),
+		m_minPenalty(snapshot.GetHeader().minPenalty), m_maxPenalty(snapshot.GetHeader().maxPenalty),
+		m_openList(OpenList::BinaryHeap), m_version(0), m_journalBase(0)
+{
+	// The walkability bits and penalties are taken over as stored
+	const SnapshotHeader& header = snapshot.GetHeader();
+	int size = (int)m_grid.GetSize();
+	m_cells.Load(m_grid.GetWidth(), m_grid.GetHeight(), snapshot.GetBits());
+	switch (header.penaltyBytes)
+	{
+	case 1: m_cells.LoadPenalties(snapshot.GetPenalties()); break;
+	case 2: m_cells.LoadPenalties(reinterpret_cast<const uint16_t*>(snapshot.GetPenalties())); break;
+	default: m_cells.LoadPenalties(reinterpret_cast<const int32_t*>(snapshot.GetPenalties())); break;
+	}
+
+	if (!(header.flags & SNAPSHOT_EXPLICIT_POSITIONS))
+	{
+		// On the lattice of the snapshot its height codes are the grid's own
+		m_grid.SetLattice(header.originX, header.originZ, header.spacingX, header.spacingZ, header.heightMin, header.heightScale);
+		m_grid.LoadCodes(snapshot.GetHeights(), EmptyCode(m_grid, m_cells, snapshot.GetHeights()));
+	}
+	else
+	{
+		FitBatch(m_grid, size,
+			[&](int index) { return std::make_pair(m_cells.IsWalkable(index), snapshot.GetPosition(index).y); });
+		for (int index = 0; index < size; index++)
+		{
+			m_grid.SetPosition(m_grid.GetRow(index), m_grid.GetCol(index), snapshot.GetPosition(index));
+		}
+	}
+	StampTiles();
+}
+
 void AStar::Clear()
 {
-	m_grid = Grid<PathPoint>(0,0);
+	m_grid = CompactGrid(0, 0);
+	m_cells.Resize(0, 0);
+	m_blur.Invalidate();
+	m_jumpPoints.Invalidate();
+	m_hierarchy.Invalidate();
+	m_components.Invalidate();
+	m_landmarks.Invalidate();
+	StampTiles();
 }
 
 void AStar::AddGridPoint(PathPoint point)
 {
-	m_grid(point.GetGridX(), point.GetGridY()) = PathPoint(point);
+	m_grid.SetPosition(point.GetGridX(), point.GetGridY(), point.GetPosition());
+	int index = m_grid.GetIndex(point.GetGridX(), point.GetGridY());
+	m_cells.Set(index, point.GetWalkable(), point.GetMovementPenalty());
+	m_blur.Update(point.GetGridX(), point.GetGridY(), point.GetMovementPenalty());
+	m_jumpPoints.Update(m_grid, m_cells, index);
+	m_hierarchy.Update(*this, index);
+	m_components.Update(*this, index);
+	m_landmarks.Invalidate();
+	StampTile(index);
+	TrimJournal();
 }
 
 void AStar::AddGridPoints(float* points, int d1)
 {
+	PlacePoints(points + 1, (int)((points[0] - 1) / 7));
+	m_jumpPoints.Invalidate();
+	m_hierarchy.Invalidate();
+	m_components.Invalidate();
+	m_landmarks.Invalidate();
+
+	// One new version for the whole batch, stamped onto every tile it touched
+	m_version = ++s_versions;
 	for (int i = 0; i < (points[0] - 1) / 7; i++)
 	{
 		int base = (i * 7) + 1;
-		Vec2 pos(points[base], points[base + 1]);
-		Vec3 coord(points[base + 2], points[base + 3], points[base + 4]);
-		m_grid(pos.x, pos.y) = PathPoint(coord, pos, points[base + 5], points[base + 6]);
+		int index = m_grid.GetIndex(points[base], points[base + 1]);
+		m_blur.Update(m_grid.GetRow(index), m_grid.GetCol(index), m_cells.GetPenalty(index));
+		m_tileVersions[GetTile(index)] = m_version;
+		m_journal.emplace_back(m_version, index);
 	}
+	TrimJournal();
 }
 
 PathPoint AStar::GetGridPoint(Vec3 coordinate)
 {
-	return m_grid(coordinate - m_worldOffset);
+	return GetPoint(m_grid.GetIndex(coordinate - m_worldOffset));
 }
 
 PathPoint AStar::GetGridPoint(unsigned xGrid, unsigned yGrid)
 {
-	return m_grid(xGrid, yGrid);
+	return GetPoint(m_grid.GetIndex(xGrid, yGrid));
 }
 
 std::vector<PathPoint> AStar::GetNearestNeighbors(const Vec3& coordinate)
 {
-	return GetNearestNeighbors(m_grid(coordinate));
+	return GetNearestNeighbors(GetPoint(m_grid.GetIndex(coordinate)));
 }
 
 std::vector<PathPoint> AStar::GetNearestNeighbors(const PathPoint& center)
 {
-	return m_grid.GetNeighbors(center.GetGridX(), center.GetGridY());
+	std::vector<PathPoint> neighbors;
+	int indices[8];
+	int count = m_grid.GetNeighborIndices(m_grid.GetIndex(center.GetGridX(), center.GetGridY()), indices);
+	for (int i = 0; i < count; i++)
+	{
+		neighbors.push_back(GetPoint(indices[i]));
+	}
+	return neighbors;
+}
+
+const PathPoint AStar::GetPoint(int index)
+{
+	return PathPoint(m_grid.GetPosition(index), Vec2(m_grid.GetRow(index), m_grid.GetCol(index)),
+		m_cells.IsWalkable(index), m_cells.GetPenalty(index));
+}
+
+void AStar::PlacePoints(const float* points, int count)
+{
+	FitBatch(m_grid, count, [&](int i) { return std::make_pair((bool)points[(i * 7) + 5], points[(i * 7) + 3]); });
+	for (int i = 0; i < count; i++)
+	{
+		const float* point = points + (i * 7);
+		int row = point[0], col = point[1];
+		m_grid.SetPosition(row, col, Vec3(point[2], point[3], point[4]));
+		m_cells.Set(m_grid.GetIndex(row, col), point[5], point[6]);
+	}
+}
+
+const std::vector<Vec3> AStar::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags)
+{
+	Prepare(flags);
+	return FindPath(startCoordinate, targetCoordinate, flags, m_context);
+}
+
+const std::vector<Vec3> AStar::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SearchContext& context, const SearchOptions& options)
+{
+	int start = m_grid.GetIndex(startCoordinate);
+	int target = m_grid.GetIndex(targetCoordinate);
+
+	context.cells.clear();
+	context.bound = 1.0f;
+	context.partial = false;
+	context.expansions = 0;
+	if (!m_cells.IsWalkable(start) || !m_cells.IsWalkable(target)) { return {}; }
+
+	// Sealed off targets are rejected without exhausting the search
+	if (!IsReachable(start, target)) { return {}; }
+
+	SearchBudget budget(options);
+	if (flags & SEARCH_HIERARCHICAL)
+	{
+		// Targets near the start are left to the regular search, which a
+		// declined abstract search falls through to with the budget left
+		if (m_hierarchy.FindPath(*this, start, target, context, budget, context.cells))
+		{
+			context.expansions += budget.GetExpansions();
+			context.bound = 0.0f;
+			context.partial = budget.IsExhausted() && (context.cells.empty() || context.cells.front() != target);
+			if (context.cells.empty()) { return {}; }
+			return SimplifyPath(context.cells);
+		}
+	}
+
+	int closest = start;
+	if (flags & SEARCH_BIDIRECTIONAL)
+	{
+		int meeting = -1;
+		bool found = m_openList == OpenList::Buckets
+			? SearchBidirectional(start, target, context, context.buckets, context.reverseBuckets, budget, meeting, closest)
+			: SearchBidirectional(start, target, context, context.heap, context.reverseHeap, budget, meeting, closest);
+		context.expansions += budget.GetExpansions();
+		if (found)
+		{
+			// Join the backward parents from the target to the meeting cell
+			// with the forward parents from the meeting cell to the start
+			int current = meeting;
+			while (current != target)
+			{
+				current = context.reverseArena[current].parent;
+				context.cells.push_back(current);
+			}
+			std::reverse(context.cells.begin(), context.cells.end());
+			for (current = meeting; current != start; current = context.arena[current].parent)
+			{
+				context.cells.push_back(current);
+			}
+
+			// A meeting found before the budget ran out is not proven the cheapest
+			context.bound = budget.IsExhausted() ? 0.0f : 1.0f;
+			return SimplifyPath(context.cells);
+		}
+	}
+	else if (flags & SEARCH_ANYTIME)
+	{
+		bool found = SearchAnytime(start, target, context, options, budget, closest);
+		context.expansions += budget.GetExpansions();
+		if (found)
+		{
+			return RetracePath(start, target, context.arena, context.cells);
+		}
+	}
+	else
+	{
+		// Jumping falls back to regular expansion when the grid step costs break its pruning rules
+		bool jump = (flags & SEARCH_JUMP_POINT) && m_jumpPoints.IsValid();
+
+		// Weighted keys are not monotone, so only the heap pops them in order
+		float weight = (flags & SEARCH_WEIGHTED) ? options.weight : 1.0f;
+		context.bound = weight;
+		bool success = m_openList == OpenList::Buckets && weight == 1.0f
+			? Search(start, target, context.buckets, context.arena, jump, weight, budget, closest)
+			: Search(start, target, context.heap, context.arena, jump, weight, budget, closest);
+		context.expansions += budget.GetExpansions();
+		if (success)
+		{
+			return RetracePath(start, target, context.arena, context.cells);
+		}
+	}
+
+	// A search cut short by its budget settles for the path to
+	// the expanded cell closest to the target
+	context.cells.clear();
+	if (!budget.IsExhausted()) { return {}; }
+
+	context.partial = true;
+	context.bound = 0.0f;
+	if (closest == start) { return {}; }
+	return RetracePath(start, closest, context.arena, context.cells);
+}
+
+const std::vector<Vec3> AStar::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate, IncrementalPlanner& planner)
+{
+	std::vector<int> cells;
+	if (planner.Plan(*this, m_grid.GetIndex(startCoordinate), m_grid.GetIndex(targetCoordinate), cells))
+	{
+		return SimplifyPath(cells);
+	}
+	return {};
 }
 
-const std::vector<Vec3> AStar::FindPath(const Vec3& startCoordinate, const Vec3& targetCoordinate)
+void AStar::StartSearch(const Vec3& startCoordinate, const Vec3& targetCoordinate, int flags, SteppedSearch& search, float weight)
 {
-	unsigned safety = 0;
-	bool success = false;
-	PathPoint start = m_grid(startCoordinate);
-	PathPoint target = m_grid(targetCoordinate);
+	search.startCoordinate = startCoordinate;
+	search.targetCoordinate = targetCoordinate;
+	search.flags = flags;
+	search.weight = (flags & SEARCH_WEIGHTED) ? std::max(weight, 1.0f) : 1.0f;
+	RestartSearch(search);
+}
 
-	MinHeap<PathPoint> open;
-	HeapItem<PathPoint>* foundPoint;
-	std::unordered_set<PathPoint, PathPointHashFunction> closed;
-	closed.reserve(25);
-	if (start.GetWalkable() && target.GetWalkable())
+const SearchStatus AStar::StepSearch(SteppedSearch& search, int maxExpansions, int maxMicroseconds)
+{
+	// The state of a search begun against another grid or before an edit no longer holds
+	if (search.status == SearchStatus::Idle) { return search.status; }
+	if (search.astar != this || search.version != m_version)
 	{
-		// A* Path finding algorithm
-		open.Add(start);
+		RestartSearch(search);
+	}
+	if (search.status != SearchStatus::Running) { return search.status; }
 
-		while (open.Size() > 0)
+	SearchContext& context = search.context;
+	SearchBudget budget(SearchOptions(search.weight, 0, maxExpansions, maxMicroseconds));
+	bool found = search.buckets
+		? ContinueSearch(search.target, context.buckets, context.arena, search.jump, search.weight, budget, search.closest)
+		: ContinueSearch(search.target, context.heap, context.arena, search.jump, search.weight, budget, search.closest);
+	if (found)
+	{
+		search.status = SearchStatus::Found;
+	}
+	else if (!budget.IsExhausted())
+	{
+		search.status = SearchStatus::NotFound;
+	}
+	return search.status;
+}
+
+const std::vector<Vec3> AStar::GetSearchResult(SteppedSearch& search)
+{
+	if (search.status != SearchStatus::Idle && (search.astar != this || search.version != m_version))
+	{
+		RestartSearch(search);
+	}
+
+	SearchContext& context = search.context;
+	context.cells.clear();
+	context.partial = search.status == SearchStatus::Running;
+	context.bound = context.partial ? 0.0f : search.weight;
+	switch (search.status)
+	{
+	case SearchStatus::Found:
+		return RetracePath(search.start, search.target, context.arena, context.cells);
+	case SearchStatus::Running:
+		if (search.closest == search.start) { return {}; }
+		return RetracePath(search.start, search.closest, context.arena, context.cells);
+	default:
+		return {};
+	}
+}
+
+void AStar::RestartSearch(SteppedSearch& search)
+{
+	search.astar = this;
+	search.version = m_version;
+	search.start = m_grid.GetIndex(search.startCoordinate);
+	search.target = m_grid.GetIndex(search.targetCoordinate);
+	search.closest = search.start;
+	if (!m_cells.IsWalkable(search.start) || !m_cells.IsWalkable(search.target) || !IsReachable(search.start, search.target))
+	{
+		search.status = SearchStatus::NotFound;
+		return;
+	}
+
+	// The search mode is fixed for the lifetime of the state, as in a single query
+	search.status = SearchStatus::Running;
+	search.jump = (search.flags & SEARCH_JUMP_POINT) && m_jumpPoints.IsValid();
+	search.buckets = m_openList == OpenList::Buckets && search.weight == 1.0f;
+	if (search.buckets)
+	{
+		BeginSearch(search.start, search.target, search.context.buckets, search.context.arena, search.weight);
+	}
+	else
+	{
+		BeginSearch(search.start, search.target, search.context.heap, search.context.arena, search.weight);
+	}
+}
+
+const bool AStar::IsReachable(const Vec3& startCoordinate, const Vec3& targetCoordinate)
+{
+	int start = m_grid.GetIndex(startCoordinate);
+	int target = m_grid.GetIndex(targetCoordinate);
+	return m_cells.IsWalkable(start) && m_cells.IsWalkable(target) && IsReachable(start, target);
+}
+
+void AStar::Prepare(int flags)
+{
+	m_components.Prepare(*this);
+	m_landmarks.Prepare(*this);
+	if (flags & SEARCH_JUMP_POINT)
+	{
+		m_jumpPoints.Prepare(m_grid, m_cells);
+	}
+	if (flags & SEARCH_HIERARCHICAL)
+	{
+		m_hierarchy.Prepare(*this);
+	}
+}
+
+template<typename TOpen>
+const bool AStar::Search(int start, int target, TOpen& open, SearchArena& arena, bool jump, float weight, SearchBudget& budget, int& closest)
+{
+	// A* Path finding algorithm over dense cell indices
+	BeginSearch(start, target, open, arena, weight);
+	closest = start;
+	return ContinueSearch(target, open, arena, jump, weight, budget, closest);
+}
+
+template<typename TOpen>
+void AStar::BeginSearch(int start, int target, TOpen& open, SearchArena& arena, float weight)
+{
+	arena.Begin(m_grid.GetSize());
+	open.Reset(m_grid.GetSize());
+
+	int startH = Heuristic(start, target);
+	arena.Open(start, 0, startH, -1);
+	open.Add(start, WeightedCost(0, startH, weight), startH);
+}
+
+template<typename TOpen>
+const bool AStar::ContinueSearch(int target, TOpen& open, SearchArena& arena, bool jump, float weight, SearchBudget& budget, int& closest)
+{
+	int neighbors[8];
+	while (open.Size() > 0)
+	{
+		// This path is taking too long to compute so finding stops short
+		if (!budget.Expand(open.Size())) { break; }
+
+		int current = open.RemoveFirst();
+		arena.Close(current);
+
+		if (current == target)
+		{
+			return true;
+		}
+		if (arena[current].hCost < arena[closest].hCost)
 		{
-			// This path is taking too long to compute so finding failed
-			if (safety > 10000) { break; }
+			closest = current;
+		}
+
+		int currentG = arena[current].gCost;
+		int count = jump
+			? m_jumpPoints.GetSuccessors(m_grid, m_cells, current, arena[current].parent, target, neighbors)
+			: m_cells.GetWalkableNeighbors(current, neighbors);
+
+		for (int i = 0; i < count; i++)
+		{
+			int neighbor = neighbors[i];
+
+			if (arena.IsClosed(neighbor)) { continue; }
 
-			PathPoint current = open.RemoveFirst();
-			closed.emplace(current);
+			int newMoveCost = currentG + (jump ? LineCost(current, neighbor) : MoveCost(current, neighbor));
 
-			if (current == target)
+			if (arena.IsOpen(neighbor))
 			{
-				target = *closed.find(target);
-				success = true;
-				break;
+				SearchNode& node = arena[neighbor];
+				if (newMoveCost < node.gCost)
+				{
+					node.gCost = newMoveCost;
+					node.parent = current;
+					open.DecreaseKey(neighbor, WeightedCost(newMoveCost, node.hCost, weight), node.hCost);
+				}
+			}
+			else
+			{
+				int hCost = Heuristic(neighbor, target);
+				arena.Open(neighbor, newMoveCost, hCost, current);
+				open.Add(neighbor, WeightedCost(newMoveCost, hCost, weight), hCost);
 			}
+		}
+	}
+	return false;
+}
+
+const bool AStar::SearchAnytime(int start, int target, SearchContext& context, const SearchOptions& options, SearchBudget& budget, int& closest)
+{
+	SearchArena& arena = context.arena;
+	IndexedHeap& open = context.heap;
+	arena.Begin(m_grid.GetSize());
+	open.Reset(m_grid.GetSize());
+	context.visited.clear();
+	context.inconsistent.clear();
+	context.bound = 0.0f;
 
-			std::vector<PathPoint> neighbors = GetNearestNeighbors(current);
+	float weight = options.weight;
+	int startH = Heuristic(start, target);
+	arena.Open(start, 0, startH, -1);
+	open.Add(start, WeightedCost(0, startH, weight), startH);
+	context.visited.push_back(start);
+	closest = start;
 
-			for (int i = 0; i < neighbors.size(); i++)
+	int neighbors[8];
+	while (true)
+	{
+		// Improve the path until no open cell may lead to a cheaper one under the current weight
+		bool interrupted = false;
+		while (open.Size() > 0 && !(arena.IsReached(target) && arena[target].gCost <= open.Peek().fCost))
+		{
+			// Without a path the search stops short like the regular search,
+			// with one it is cut short once the time is up as well
+			bool found = context.bound > 0.0f;
+			if (!budget.Expand(open.Size()) || (found && (budget.GetExpansions() & 63) == 63 && budget.GetElapsed() > options.timeLimit))
 			{
-				PathPoint neighbor = neighbors[i];
+				interrupted = true;
+				break;
+			}
 
-				if (!neighbor.GetWalkable() || closed.find(neighbor) != closed.end()) { continue; }
+			int current = open.RemoveFirst();
+			arena.Close(current);
+			if (arena[current].hCost < arena[closest].hCost)
+			{
+				closest = current;
+			}
 
-				int newMoveCost = current.GetGCost() + current.ManhattenDistanceTo(neighbor) + neighbor.GetMovementPenalty();
-				foundPoint = open.Find(neighbor);
+			int currentG = arena[current].gCost;
+			int count = m_cells.GetWalkableNeighbors(current, neighbors);
+			for (int i = 0; i < count; i++)
+			{
+				int neighbor = neighbors[i];
+				int newMoveCost = currentG + MoveCost(current, neighbor);
+				if (arena.IsReached(neighbor) && newMoveCost >= arena[neighbor].gCost) { continue; }
 
-				if (foundPoint != NULL && newMoveCost < foundPoint->GetItemPtr()->GetGCost())
+				SearchNode& node = arena[neighbor];
+				if (arena.IsOpen(neighbor))
+				{
+					node.gCost = newMoveCost;
+					node.parent = current;
+					open.DecreaseKey(neighbor, WeightedCost(newMoveCost, node.hCost, weight), node.hCost);
+				}
+				else if (arena.IsClosed(neighbor))
 				{
-					PathPoint* ptr = foundPoint->GetItemPtr();
-					ptr->SetGCost(newMoveCost);
-					ptr->SetHCost(neighbor.ManhattenDistanceTo(target));
-					ptr->SetParent(&(*closed.find(current)));
-					open.UpdateItem(foundPoint);
+					// Expanded during this pass already, reopened by the next one
+					node.gCost = newMoveCost;
+					node.parent = current;
+					context.inconsistent.push_back(neighbor);
 				}
-				else if (foundPoint == NULL)
+				else
 				{
-					neighbor.SetGCost(newMoveCost);
-					neighbor.SetHCost(neighbor.ManhattenDistanceTo(target));
-					neighbor.SetParent(&(*closed.find(current)));
-					open.Add(neighbor);
+					int hCost = arena.IsReached(neighbor) ? node.hCost : Heuristic(neighbor, target);
+					if (!arena.IsReached(neighbor))
+					{
+						context.visited.push_back(neighbor);
+					}
+					arena.Open(neighbor, newMoveCost, hCost, current);
+					open.Add(neighbor, WeightedCost(newMoveCost, hCost, weight), hCost);
 				}
 			}
-			safety++;
+		}
+
+		// Parents only ever move to cheaper cells, so the target
+		// retraces a path no costlier than the last completed pass
+		if (!arena.IsReached(target) || (interrupted && context.bound == 0.0f)) { return false; }
+		if (interrupted) { return true; }
+
+		context.bound = weight;
+		if (weight == 1.0f || budget.GetElapsed() > options.timeLimit) { return true; }
+
+		// Halve the excess weight, the closed cells are released and the
+		// inconsistent ones reopened, every open key is weighed anew
+		weight = weight - 1.0f < 0.1f ? 1.0f : 1.0f + (weight - 1.0f) / 2;
+		for (int index : context.visited)
+		{
+			if (arena.IsClosed(index)) { arena.Release(index); }
+		}
+		for (int index : context.inconsistent)
+		{
+			if (arena.IsOpen(index)) { continue; }
+
+			SearchNode& node = arena[index];
+			arena.Open(index, node.gCost, node.hCost, node.parent);
+			open.Add(index, WeightedCost(node.gCost, node.hCost, weight), node.hCost);
+		}
+		context.inconsistent.clear();
+		for (int index : context.visited)
+		{
+			if (arena.IsOpen(index))
+			{
+				open.UpdateKey(index, WeightedCost(arena[index].gCost, arena[index].hCost, weight), arena[index].hCost);
+			}
 		}
 	}
-	if (success)
+}
+
+template<typename TOpen>
+const bool AStar::SearchBidirectional(int start, int target, SearchContext& context, TOpen& forward, TOpen& backward, SearchBudget& budget, int& meeting, int& closest)
+{
+	SearchArena& forwardArena = context.arena;
+	SearchArena& backwardArena = context.reverseArena;
+	forwardArena.Begin(m_grid.GetSize());
+	backwardArena.Begin(m_grid.GetSize());
+	forward.Reset(m_grid.GetSize());
+	backward.Reset(m_grid.GetSize());
+
+	// Both frontiers are keyed by twice their cost plus the difference of the
+	// heuristics towards either end (the average potential), which keeps the
+	// keys consistent for both directions at once
+	int startH = Heuristic(start, target);
+	forwardArena.Open(start, 0, startH, -1);
+	forward.Add(start, startH, startH);
+	backwardArena.Open(target, 0, startH, -1);
+	backward.Add(target, startH, startH);
+
+	int best = start == target ? 0 : INT_MAX;
+	meeting = start == target ? start : -1;
+	int forwardKey = startH, backwardKey = startH;
+	int closestH = startH;
+	closest = start;
+
+	while (forward.Size() > 0 && backward.Size() > 0)
 	{
-		std::vector<Vec3> temp = RetracePath(start, target);
-		return temp;
+		// This path is taking too long to compute so finding stops short,
+		// with the cheapest meeting so far if there is one
+		if (!budget.Expand(forward.Size() + backward.Size())) { break; }
+
+		bool reverse = backward.Size() < forward.Size();
+		TOpen& open = reverse ? backward : forward;
+		SearchArena& arena = reverse ? backwardArena : forwardArena;
+
+		// Keys are popped in increasing order on either side, so once the
+		// last popped keys add up to the best meeting no cheaper one is left
+		int current = open.RemoveFirst();
+		SearchNode& node = arena[current];
+		(reverse ? backwardKey : forwardKey) = 2 * node.gCost + node.hCost;
+		if (best != INT_MAX && (long long)forwardKey + backwardKey >= 2ll * best) { break; }
+
+		arena.Close(current);
+		if (reverse)
+		{
+			ExpandFrontier(current, target, start, backward, backwardArena, forwardArena, true, best, meeting);
+		}
+		else
+		{
+			ExpandFrontier(current, start, target, forward, forwardArena, backwardArena, false, best, meeting);
+
+			int currentH = Heuristic(current, target);
+			if (currentH < closestH)
+			{
+				closest = current;
+				closestH = currentH;
+			}
+		}
 	}
-	return {};
+	return meeting >= 0;
+}
+
+template<typename TOpen>
+void AStar::ExpandFrontier(int current, int origin, int goal, TOpen& open, SearchArena& arena, SearchArena& opposite, bool reverse, int& best, int& meeting)
+{
+	int neighbors[8];
+	int currentG = arena[current].gCost;
+	int count = m_cells.GetWalkableNeighbors(current, neighbors);
+	for (int i = 0; i < count; i++)
+	{
+		int neighbor = neighbors[i];
+		if (arena.IsClosed(neighbor)) { continue; }
+
+		int newMoveCost = currentG + (reverse ? MoveCost(neighbor, current) : MoveCost(current, neighbor));
+		if (arena.IsOpen(neighbor))
+		{
+			SearchNode& node = arena[neighbor];
+			if (newMoveCost >= node.gCost) { continue; }
+
+			node.gCost = newMoveCost;
+			node.parent = current;
+			open.DecreaseKey(neighbor, 2 * newMoveCost + node.hCost, node.hCost);
+		}
+		else
+		{
+			// Landmark bounds are directed, so the backward frontier bounds the
+			// cost from its goal onto the cell instead of the other way around
+			int potential = reverse ? Heuristic(goal, neighbor) - Heuristic(neighbor, origin) : Heuristic(neighbor, goal) - Heuristic(origin, neighbor);
+			arena.Open(neighbor, newMoveCost, potential, current);
+			open.Add(neighbor, 2 * newMoveCost + potential, potential);
+		}
+
+		// Reached by the opposite frontier as well
+		if ((opposite.IsOpen(neighbor) || opposite.IsClosed(neighbor)) && newMoveCost + opposite[neighbor].gCost < best)
+		{
+			best = newMoveCost + opposite[neighbor].gCost;
+			meeting = neighbor;
+		}
+	}
+}
+
+const int AStar::MoveCost(int from, int to)
+{
+	return ceil(m_grid.GetPosition(from).ManhattenDistanceTo(m_grid.GetPosition(to))) + m_cells.GetPenalty(to);
+}
+
+const int AStar::LineCost(int from, int to)
+{
+	int row = m_grid.GetRow(from), col = m_grid.GetCol(from);
+	int dx = (m_grid.GetRow(to) > row) - (m_grid.GetRow(to) < row);
+	int dy = (m_grid.GetCol(to) > col) - (m_grid.GetCol(to) < col);
+
+	int first = m_grid.GetIndex(row + dx, col + dy);
+	int steps = std::max(abs(m_grid.GetRow(to) - row), abs(m_grid.GetCol(to) - col));
+	if (steps == 1) { return MoveCost(from, to); }
+
+	// Jumps only cross uniform cells, sharing the penalty and height of the
+	// cell before them, so every step of a lattice line costs the same
+	if (m_grid.GetExplicit() == 0)
+	{
+		return MoveCost(from, first) * steps;
+	}
+
+	int cost = 0;
+	int current = from;
+	while (current != to)
+	{
+		row += dx;
+		col += dy;
+		int next = m_grid.GetIndex(row, col);
+		cost += MoveCost(current, next);
+		current = next;
+	}
+	return cost;
+}
+
+const int AStar::Heuristic(int from, int target)
+{
+	int distance = GridHeuristic(from, target, m_cells.GetMinPenalty());
+	if (!m_landmarks.IsValid()) { return distance; }
+
+	// Both bounds are consistent, and so is the larger of them
+	return std::max(distance, m_landmarks.LowerBound(from, target));
+}
+
+const int AStar::GridHeuristic(int from, int target, int minPenalty)
+{
+	int distance = ceil(m_grid.GetPosition(from).ManhattenDistanceTo(m_grid.GetPosition(target)));
+	if (minPenalty)
+	{
+		int steps = std::max(abs(m_grid.GetRow(from) - m_grid.GetRow(target)), abs(m_grid.GetCol(from) - m_grid.GetCol(target)));
+		distance += steps * minPenalty;
+	}
+	return distance;
 }
 
-const std::vector<Vec3> AStar::RetracePath(PathPoint start, PathPoint end)
+const std::vector<Vec3> AStar::RetracePath(int start, int end, SearchArena& arena, std::vector<int>& nodes)
 {
-	std::vector<PathPoint> nodes;
-	PathPoint& current = end;
+	nodes.clear();
+	int current = end;
 	while (current != start)
 	{
-		nodes.emplace_back(current);
-		current = *current.GetParent();
+		// Fill in the cells skipped over by a jump to the parent
+		int parent = arena[current].parent;
+		int row = m_grid.GetRow(current), col = m_grid.GetCol(current);
+		int parentRow = m_grid.GetRow(parent), parentCol = m_grid.GetCol(parent);
+		int dx = (parentRow > row) - (parentRow < row);
+		int dy = (parentCol > col) - (parentCol < col);
+		while (row != parentRow || col != parentCol)
+		{
+			nodes.emplace_back(m_grid.GetIndex(row, col));
+			row += dx;
+			col += dy;
+		}
+		current = parent;
 	}
+	return SimplifyPath(nodes);
+}
 
+const std::vector<Vec3> AStar::SimplifyPath(const std::vector<int>& nodes)
+{
 	std::vector<Vec3> waypoints;
 	waypoints.reserve(nodes.size());
 	float oldDir = FLT_EPSILON; // Impossible direction
@@ -143,14 +821,14 @@ const std::vector<Vec3> AStar::RetracePath(PathPoint start, PathPoint end)
 	{
 		if (i == 0)
 		{
-			waypoints.push_back(nodes[i].GetPosition());
+			waypoints.push_back(m_grid.GetPosition(nodes[i]));
 			continue;
 		}
 
-		float newDir = nodes[i - 1].GetPosition().DirectionTo(nodes[i].GetPosition());
+		float newDir = m_grid.GetPosition(nodes[i - 1]).DirectionTo(m_grid.GetPosition(nodes[i]));
 		if (!(abs(oldDir - newDir) < FLT_EPSILON))
 		{
-			waypoints.push_back(nodes[i].GetPosition());
+			waypoints.push_back(m_grid.GetPosition(nodes[i]));
 		}
 		oldDir = newDir;
 	}
@@ -158,54 +836,145 @@ const std::vector<Vec3> AStar::RetracePath(PathPoint start, PathPoint end)
 	return waypoints;
 }
 
-const std::tuple<int, int> AStar::BlurWeights(int size)
+const std::tuple<int, int> AStar::BlurWeights(int size, ThreadPool* pool)
 {
-	int kernelSize = size * 2 + 1;
-	int kernelExtents = (kernelSize - 1) / 2.0f;
+	m_blur.Blur(m_cells.GetPenalties(), m_grid.GetWidth(), m_grid.GetHeight(), size, pool);
+	return Blurred();
+}
 
-	int gridWidth = m_grid.GetWidth();
-	int gridHeight = m_grid.GetHeight();
+const std::tuple<int, int> AStar::ReblurWeights(ThreadPool* pool)
+{
+	if (!m_blur.Reblur(pool)) { return std::make_tuple(m_minPenalty, m_maxPenalty); }
+	return Reblurred();
+}
 
-	Matrix<int> horizontalPass(gridWidth, gridHeight);
-	Matrix<int> verticalPass(gridWidth, gridHeight);
+const std::tuple<int, int> AStar::AdoptBlur(WeightBlur& blur)
+{
+	std::swap(m_blur, blur);
+	return Blurred();
+}
+
+const std::tuple<int, int> AStar::AdoptReblur(WeightBlur& blur)
+{
+	std::swap(m_blur, blur);
+	return Reblurred();
+}
 
-	for (int y = 0; y < gridHeight; y++)
+const std::tuple<int, int> AStar::Blurred()
+{
+	m_cells.ResetMinPenalty();
+	ApplyBlur();
+
+	m_jumpPoints.Invalidate();
+	m_hierarchy.Invalidate();
+	m_landmarks.Invalidate();
+	StampTiles();
+	return std::make_tuple(m_minPenalty, m_maxPenalty);
+}
+
+const std::tuple<int, int> AStar::Reblurred()
+{
+	ApplyBlur();
+
+	m_jumpPoints.Invalidate();
+	m_hierarchy.Invalidate();
+	m_landmarks.Invalidate();
+
+	// One new version for the re-blurred cells, stamped onto every tile they touch
+	int minX, minY, maxX, maxY;
+	std::tie(minX, minY, maxX, maxY) = m_blur.GetRegion();
+	m_version = ++s_versions;
+	for (int y = minY; y <= maxY; y++)
 	{
-		for (int x = -kernelExtents; x <= kernelExtents; x++)
+		for (int x = minX; x <= maxX; x++)
 		{
-			int sampleX = clamp(x, 0, kernelExtents);
-			horizontalPass(0, y) += m_grid(sampleX, y).GetMovementPenalty();
+			int index = m_grid.GetIndex(x, y);
+			m_tileVersions[GetTile(index)] = m_version;
+			m_journal.emplace_back(m_version, index);
 		}
+	}
+	TrimJournal();
+	return std::make_tuple(m_minPenalty, m_maxPenalty);
+}
 
-		for (int x = 1; x < gridWidth; x++)
+const std::tuple<std::vector<PathPoint>, Vec3, int, int, int, int> AStar::ExportGrid()
+{
+	std::vector<PathPoint> points;
+	points.reserve(m_grid.GetSize());
+	for (int row = 0; row < (int)m_grid.GetWidth(); row++)
+	{
+		for (int col = 0; col < (int)m_grid.GetHeight(); col++)
 		{
-			int removeIndex = clamp(x - kernelExtents - 1, 0, gridWidth);
-			int addIndex = clamp(x + kernelExtents, 0, gridWidth - 1);
-			horizontalPass(x, y) = horizontalPass(x - 1, y)
-				- m_grid(removeIndex, y).GetMovementPenalty()
-				+ m_grid(addIndex, y).GetMovementPenalty();
+			points.push_back(GetPoint(m_grid.GetIndex(row, col)));
 		}
 	}
-	for (int x = 0; x < gridWidth; x++)
+	return make_tuple(points, m_worldOffset,
+					  m_grid.GetWidth(), m_grid.GetHeight(),
+					  m_minPenalty, m_maxPenalty);
+}
+
+void AStar::ImportGrid(float* points, int d1)
+{
+	m_cells.Resize(m_grid.GetWidth(), m_grid.GetHeight());
+	PlacePoints(points + 9, (int)((points[0] - 9) / 7));
+	m_jumpPoints.Invalidate();
+	m_hierarchy.Invalidate();
+	m_components.Invalidate();
+	m_landmarks.Invalidate();
+	m_blur.Invalidate();
+	StampTiles();
+}
+
+void AStar::ExportSnapshot(std::vector<uint8_t>& data)
+{
+	GridSnapshot::Write(m_grid, m_cells, m_worldOffset, m_minPenalty, m_maxPenalty, data);
+}
+
+const bool AStar::ExportTiles(const char* path, int tileSize)
+{
+	TileFile file;
+	if (!file.Create(path, m_grid.GetWidth(), m_grid.GetHeight(), tileSize, m_worldOffset)) { return false; }
+
+	const TileFileHeader& header = file.GetHeader();
+	int size = header.tileSize;
+	bool written = true;
+	GridTile tile;
+	for (int tileY = 0; tileY < header.tilesY; tileY++)
 	{
-		for (int y = -kernelExtents; y <= kernelExtents; y++)
+		for (int tileX = 0; tileX < header.tilesX; tileX++)
 		{
-			int sampleY = clamp(y, 0, kernelExtents);
-			verticalPass(x, 0) += horizontalPass(x, sampleY);
+			file.ResetTile(tile);
+			for (int y = 0; y < size && tileY * size + y < header.height; y++)
+			{
+				for (int x = 0; x < size && tileX * size + x < header.width; x++)
+				{
+					int index = m_grid.GetIndex(tileX * size + x, tileY * size + y);
+					int cell = x + y * size;
+					tile.walkable[cell] = m_cells.IsWalkable(index);
+					tile.penalties[cell] = m_cells.GetPenalty(index);
+					tile.positions[cell] = m_grid.GetPosition(index);
+				}
+			}
+			written = file.WriteTile(tileX + tileY * header.tilesX, tile) && written;
 		}
-		int blurredPenalty = std::round(verticalPass(x, 0) / (float)(kernelSize * kernelSize));
-		m_grid(x, 0).SetMovementPenalty(blurredPenalty);
-		for (int y = 1; y < gridHeight; y++)
-		{
-			int removeIndex = clamp(y - kernelExtents - 1, 0, gridHeight);
-			int addIndex = clamp(y + kernelExtents, 0, gridHeight - 1);
+	}
+	file.Close();
+	return written;
+}
 
-			verticalPass(x, y) = verticalPass(x, y - 1)
-				- horizontalPass(x, removeIndex)
-				+ horizontalPass(x, addIndex);
-			blurredPenalty = std::round(verticalPass(x, y) / (float)(kernelSize * kernelSize));
-			m_grid(x, y).SetMovementPenalty(blurredPenalty);
+void AStar::ApplyBlur()
+{
+	int minX, minY, maxX, maxY;
+	std::tie(minX, minY, maxX, maxY) = m_blur.GetRegion();
+	for (int y = minY; y <= maxY; y++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			int blurredPenalty = m_blur.GetBlurred(x, y);
+			m_cells.SetPenalty(m_grid.GetIndex(x, y), blurredPenalty);
 
+			// The penalty range follows the blurred rows after the first
+			if (y == 0) { continue; }
 			if (blurredPenalty > m_maxPenalty)
 			{
 				m_maxPenalty = blurredPenalty;
@@ -216,27 +985,51 @@ const std::tuple<int, int> AStar::BlurWeights(int size)
 			}
 		}
 	}
-	return std::make_tuple(m_minPenalty, m_maxPenalty);
 }
 
-const std::tuple<std::vector<PathPoint>, Vec3, int, int, int, int> AStar::ExportGrid()
+const int AStar::GetTile(int index)
 {
-	return make_tuple(m_grid.Export(), m_worldOffset,
-					  m_grid.GetWidth(), m_grid.GetHeight(),
-					  m_minPenalty, m_maxPenalty);
+	int tilesX = (m_grid.GetWidth() + TILE_SIZE - 1) / TILE_SIZE;
+	return m_grid.GetRow(index) / TILE_SIZE + (m_grid.GetCol(index) / TILE_SIZE) * tilesX;
 }
 
-void AStar::ImportGrid(float* points, int d1)
+void AStar::StampTiles()
+{
+	int tilesX = (m_grid.GetWidth() + TILE_SIZE - 1) / TILE_SIZE;
+	int tilesY = (m_grid.GetHeight() + TILE_SIZE - 1) / TILE_SIZE;
+	m_version = ++s_versions;
+	m_tileVersions.assign(tilesX * tilesY, m_version);
+	m_journal.clear();
+	m_journalBase = m_version;
+}
+
+void AStar::StampTile(int index)
 {
-	for (int i = 0; i < (points[0] - 9) / 7; i++)
+	m_version = ++s_versions;
+	m_tileVersions[GetTile(index)] = m_version;
+	m_journal.emplace_back(m_version, index);
+}
+
+void AStar::TrimJournal()
+{
+	if (m_journal.size() <= EDIT_JOURNAL_CAPACITY) { return; }
+
+	// Forget the older half, never splitting the cells of a single edit
+	m_journalBase = m_journal[m_journal.size() - EDIT_JOURNAL_CAPACITY / 2].first;
+	auto kept = std::upper_bound(m_journal.begin(), m_journal.end(), m_journalBase,
+		[](unsigned int version, const std::pair<unsigned int, int>& edit) { return version < edit.first; });
+	m_journal.erase(m_journal.begin(), kept);
+}
+
+const bool AStar::GetEditsSince(unsigned int version, std::vector<int>& cells) const
+{
+	if (version < m_journalBase || version > m_version) { return false; }
+
+	auto first = std::upper_bound(m_journal.begin(), m_journal.end(), version,
+		[](unsigned int version, const std::pair<unsigned int, int>& edit) { return version < edit.first; });
+	for (; first != m_journal.end(); first++)
 	{
-		int base = 9 + (i * 7);
-		Vec2 pos = Vec2(points[base], points[base + 1]);
-		Vec3 coord = Vec3(points[base + 2], points[base + 3], points[base + 4]);
-		PathPoint& point = m_grid(pos.x, pos.y);
-		point.SetGridCoord(pos);
-		point.SetPosition(coord);
-		point.SetWalkable(points[base + 5]);
-		point.SetMovementPenalty(points[base + 6]);
+		cells.push_back(first->second);
 	}
-}
\ No newline at end of file
+	return true;
+}
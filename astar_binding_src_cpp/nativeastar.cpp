@@ -53,9 +53,441 @@ float* getNearestNeighbors(float pointX, float pointY, float pointZ)
 	return Linker::GetNearestNeighbor(Vec3(pointX, pointY, pointZ));
 }
 
-float* path(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist)
+float* path(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags)
 {
-	return Linker::FindPath(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist);
+	return Linker::FindPath(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, flags);
+}
+
+float* pathBatch(const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags)
+{
+	return Linker::FindPaths(requests, count, smooth, turnDist, stopDist, flags);
+}
+
+void setOpenList(int type)
+{
+	Linker::SetOpenList(type == 1 ? OpenList::Buckets : OpenList::BinaryHeap);
+}
+
+void* createWorld(int gridSizeX, int gridSizeY, int _minPenalty, int _maxPenalty, float offsetX, float offsetY, float offsetZ)
+{
+	return new World(Vec2(gridSizeX, gridSizeY), _minPenalty, _maxPenalty, Vec3(offsetX, offsetY, offsetZ));
+}
+
+void* importWorld(float* points, int d1)
+{
+	return new World(points, d1);
+}
+
+void destroyWorld(void* world)
+{
+	delete static_cast<World*>(world);
+}
+
+void worldClearPoints(void* world)
+{
+	static_cast<World*>(world)->Clear();
+}
+
+void worldAddGridPoint(void* world, float pointX, float pointY, float pointZ, int gridX, int gridY, bool walkable, int movePenalty)
+{
+	static_cast<World*>(world)->AddGridPoint(PathPoint(Vec3(pointX, pointY, pointZ), Vec2(gridX, gridY), walkable, movePenalty));
+}
+
+void worldAddGridPoints(void* world, float* points, int d1)
+{
+	static_cast<World*>(world)->AddGridPoints(points, d1);
+}
+
+float* worldGetGridPoint(void* world, int gridX, int gridY)
+{
+	return Linker::GetGridPoint(*static_cast<World*>(world), gridX, gridY);
+}
+
+void worldSetOpenList(void* world, int type)
+{
+	static_cast<World*>(world)->SetOpenList(type == 1 ? OpenList::Buckets : OpenList::BinaryHeap);
+}
+
+int* worldBlur(void* world, int blurSize)
+{
+	return Linker::BlurWeights(*static_cast<World*>(world), blurSize);
+}
+
+int* worldReblur(void* world)
+{
+	return Linker::ReblurWeights(*static_cast<World*>(world));
+}
+
+float* worldExportGrid(void* world)
+{
+	return Linker::Export(*static_cast<World*>(world));
+}
+
+int worldSnapshotInto(void* world, uint8_t* buffer, int capacity)
+{
+	return Linker::ExportSnapshot(*static_cast<World*>(world), buffer, capacity);
+}
+
+bool worldLoadSnapshot(void* world, const uint8_t* data, int size)
+{
+	return Linker::ImportSnapshot(*static_cast<World*>(world), data, size);
+}
+
+bool worldSaveSnapshotFile(void* world, const char* path)
+{
+	return Linker::SaveSnapshot(*static_cast<World*>(world), path);
+}
+
+bool worldLoadSnapshotFile(void* world, const char* path)
+{
+	return Linker::LoadSnapshot(*static_cast<World*>(world), path);
+}
+
+bool worldSaveTileFile(void* world, const char* path, int tileSize)
+{
+	return static_cast<World*>(world)->ExportTiles(path, tileSize);
+}
+
+void* createSearchContext()
+{
+	return new SearchContext();
+}
+
+void destroySearchContext(void* context)
+{
+	delete static_cast<SearchContext*>(context);
+}
+
+float* worldPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags)
+{
+	return Linker::FindPath(*static_cast<World*>(world), *static_cast<SearchContext*>(context),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, flags);
+}
+
+float* worldPathBatch(void* world, const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags)
+{
+	return Linker::FindPaths(*static_cast<World*>(world), requests, count, smooth, turnDist, stopDist, flags);
+}
+
+void getPointInto(float pointX, float pointY, float pointZ, NativeGridPoint* point)
+{
+	Linker::GetGridPoint(Vec3(pointX, pointY, pointZ), point);
+}
+
+void getGridPointInto(int gridX, int gridY, NativeGridPoint* point)
+{
+	worldGetGridPointInto(&Linker::GetWorld(), gridX, gridY, point);
+}
+
+void worldGetGridPointInto(void* world, int gridX, int gridY, NativeGridPoint* point)
+{
+	Linker::GetGridPoint(*static_cast<World*>(world), gridX, gridY, point);
+}
+
+int pathInto(float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, const SearchOptions* options, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
+{
+	return Linker::FindPath(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), flags, SearchOptions::Normalize(options), info, buffer, capacity);
+}
+
+int worldPathInto(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, const SearchOptions* options, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
+{
+	return Linker::FindPath(*static_cast<World*>(world), *static_cast<SearchContext*>(context),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), flags, SearchOptions::Normalize(options), info, buffer, capacity);
+}
+
+int smoothPathInto(float startX, float startY, float startZ, float endX, float endY, float endZ, float turnDist, float stopDist, int flags, const SearchOptions* options, NativePathInfo* info, NativeTurnPoint* buffer, int capacity)
+{
+	return Linker::FindSmoothPath(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), turnDist, stopDist, flags,
+								  SearchOptions::Normalize(options), info, buffer, capacity);
+}
+
+int worldSmoothPathInto(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, float turnDist, float stopDist, int flags, const SearchOptions* options, NativePathInfo* info, NativeTurnPoint* buffer, int capacity)
+{
+	return Linker::FindSmoothPath(*static_cast<World*>(world), *static_cast<SearchContext*>(context),
+								  Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), turnDist, stopDist, flags,
+								  SearchOptions::Normalize(options), info, buffer, capacity);
+}
+
+float* weightedPath(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit)
+{
+	return Linker::FindPath(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, flags, SearchOptions(weight, timeLimit));
+}
+
+float* worldWeightedPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit)
+{
+	return Linker::FindPath(*static_cast<World*>(world), *static_cast<SearchContext*>(context),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, flags, SearchOptions(weight, timeLimit));
+}
+
+float* budgetedPath(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit, int maxExpansions, int maxMicroseconds, int maxBytes)
+{
+	return Linker::FindPath(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, flags,
+							SearchOptions(weight, timeLimit, maxExpansions, maxMicroseconds, maxBytes), true);
+}
+
+float* worldBudgetedPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit, int maxExpansions, int maxMicroseconds, int maxBytes)
+{
+	return Linker::FindPath(*static_cast<World*>(world), *static_cast<SearchContext*>(context),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, flags,
+							SearchOptions(weight, timeLimit, maxExpansions, maxMicroseconds, maxBytes), true);
+}
+
+float searchBound(void* context)
+{
+	return context ? static_cast<SearchContext*>(context)->bound : Linker::GetSearchBound();
+}
+
+bool searchPartial(void* context)
+{
+	return context ? static_cast<SearchContext*>(context)->partial : Linker::GetSearchPartial();
+}
+
+bool reachable(float startX, float startY, float startZ, float endX, float endY, float endZ)
+{
+	return worldReachable(&Linker::GetWorld(), startX, startY, startZ, endX, endY, endZ);
+}
+
+bool worldReachable(void* world, float startX, float startY, float startZ, float endX, float endY, float endZ)
+{
+	return static_cast<World*>(world)->IsReachable(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ));
+}
+
+void* createPlanner()
+{
+	return new IncrementalPlanner();
+}
+
+void destroyPlanner(void* planner)
+{
+	delete static_cast<IncrementalPlanner*>(planner);
+}
+
+float* plannerPath(void* planner, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist)
+{
+	return worldPlannerPath(&Linker::GetWorld(), planner, startX, startY, startZ, endX, endY, endZ, smooth, turnDist, stopDist);
+}
+
+float* worldPlannerPath(void* world, void* planner, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist)
+{
+	return Linker::FindPath(*static_cast<World*>(world), *static_cast<IncrementalPlanner*>(planner),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist);
+}
+
+void* createSearch()
+{
+	return new SteppedSearch();
+}
+
+void destroySearch(void* search)
+{
+	delete static_cast<SteppedSearch*>(search);
+}
+
+void startSearch(void* search, float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, float weight)
+{
+	worldStartSearch(&Linker::GetWorld(), search, startX, startY, startZ, endX, endY, endZ, flags, weight);
+}
+
+void worldStartSearch(void* world, void* search, float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, float weight)
+{
+	static_cast<World*>(world)->StartSearch(Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), flags, *static_cast<SteppedSearch*>(search), weight);
+}
+
+int stepSearch(void* search, int maxExpansions, int maxMicroseconds)
+{
+	return worldStepSearch(&Linker::GetWorld(), search, maxExpansions, maxMicroseconds);
+}
+
+int worldStepSearch(void* world, void* search, int maxExpansions, int maxMicroseconds)
+{
+	return (int)static_cast<World*>(world)->StepSearch(*static_cast<SteppedSearch*>(search), maxExpansions, maxMicroseconds);
+}
+
+int searchStatus(void* search)
+{
+	return (int)static_cast<SteppedSearch*>(search)->status;
+}
+
+float* searchResult(void* search, bool smooth, float turnDist, float stopDist)
+{
+	return worldSearchResult(&Linker::GetWorld(), search, smooth, turnDist, stopDist);
+}
+
+float* worldSearchResult(void* world, void* search, bool smooth, float turnDist, float stopDist)
+{
+	return Linker::GetSearchResult(*static_cast<World*>(world), *static_cast<SteppedSearch*>(search), smooth, turnDist, stopDist);
+}
+
+void setPathCacheCapacity(int capacity)
+{
+	worldSetPathCacheCapacity(&Linker::GetWorld(), capacity);
+}
+
+void pathCacheStats(int* stats)
+{
+	worldPathCacheStats(&Linker::GetWorld(), stats);
+}
+
+void resetPathCacheStats()
+{
+	worldResetPathCacheStats(&Linker::GetWorld());
+}
+
+void worldSetPathCacheCapacity(void* world, int capacity)
+{
+	static_cast<World*>(world)->SetPathCacheCapacity(std::max(capacity, 0));
+}
+
+void worldPathCacheStats(void* world, int* stats)
+{
+	std::tuple<size_t, size_t, size_t> counters = static_cast<World*>(world)->GetPathCacheStats();
+	stats[0] = (int)std::get<0>(counters);
+	stats[1] = (int)std::get<1>(counters);
+	stats[2] = (int)std::get<2>(counters);
+}
+
+void worldResetPathCacheStats(void* world)
+{
+	static_cast<World*>(world)->ResetPathCacheStats();
+}
+
+void setLandmarks(int count)
+{
+	worldSetLandmarks(&Linker::GetWorld(), count);
+}
+
+void landmarkStats(double* stats)
+{
+	worldLandmarkStats(&Linker::GetWorld(), stats);
+}
+
+void worldSetLandmarks(void* world, int count)
+{
+	static_cast<World*>(world)->SetLandmarkCount(std::max(count, 0));
+}
+
+void worldLandmarkStats(void* world, double* stats)
+{
+	std::tuple<int, size_t, double> counters = static_cast<World*>(world)->GetLandmarkStats();
+	stats[0] = std::get<0>(counters);
+	stats[1] = (double)std::get<1>(counters);
+	stats[2] = std::get<2>(counters);
+}
+
+void* createFlowField()
+{
+	return new FlowField();
+}
+
+void destroyFlowField(void* field)
+{
+	delete static_cast<FlowField*>(field);
+}
+
+void flowField(void* field, float targetX, float targetY, float targetZ)
+{
+	Linker::GetWorld().ComputeFlowField(*static_cast<FlowField*>(field), Vec3(targetX, targetY, targetZ));
+}
+
+bool flowFieldStep(void* field, float pointX, float pointY, float pointZ, float* next)
+{
+	return worldFlowFieldStep(&Linker::GetWorld(), field, pointX, pointY, pointZ, next);
+}
+
+void worldFlowField(void* world, void* field, float targetX, float targetY, float targetZ)
+{
+	static_cast<World*>(world)->ComputeFlowField(*static_cast<FlowField*>(field), Vec3(targetX, targetY, targetZ));
+}
+
+bool worldFlowFieldStep(void* world, void* field, float pointX, float pointY, float pointZ, float* next)
+{
+	Vec3 position;
+	if (!static_cast<World*>(world)->GetFlowStep(*static_cast<FlowField*>(field), Vec3(pointX, pointY, pointZ), position))
+	{
+		return false;
+	}
+	next[0] = position.x;
+	next[1] = position.y;
+	next[2] = position.z;
+	return true;
+}
+
+void* createTileFile(const char* path, int gridSizeX, int gridSizeY, int tileSize, float offsetX, float offsetY, float offsetZ)
+{
+	TileFile* file = new TileFile();
+	if (!file->Create(path, gridSizeX, gridSizeY, tileSize, Vec3(offsetX, offsetY, offsetZ)))
+	{
+		delete file;
+		return nullptr;
+	}
+	return file;
+}
+
+bool tileFileAddPoints(void* file, float* points, int d1)
+{
+	return static_cast<TileFile*>(file)->WritePoints(points, d1);
+}
+
+void closeTileFile(void* file)
+{
+	delete static_cast<TileFile*>(file);
+}
+
+void* createTiledWorld(const char* path, long long budget)
+{
+	TiledWorld* world = new TiledWorld(budget > 0 ? (size_t)budget : DEFAULT_TILE_CACHE_BUDGET);
+	if (!world->Open(path))
+	{
+		delete world;
+		return nullptr;
+	}
+	return world;
+}
+
+void destroyTiledWorld(void* world)
+{
+	delete static_cast<TiledWorld*>(world);
+}
+
+void tiledWorldSetBudget(void* world, long long budget)
+{
+	static_cast<TiledWorld*>(world)->SetBudget((size_t)std::max(budget, 0ll));
+}
+
+void tiledWorldStats(void* world, double* stats)
+{
+	std::tuple<size_t, size_t, size_t, size_t> counters = static_cast<TiledWorld*>(world)->GetStats();
+	stats[0] = (double)std::get<0>(counters);
+	stats[1] = (double)std::get<1>(counters);
+	stats[2] = (double)std::get<2>(counters);
+	stats[3] = (double)std::get<3>(counters);
+}
+
+void* createTiledContext()
+{
+	return new TiledContext();
+}
+
+void destroyTiledContext(void* context)
+{
+	delete static_cast<TiledContext*>(context);
+}
+
+float* tiledPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, const SearchOptions* options)
+{
+	return Linker::FindPath(*static_cast<TiledWorld*>(world), *static_cast<TiledContext*>(context),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), smooth, turnDist, stopDist, SearchOptions::Normalize(options));
+}
+
+int tiledPathInto(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, const SearchOptions* options, NativePathInfo* info, NativeWaypoint* buffer, int capacity)
+{
+	return Linker::FindPath(*static_cast<TiledWorld*>(world), *static_cast<TiledContext*>(context),
+							Vec3(startX, startY, startZ), Vec3(endX, endY, endZ), SearchOptions::Normalize(options), info, buffer, capacity);
+}
+
+bool tiledSearchPartial(void* context)
+{
+	return static_cast<TiledContext*>(context)->partial;
 }
 
 int* blur(int blursize)
@@ -63,6 +495,11 @@ int* blur(int blursize)
 	return Linker::BlurWeights(blursize);
 }
 
+int* reblur()
+{
+	return Linker::ReblurWeights();
+}
+
 float* exportGrid() 
 {
 	return Linker::Export();
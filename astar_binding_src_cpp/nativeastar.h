@@ -79,6 +79,7 @@ extern "C" NATIVEASTAR_H float* getGridPoint(int gridX, int gridY);
 
 /// <summary>
 /// Retrieves the shortest path from the passed start coordinate to the passed end coordinate. With optional path smoothing.
+/// A search running out of the default expansion budget returns no path, <see cref="budgetedPath"/> returns a partial one.
 /// </summary>
 /// <param name="startX">The x value of the start coordinate</param>
 /// <param name="startY">The y value of the start coordinate</param>
@@ -89,8 +90,831 @@ extern "C" NATIVEASTAR_H float* getGridPoint(int gridX, int gridY);
 /// <param name="smooth">Whether to smooth the returned path</param>
 /// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
 /// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
 /// <returns>Collection of float values representing a collection of waypoints along the shortest path</returns>
-extern "C" NATIVEASTAR_H float* path(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist);
+extern "C" NATIVEASTAR_H float* path(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags);
+
+/// <summary>
+/// Retrieves the shortest paths of a batch of requests, executed across a native worker pool.
+/// </summary>
+/// <param name="requests">The start and end coordinates of every request (startX, startY, startZ, endX, endY, endZ)</param>
+/// <param name="count">The number of requests</param>
+/// <param name="smooth">Whether to smooth the returned paths</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <returns>Collection of float values holding the total size, the request count and the offset of every
+///			 path, followed by the paths - each laid out like the result of <see cref="path"/></returns>
+extern "C" NATIVEASTAR_H float* pathBatch(const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags);
+
+/// <summary>
+/// Selects the open list implementation utilized by the astar search.
+/// </summary>
+/// <param name="type">The open list type (0 - binary heap, 1 - bucket queue for integer costs)</param>
+extern "C" NATIVEASTAR_H void setOpenList(int type);
+
+/// <summary>
+/// Creates a world holding its own grid. Path queries against a world may run
+/// concurrently from several threads, each utilizing its own search context.
+/// </summary>
+/// <param name="gridSizeX">The width of the grid</param>
+/// <param name="gridSizeY">The height of the grid</param>
+/// <param name="_minPenalty">The minimum movement penalty</param>
+/// <param name="_maxPenalty">The maximum movement penalty</param>
+/// <param name="offsetX">The x axis coordinate offset</param>
+/// <param name="offsetY">The y axis coordinate offset</param>
+/// <param name="offsetZ">The z axis coordiante offset</param>
+/// <returns>The opaque world handle</returns>
+extern "C" NATIVEASTAR_H void* createWorld(int gridSizeX, int gridSizeY, int _minPenalty, int _maxPenalty, float offsetX, float offsetY, float offsetZ);
+
+/// <summary>
+/// Creates a world initialized from the passed exported grid values.
+/// </summary>
+/// <param name="points">The pointer to the point values of the grid</param>
+/// <param name="d1">The dimension of the collection</param>
+/// <returns>The opaque world handle</returns>
+extern "C" NATIVEASTAR_H void* importWorld(float* points, int d1);
+
+/// <summary>
+/// Destroys the passed world. No query may be running against it.
+/// </summary>
+/// <param name="world">The world handle</param>
+extern "C" NATIVEASTAR_H void destroyWorld(void* world);
+
+/// <summary>
+/// Clears the points of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+extern "C" NATIVEASTAR_H void worldClearPoints(void* world);
+
+/// <summary>
+/// Adds the passed point into the grid of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="pointX">The x axis coordinate of the point</param>
+/// <param name="pointY">The y axis coordinate of the point</param>
+/// <param name="pointZ">The z axis coordinate of the point</param>
+/// <param name="gridX">The x axis grid coordinate of the point</param>
+/// <param name="gridY">The y axis grid coordinate of the point</param>
+/// <param name="walkable">Whether the point is walkable</param>
+/// <param name="movePenalty">The movement penalty of the point</param>
+extern "C" NATIVEASTAR_H void worldAddGridPoint(void* world, float pointX, float pointY, float pointZ, int gridX, int gridY, bool walkable, int movePenalty);
+
+/// <summary>
+/// Adds a collection of grid points to the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="points">The pointer to the collection of points</param>
+/// <param name="d1">The dimension of the collection</param>
+extern "C" NATIVEASTAR_H void worldAddGridPoints(void* world, float* points, int d1);
+
+/// <summary>
+/// Retrieves the point of the passed world at the grid coordinates.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="gridX">The row index</param>
+/// <param name="gridY">The column index</param>
+/// <returns>The collection of values representing the grid point</returns>
+extern "C" NATIVEASTAR_H float* worldGetGridPoint(void* world, int gridX, int gridY);
+
+/// <summary>
+/// Selects the open list implementation utilized by searches of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="type">The open list type (0 - binary heap, 1 - bucket queue for integer costs)</param>
+extern "C" NATIVEASTAR_H void worldSetOpenList(void* world, int type);
+
+/// <summary>
+/// Blurs the weight map of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="blurSize">The blurring window size</param>
+/// <returns>Colleciton of int values representing the new minimum and maximum movement penalty values</returns>
+extern "C" NATIVEASTAR_H int* worldBlur(void* world, int blurSize);
+
+/// <summary>
+/// Re-blurs the weight map of the passed world around the cells edited since
+/// the last blur, with its window size, instead of blurring the whole grid.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <returns>Collection of int values representing the new minimum and maximum movement penalty values</returns>
+extern "C" NATIVEASTAR_H int* worldReblur(void* world);
+
+/// <summary>
+/// Exports the grid values of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <returns>Collection of float values representing the grid</returns>
+extern "C" NATIVEASTAR_H float* worldExportGrid(void* world);
+
+/// <summary>
+/// Writes a binary snapshot of the grid of the passed world into the passed
+/// buffer. Calling with a null buffer queries the size to allocate.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="buffer">The buffer, left untouched if null or too small</param>
+/// <param name="capacity">The number of bytes the buffer holds</param>
+/// <returns>The number of bytes of the snapshot</returns>
+extern "C" NATIVEASTAR_H int worldSnapshotInto(void* world, uint8_t* buffer, int capacity);
+
+/// <summary>
+/// Replaces the grid of the passed world with the passed binary snapshot.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="data">The snapshot bytes</param>
+/// <param name="size">The number of bytes</param>
+/// <returns>Whether the snapshot was valid and loaded</returns>
+extern "C" NATIVEASTAR_H bool worldLoadSnapshot(void* world, const uint8_t* data, int size);
+
+/// <summary>
+/// Saves a binary snapshot of the grid of the passed world to the passed file.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="path">The file path</param>
+/// <returns>Whether the file was written</returns>
+extern "C" NATIVEASTAR_H bool worldSaveSnapshotFile(void* world, const char* path);
+
+/// <summary>
+/// Replaces the grid of the passed world with the binary snapshot in the passed file.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="path">The file path</param>
+/// <returns>Whether the file held a valid snapshot and it was loaded</returns>
+extern "C" NATIVEASTAR_H bool worldLoadSnapshotFile(void* world, const char* path);
+
+/// <summary>
+/// Writes the grid of the passed world into a new tile file, to be searched out of core.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="path">The file path</param>
+/// <param name="tileSize">The cells per tile side (0 - the default)</param>
+/// <returns>Whether every tile was written</returns>
+extern "C" NATIVEASTAR_H bool worldSaveTileFile(void* world, const char* path, int tileSize);
+
+/// <summary>
+/// Creates a search context holding the scratch memory of path queries.
+/// A context may only be utilized by one thread at a time.
+/// </summary>
+/// <returns>The opaque search context handle</returns>
+extern "C" NATIVEASTAR_H void* createSearchContext();
+
+/// <summary>
+/// Destroys the passed search context.
+/// </summary>
+/// <param name="context">The search context handle</param>
+extern "C" NATIVEASTAR_H void destroySearchContext(void* context);
+
+/// <summary>
+/// Retrieves the shortest path within the passed world from the passed start coordinate
+/// to the passed end coordinate. With optional path smoothing. A search running out of
+/// the default expansion budget returns no path, <see cref="worldBudgetedPath"/> returns a partial one.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="context">The search context handle owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the shortest path</returns>
+extern "C" NATIVEASTAR_H float* worldPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags);
+
+/// <summary>
+/// Retrieves the shortest paths of a batch of requests within the passed world,
+/// executed across a native worker pool.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="requests">The start and end coordinates of every request (startX, startY, startZ, endX, endY, endZ)</param>
+/// <param name="count">The number of requests</param>
+/// <param name="smooth">Whether to smooth the returned paths</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <returns>Collection of float values laid out like the result of <see cref="pathBatch"/></returns>
+extern "C" NATIVEASTAR_H float* worldPathBatch(void* world, const float* requests, int count, bool smooth, float turnDist, float stopDist, int flags);
+
+/// <summary>
+/// Writes the point closest to the passed coordinate into the passed caller-owned struct.
+/// </summary>
+/// <param name="pointX">The x value</param>
+/// <param name="pointY">The y value</param>
+/// <param name="pointZ">The z value</param>
+/// <param name="point">The struct to write into</param>
+extern "C" NATIVEASTAR_H void getPointInto(float pointX, float pointY, float pointZ, NativeGridPoint* point);
+
+/// <summary>
+/// Writes the point at the grid coordinates into the passed caller-owned struct.
+/// </summary>
+/// <param name="gridX">The row index</param>
+/// <param name="gridY">The column index</param>
+/// <param name="point">The struct to write into</param>
+extern "C" NATIVEASTAR_H void getGridPointInto(int gridX, int gridY, NativeGridPoint* point);
+
+/// <summary>
+/// Writes the point of the passed world at the grid coordinates into the passed caller-owned struct.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="gridX">The row index</param>
+/// <param name="gridY">The column index</param>
+/// <param name="point">The struct to write into</param>
+extern "C" NATIVEASTAR_H void worldGetGridPointInto(void* world, int gridX, int gridY, NativeGridPoint* point);
+
+/// <summary>
+/// Writes the shortest path from the passed start coordinate to the passed end coordinate into
+/// the passed caller-owned buffer, which is never released by the library. A buffer too small
+/// for the path (or null) is left untouched, the returned count tells the size to retry with.
+/// </summary>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <param name="options">The weight, time limit and budgets of the search (null - the defaults)</param>
+/// <param name="info">The struct receiving the count, bound and partial flag of the path (null - skipped)</param>
+/// <param name="buffer">The buffer to write the waypoints into</param>
+/// <param name="capacity">The number of waypoints the buffer holds</param>
+/// <returns>The number of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H int pathInto(float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, const SearchOptions* options, NativePathInfo* info, NativeWaypoint* buffer, int capacity);
+
+/// <summary>
+/// Writes the shortest path within the passed world from the passed start coordinate to the passed
+/// end coordinate into the passed caller-owned buffer, which is never released by the library. A
+/// buffer too small for the path (or null) is left untouched, the returned count tells the size to retry with.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="context">The search context handle, owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <param name="options">The weight, time limit and budgets of the search (null - the defaults)</param>
+/// <param name="info">The struct receiving the count, bound and partial flag of the path (null - skipped)</param>
+/// <param name="buffer">The buffer to write the waypoints into</param>
+/// <param name="capacity">The number of waypoints the buffer holds</param>
+/// <returns>The number of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H int worldPathInto(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, const SearchOptions* options, NativePathInfo* info, NativeWaypoint* buffer, int capacity);
+
+/// <summary>
+/// Writes the smoothed shortest path from the passed start coordinate to the passed end coordinate
+/// into the passed caller-owned buffer, which is never released by the library. A buffer too small
+/// for the path (or null) is left untouched, the returned count tells the size to retry with.
+/// </summary>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="turnDist">The maximum turn distance when travesing path</param>
+/// <param name="stopDist">The stopping distance</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <param name="options">The weight, time limit and budgets of the search (null - the defaults)</param>
+/// <param name="info">The struct to write the count, finish line and slow down indices, the bound and the partial flag into (optional)</param>
+/// <param name="buffer">The buffer to write the turn points into</param>
+/// <param name="capacity">The number of turn points the buffer holds</param>
+/// <returns>The number of turn points along the path</returns>
+extern "C" NATIVEASTAR_H int smoothPathInto(float startX, float startY, float startZ, float endX, float endY, float endZ, float turnDist, float stopDist, int flags, const SearchOptions* options, NativePathInfo* info, NativeTurnPoint* buffer, int capacity);
+
+/// <summary>
+/// Writes the smoothed shortest path within the passed world from the passed start coordinate to the
+/// passed end coordinate into the passed caller-owned buffer, which is never released by the library. A
+/// buffer too small for the path (or null) is left untouched, the returned count tells the size to retry with.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="context">The search context handle, owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="turnDist">The maximum turn distance when travesing path</param>
+/// <param name="stopDist">The stopping distance</param>
+/// <param name="flags">The search mode flags (0 - A*, 1 - jump point search over uniform regions, 2 - hierarchical search over clusters, 4 - bidirectional search, 8 - weighted search, 16 - anytime search)</param>
+/// <param name="options">The weight, time limit and budgets of the search (null - the defaults)</param>
+/// <param name="info">The struct to write the count, finish line and slow down indices, the bound and the partial flag into (optional)</param>
+/// <param name="buffer">The buffer to write the turn points into</param>
+/// <param name="capacity">The number of turn points the buffer holds</param>
+/// <returns>The number of turn points along the path</returns>
+extern "C" NATIVEASTAR_H int worldSmoothPathInto(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, float turnDist, float stopDist, int flags, const SearchOptions* options, NativePathInfo* info, NativeTurnPoint* buffer, int capacity);
+
+/// <summary>
+/// Retrieves a path from the passed start coordinate to the passed end coordinate, trading
+/// optimality for speed. A weighted search returns a path costing at most weight times the
+/// cheapest one, an anytime search returns its first such path once the time limit is up
+/// and improves it towards the cheapest one until then. With optional path smoothing.
+/// </summary>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags, including 8 - weighted search or 16 - anytime search</param>
+/// <param name="weight">The heuristic weight (epsilon, at least 1)</param>
+/// <param name="timeLimit">The time an anytime search keeps improving its path (microseconds)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H float* weightedPath(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit);
+
+/// <summary>
+/// Retrieves a path within the passed world from the passed start coordinate to the
+/// passed end coordinate, trading optimality for speed. With optional path smoothing.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="context">The search context handle owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags, including 8 - weighted search or 16 - anytime search</param>
+/// <param name="weight">The heuristic weight (epsilon, at least 1)</param>
+/// <param name="timeLimit">The time an anytime search keeps improving its path (microseconds)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H float* worldWeightedPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit);
+
+/// <summary>
+/// Finding the shortest path within the passed budgets. Once a budget runs out
+/// the path to the expanded cell closest to the target is returned instead.
+/// </summary>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags</param>
+/// <param name="weight">The heuristic weight of weighted and anytime searches (epsilon, at least 1)</param>
+/// <param name="timeLimit">The time an anytime search keeps improving its path (microseconds)</param>
+/// <param name="maxExpansions">The maximum number of expanded cells (0 - unlimited)</param>
+/// <param name="maxMicroseconds">The maximum search time (microseconds, 0 - unlimited)</param>
+/// <param name="maxBytes">The maximum memory of the visited cells (bytes, 0 - unlimited)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H float* budgetedPath(float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit, int maxExpansions, int maxMicroseconds, int maxBytes);
+
+/// <summary>
+/// Finding the shortest path within the passed world and budgets, utilizing the passed
+/// search context. Once a budget runs out the path to the expanded cell closest to
+/// the target is returned instead.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="context">The search context handle, owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="flags">The search mode flags</param>
+/// <param name="weight">The heuristic weight of weighted and anytime searches (epsilon, at least 1)</param>
+/// <param name="timeLimit">The time an anytime search keeps improving its path (microseconds)</param>
+/// <param name="maxExpansions">The maximum number of expanded cells (0 - unlimited)</param>
+/// <param name="maxMicroseconds">The maximum search time (microseconds, 0 - unlimited)</param>
+/// <param name="maxBytes">The maximum memory of the visited cells (bytes, 0 - unlimited)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H float* worldBudgetedPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, int flags, float weight, int timeLimit, int maxExpansions, int maxMicroseconds, int maxBytes);
+
+/// <summary>
+/// Retrieves the suboptimality bound of the last path found with the passed search context.
+/// </summary>
+/// <param name="context">The search context handle (null - the context of the calling thread)</param>
+/// <returns>The last path costs at most this many times the cheapest one (1 - exact, 0 - unknown)</returns>
+extern "C" NATIVEASTAR_H float searchBound(void* context);
+
+/// <summary>
+/// Determines whether the last path found with the passed search context was cut short by a budget.
+/// </summary>
+/// <param name="context">The search context handle (null - the context of the calling thread)</param>
+/// <returns>Whether the last path only leads to the expanded cell closest to the target</returns>
+extern "C" NATIVEASTAR_H bool searchPartial(void* context);
+
+/// <summary>
+/// Determines whether a path from the passed start coordinate to the passed end coordinate
+/// exists, in constant time through the connected components of the grid.
+/// </summary>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <returns>Whether a path exists</returns>
+extern "C" NATIVEASTAR_H bool reachable(float startX, float startY, float startZ, float endX, float endY, float endZ);
+
+/// <summary>
+/// Determines whether a path within the passed world from the passed start coordinate
+/// to the passed end coordinate exists, in constant time.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <returns>Whether a path exists</returns>
+extern "C" NATIVEASTAR_H bool worldReachable(void* world, float startX, float startY, float startZ, float endX, float endY, float endZ);
+
+/// <summary>
+/// Creates an incremental planner for a single agent. The planner keeps its search between
+/// queries and only repairs the part affected by the agent moving or the grid being edited.
+/// A planner must not be used by several threads at once.
+/// </summary>
+/// <returns>The opaque planner handle</returns>
+extern "C" NATIVEASTAR_H void* createPlanner();
+
+/// <summary>
+/// Destroys the passed incremental planner.
+/// </summary>
+/// <param name="planner">The planner handle</param>
+extern "C" NATIVEASTAR_H void destroyPlanner(void* planner);
+
+/// <summary>
+/// Retrieves the shortest path from the passed start coordinate to the passed end coordinate
+/// utilizing the passed incremental planner. With optional path smoothing.
+/// </summary>
+/// <param name="planner">The planner handle</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the shortest path</returns>
+extern "C" NATIVEASTAR_H float* plannerPath(void* planner, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist);
+
+/// <summary>
+/// Retrieves the shortest path within the passed world from the passed start coordinate
+/// to the passed end coordinate utilizing the passed incremental planner. With optional path smoothing.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="planner">The planner handle</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the shortest path</returns>
+extern "C" NATIVEASTAR_H float* worldPlannerPath(void* world, void* planner, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist);
+
+/// <summary>
+/// Creates a search spread across several calls, so long searches can be given a few
+/// expansions per frame and interleaved. A search must not be used by several threads at once.
+/// </summary>
+/// <returns>The opaque search handle</returns>
+extern "C" NATIVEASTAR_H void* createSearch();
+
+/// <summary>
+/// Destroys the passed search.
+/// </summary>
+/// <param name="search">The search handle</param>
+extern "C" NATIVEASTAR_H void destroySearch(void* search);
+
+/// <summary>
+/// Starts the passed search from the passed start coordinate to the passed end coordinate,
+/// discarding its previous state. Nothing is expanded until it is stepped.
+/// </summary>
+/// <param name="search">The search handle</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="flags">The search mode flags (0 - default, 1 - jump point search, 8 - weighted search)</param>
+/// <param name="weight">The heuristic weight of a weighted search (epsilon, at least 1)</param>
+extern "C" NATIVEASTAR_H void startSearch(void* search, float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, float weight);
+
+/// <summary>
+/// Starts the passed search within the passed world from the passed start coordinate to the
+/// passed end coordinate, discarding its previous state. Nothing is expanded until it is stepped.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="search">The search handle</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="flags">The search mode flags (0 - default, 1 - jump point search, 8 - weighted search)</param>
+/// <param name="weight">The heuristic weight of a weighted search (epsilon, at least 1)</param>
+extern "C" NATIVEASTAR_H void worldStartSearch(void* world, void* search, float startX, float startY, float startZ, float endX, float endY, float endZ, int flags, float weight);
+
+/// <summary>
+/// Continues the passed search until it ends or the step budgets run out. The
+/// search restarts if the grid was edited since its last step.
+/// </summary>
+/// <param name="search">The search handle</param>
+/// <param name="maxExpansions">The maximum number of cells expanded by this step (0 - unlimited)</param>
+/// <param name="maxMicroseconds">The maximum time spent by this step (microseconds, 0 - unlimited)</param>
+/// <returns>The status of the search (0 - idle, 1 - running, 2 - found, 3 - not found)</returns>
+extern "C" NATIVEASTAR_H int stepSearch(void* search, int maxExpansions, int maxMicroseconds);
+
+/// <summary>
+/// Continues the passed search within the passed world until it ends or the step budgets
+/// run out. The search restarts if the grid was edited since its last step.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="search">The search handle</param>
+/// <param name="maxExpansions">The maximum number of cells expanded by this step (0 - unlimited)</param>
+/// <param name="maxMicroseconds">The maximum time spent by this step (microseconds, 0 - unlimited)</param>
+/// <returns>The status of the search (0 - idle, 1 - running, 2 - found, 3 - not found)</returns>
+extern "C" NATIVEASTAR_H int worldStepSearch(void* world, void* search, int maxExpansions, int maxMicroseconds);
+
+/// <summary>
+/// Retrieves the status of the passed search as of its last step.
+/// </summary>
+/// <param name="search">The search handle</param>
+/// <returns>The status of the search (0 - idle, 1 - running, 2 - found, 3 - not found)</returns>
+extern "C" NATIVEASTAR_H int searchStatus(void* search);
+
+/// <summary>
+/// Retrieves the path found by the passed search. While the search is still running the
+/// path leads to the expanded cell closest to the end coordinate. With optional path smoothing.
+/// </summary>
+/// <param name="search">The search handle</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H float* searchResult(void* search, bool smooth, float turnDist, float stopDist);
+
+/// <summary>
+/// Retrieves the path found by the passed search within the passed world. While the search is
+/// still running the path leads to the expanded cell closest to the end coordinate. With optional
+/// path smoothing.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="search">The search handle</param>
+/// <param name="smooth">Whether to smooth the returned path</param>
+/// <param name="turnDist">The maximum turn distance when travesing path (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H float* worldSearchResult(void* world, void* search, bool smooth, float turnDist, float stopDist);
+
+/// <summary>
+/// Sets the maximum number of paths kept by the path cache of the grid.
+/// </summary>
+/// <param name="capacity">The maximum number of cached paths (0 - disabled)</param>
+extern "C" NATIVEASTAR_H void setPathCacheCapacity(int capacity);
+
+/// <summary>
+/// Retrieves the counters of the path cache of the grid.
+/// </summary>
+/// <param name="stats">The buffer receiving the hits, misses and number of cached paths</param>
+extern "C" NATIVEASTAR_H void pathCacheStats(int* stats);
+
+/// <summary>
+/// Resets the hit and miss counters of the path cache of the grid.
+/// </summary>
+extern "C" NATIVEASTAR_H void resetPathCacheStats();
+
+/// <summary>
+/// Sets the maximum number of paths kept by the path cache of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="capacity">The maximum number of cached paths (0 - disabled)</param>
+extern "C" NATIVEASTAR_H void worldSetPathCacheCapacity(void* world, int capacity);
+
+/// <summary>
+/// Retrieves the counters of the path cache of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="stats">The buffer receiving the hits, misses and number of cached paths</param>
+extern "C" NATIVEASTAR_H void worldPathCacheStats(void* world, int* stats);
+
+/// <summary>
+/// Resets the hit and miss counters of the path cache of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+extern "C" NATIVEASTAR_H void worldResetPathCacheStats(void* world);
+
+/// <summary>
+/// Sets the number of landmarks tightening the search heuristic of the grid, and builds
+/// their distance tables. Every grid edit rebuilds the tables before the next query.
+/// </summary>
+/// <param name="count">The number of landmarks (0 - disabled)</param>
+extern "C" NATIVEASTAR_H void setLandmarks(int count);
+
+/// <summary>
+/// Retrieves the size and build time of the landmark distance tables of the grid.
+/// </summary>
+/// <param name="stats">The buffer receiving the landmarks, bytes held and preprocessing milliseconds</param>
+extern "C" NATIVEASTAR_H void landmarkStats(double* stats);
+
+/// <summary>
+/// Sets the number of landmarks tightening the search heuristic of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="count">The number of landmarks (0 - disabled)</param>
+extern "C" NATIVEASTAR_H void worldSetLandmarks(void* world, int count);
+
+/// <summary>
+/// Retrieves the size and build time of the landmark distance tables of the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="stats">The buffer receiving the landmarks, bytes held and preprocessing milliseconds</param>
+extern "C" NATIVEASTAR_H void worldLandmarkStats(void* world, double* stats);
+
+/// <summary>
+/// Creates a flow field, holding the cost and direction towards a shared target for every cell.
+/// </summary>
+/// <returns>The opaque flow field handle</returns>
+extern "C" NATIVEASTAR_H void* createFlowField();
+
+/// <summary>
+/// Destroys the passed flow field.
+/// </summary>
+/// <param name="field">The flow field handle</param>
+extern "C" NATIVEASTAR_H void destroyFlowField(void* field);
+
+/// <summary>
+/// Computes the passed flow field towards the passed target coordinate. Moving the target
+/// only re-sweeps the affected cells while the grid is unchanged.
+/// </summary>
+/// <param name="field">The flow field handle</param>
+/// <param name="targetX">The x value of the target coordinate</param>
+/// <param name="targetY">The y value of the target coordinate</param>
+/// <param name="targetZ">The z value of the target coordinate</param>
+extern "C" NATIVEASTAR_H void flowField(void* field, float targetX, float targetY, float targetZ);
+
+/// <summary>
+/// Retrieves the position of the next cell along the passed flow field.
+/// </summary>
+/// <param name="field">The flow field handle</param>
+/// <param name="pointX">The x value of the current coordinate</param>
+/// <param name="pointY">The y value of the current coordinate</param>
+/// <param name="pointZ">The z value of the current coordinate</param>
+/// <param name="next">The buffer receiving the x, y and z values of the next cell position</param>
+/// <returns>Whether a next cell exists (false at the target, if it is unreachable or the grid changed)</returns>
+extern "C" NATIVEASTAR_H bool flowFieldStep(void* field, float pointX, float pointY, float pointZ, float* next);
+
+/// <summary>
+/// Computes the passed flow field within the passed world towards the passed target coordinate.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="field">The flow field handle</param>
+/// <param name="targetX">The x value of the target coordinate</param>
+/// <param name="targetY">The y value of the target coordinate</param>
+/// <param name="targetZ">The z value of the target coordinate</param>
+extern "C" NATIVEASTAR_H void worldFlowField(void* world, void* field, float targetX, float targetY, float targetZ);
+
+/// <summary>
+/// Retrieves the position of the next cell along the passed flow field within the passed world.
+/// </summary>
+/// <param name="world">The world handle</param>
+/// <param name="field">The flow field handle</param>
+/// <param name="pointX">The x value of the current coordinate</param>
+/// <param name="pointY">The y value of the current coordinate</param>
+/// <param name="pointZ">The z value of the current coordinate</param>
+/// <param name="next">The buffer receiving the x, y and z values of the next cell position</param>
+/// <returns>Whether a next cell exists (false at the target, if it is unreachable or the grid changed)</returns>
+extern "C" NATIVEASTAR_H bool worldFlowFieldStep(void* world, void* field, float pointX, float pointY, float pointZ, float* next);
+
+/// <summary>
+/// Creates a tile file of blocked cells, to be filled chunk by chunk without
+/// holding the whole grid in memory.
+/// </summary>
+/// <param name="path">The file path</param>
+/// <param name="gridSizeX">The width of the grid</param>
+/// <param name="gridSizeY">The height of the grid</param>
+/// <param name="tileSize">The cells per tile side (0 - the default)</param>
+/// <param name="offsetX">The x axis coordinate offset</param>
+/// <param name="offsetY">The y axis coordinate offset</param>
+/// <param name="offsetZ">The z axis coordiante offset</param>
+/// <returns>The opaque tile file handle (null if the file could not be created)</returns>
+extern "C" NATIVEASTAR_H void* createTileFile(const char* path, int gridSizeX, int gridSizeY, int tileSize, float offsetX, float offsetY, float offsetZ);
+
+/// <summary>
+/// Writes the passed points into the passed tile file.
+/// </summary>
+/// <param name="file">The tile file handle</param>
+/// <param name="points">The pointer to the point values, laid out like the values passed to addGridPoints</param>
+/// <param name="d1">The dimension of the collection</param>
+/// <returns>Whether every touched tile was written, false if the leading size exceeds the dimension</returns>
+extern "C" NATIVEASTAR_H bool tileFileAddPoints(void* file, float* points, int d1);
+
+/// <summary>
+/// Writes the header of the passed tile file, closes and destroys it.
+/// </summary>
+/// <param name="file">The tile file handle</param>
+extern "C" NATIVEASTAR_H void closeTileFile(void* file);
+
+/// <summary>
+/// Creates a tiled world searching the passed tile file, reading tiles on demand.
+/// </summary>
+/// <param name="path">The file path</param>
+/// <param name="budget">The maximum bytes of resident tiles (0 - the default)</param>
+/// <returns>The opaque tiled world handle (null if the file is not a valid tile file)</returns>
+extern "C" NATIVEASTAR_H void* createTiledWorld(const char* path, long long budget);
+
+/// <summary>
+/// Destroys the passed tiled world.
+/// </summary>
+/// <param name="world">The tiled world handle</param>
+extern "C" NATIVEASTAR_H void destroyTiledWorld(void* world);
+
+/// <summary>
+/// Sets the maximum bytes of resident tiles of the passed tiled world.
+/// </summary>
+/// <param name="world">The tiled world handle</param>
+/// <param name="budget">The maximum bytes of resident tiles</param>
+extern "C" NATIVEASTAR_H void tiledWorldSetBudget(void* world, long long budget);
+
+/// <summary>
+/// Retrieves the counters of the tile cache of the passed tiled world.
+/// </summary>
+/// <param name="world">The tiled world handle</param>
+/// <param name="stats">The buffer receiving the resident bytes, resident tiles, hits and faults</param>
+extern "C" NATIVEASTAR_H void tiledWorldStats(void* world, double* stats);
+
+/// <summary>
+/// Creates a tiled search context holding the scratch memory of path queries
+/// against a tiled world. A context may only be utilized by one thread at a time.
+/// </summary>
+/// <returns>The opaque tiled search context handle</returns>
+extern "C" NATIVEASTAR_H void* createTiledContext();
+
+/// <summary>
+/// Destroys the passed tiled search context.
+/// </summary>
+/// <param name="context">The tiled search context handle</param>
+extern "C" NATIVEASTAR_H void destroyTiledContext(void* context);
+
+/// <summary>
+/// Finds the shortest path within the passed tiled world between the passed coordinates.
+/// </summary>
+/// <param name="world">The tiled world handle</param>
+/// <param name="context">The tiled search context handle owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="smooth">Whether to smooth the path</param>
+/// <param name="turnDist">The turn distance (for smoothing)</param>
+/// <param name="stopDist">The stopping distance (for smoothing)</param>
+/// <param name="options">The budgets of the search (null - the defaults)</param>
+/// <returns>Collection of float values representing a collection of waypoints along the shortest path</returns>
+extern "C" NATIVEASTAR_H float* tiledPath(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, bool smooth, float turnDist, float stopDist, const SearchOptions* options);
+
+/// <summary>
+/// Finds the shortest path within the passed tiled world between the passed
+/// coordinates, writing its waypoints into the passed caller-owned buffer.
+/// </summary>
+/// <param name="world">The tiled world handle</param>
+/// <param name="context">The tiled search context handle owned by the calling thread</param>
+/// <param name="startX">The x value of the start coordinate</param>
+/// <param name="startY">The y value of the start coordinate</param>
+/// <param name="startZ">The z value of the start coordinate</param>
+/// <param name="endX">The x value of the end coordinate</param>
+/// <param name="endY">The y value of the end coordinate</param>
+/// <param name="endZ">The z value of the end coordinate</param>
+/// <param name="options">The budgets of the search (null - the defaults)</param>
+/// <param name="info">The struct receiving the count, bound and partial flag of the path (null - skipped)</param>
+/// <param name="buffer">The buffer receiving the waypoints, left untouched if null or too small</param>
+/// <param name="capacity">The number of waypoints the buffer holds</param>
+/// <returns>The number of waypoints along the path</returns>
+extern "C" NATIVEASTAR_H int tiledPathInto(void* world, void* context, float startX, float startY, float startZ, float endX, float endY, float endZ, const SearchOptions* options, NativePathInfo* info, NativeWaypoint* buffer, int capacity);
+
+/// <summary>
+/// Determines whether the last path found with the passed tiled search context was cut short by a budget.
+/// </summary>
+/// <param name="context">The tiled search context handle</param>
+/// <returns>Whether the last path only leads to the expanded cell closest to the target</returns>
+extern "C" NATIVEASTAR_H bool tiledSearchPartial(void* context);
 
 /// <summary>
 /// Blurs the weight map of the grid to smooth edges.
@@ -99,6 +923,13 @@ extern "C" NATIVEASTAR_H float* path(float startX, float startY, float startZ, f
 /// <returns>Colleciton of int values representing the new minimum and maximum movement penalty values</returns>
 extern "C" NATIVEASTAR_H int* blur(int blurSize);
 
+/// <summary>
+/// Re-blurs the weight map of the grid around the cells edited since the
+/// last blur, with its window size, instead of blurring the whole grid.
+/// </summary>
+/// <returns>Collection of int values representing the new minimum and maximum movement penalty values</returns>
+extern "C" NATIVEASTAR_H int* reblur();
+
 /// <summary>
 /// Exports the grid values.
 /// </summary>
@@ -112,4 +943,43 @@ extern "C" NATIVEASTAR_H float* exportGrid();
 /// <param name="d1">The dimension of the collection</param>
 extern "C" NATIVEASTAR_H void importGrid(float* points, int d1);
 
+/// <summary>
+/// Writes a binary snapshot of the grid into the passed buffer. Calling
+/// with a null buffer queries the size to allocate.
+/// </summary>
+/// <param name="buffer">The buffer, left untouched if null or too small</param>
+/// <param name="capacity">The number of bytes the buffer holds</param>
+/// <returns>The number of bytes of the snapshot</returns>
+extern "C" NATIVEASTAR_H int snapshotInto(uint8_t* buffer, int capacity);
+
+/// <summary>
+/// Initializes the grid from the passed binary snapshot.
+/// </summary>
+/// <param name="data">The snapshot bytes</param>
+/// <param name="size">The number of bytes</param>
+/// <returns>Whether the snapshot was valid and loaded</returns>
+extern "C" NATIVEASTAR_H bool loadSnapshot(const uint8_t* data, int size);
+
+/// <summary>
+/// Saves a binary snapshot of the grid to the passed file.
+/// </summary>
+/// <param name="path">The file path</param>
+/// <returns>Whether the file was written</returns>
+extern "C" NATIVEASTAR_H bool saveSnapshotFile(const char* path);
+
+/// <summary>
+/// Initializes the grid from the binary snapshot in the passed file.
+/// </summary>
+/// <param name="path">The file path</param>
+/// <returns>Whether the file held a valid snapshot and it was loaded</returns>
+extern "C" NATIVEASTAR_H bool loadSnapshotFile(const char* path);
+
+/// <summary>
+/// Writes the grid into a new tile file, to be searched out of core.
+/// </summary>
+/// <param name="path">The file path</param>
+/// <param name="tileSize">The cells per tile side (0 - the default)</param>
+/// <returns>Whether every tile was written</returns>
+extern "C" NATIVEASTAR_H bool saveTileFile(const char* path, int tileSize);
+
 #endif
\ No newline at end of file
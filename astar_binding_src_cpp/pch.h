@@ -1,18 +1,30 @@
 #ifndef PCH_H
 #define PCH_H
 
-#define FLT_EPSILON      1.192092896e-07F        // smallest such that 1.0+FLT_EPSILON != 1.0
-
 #include "framework.h"
 #include <iostream>
 #include <algorithm>
 #include <math.h>
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+#include <climits>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <chrono>
 
 #include <string>
 #include <stack>
 #include <deque>
+#include <list>
 #include <array>
+#include <tuple>
 #include <vector>
 #include <set>
 #include <map>
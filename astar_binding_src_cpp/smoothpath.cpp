@@ -3,10 +3,11 @@
 #include <vector>
 #include "SmoothPath.h"
 
-SmoothPath::SmoothPath(std::vector<Vec3> points, Vec3 start, float turnDist, float stoppingDist)
+SmoothPath::SmoothPath(const std::vector<Vec3>& points, Vec3 start, float turnDist, float stoppingDist)
 	: m_lookPoints(points), m_turnBoundaries(std::vector<Line>()), 
 		m_finishLineIndex(points.size() - 1), m_slowDownIndex(0)
 {
+	m_turnBoundaries.reserve(m_lookPoints.size());
 	Vec2 prevPoint = start.ToVec2();
 	for (int i = 0; i < m_lookPoints.size(); i++)
 	{
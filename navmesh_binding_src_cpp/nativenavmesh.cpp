@@ -68,4 +68,20 @@ void endMesh() {
 float* getPath(float startX, float startY, float startZ, float endX, float endY, float endZ)
 {
 	return NavmeshLinker::getPath(Vector3(startX, startY, startZ), Vector3(endX, endY, endZ));
+}
+
+// Gets the shortest path from the start coordinate to the end coordinate within the passed budgets
+float* getBudgetedPath(float startX, float startY, float startZ, float endX, float endY, float endZ, int maxExpansions, int maxMicroseconds, int maxBytes)
+{
+	GraphBudget budget;
+	budget.maxExpansions = max(maxExpansions, 0);
+	budget.maxMicroseconds = max(maxMicroseconds, 0);
+	budget.maxBytes = max(maxBytes, 0);
+	return NavmeshLinker::getPath(Vector3(startX, startY, startZ), Vector3(endX, endY, endZ), budget, true);
+}
+
+// Gets whether the last path was cut short by its budget
+bool getPathPartial()
+{
+	return NavmeshLinker::getLastPartial();
 }
\ No newline at end of file
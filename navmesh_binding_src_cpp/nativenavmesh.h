@@ -33,4 +33,12 @@ extern "C" NATIVENAVMESH_H void endMesh();
 // Gets the shortest path from the start coordinate to the end coordinate
 extern "C" NATIVENAVMESH_H float* getPath(float startX, float startY, float startZ, float endX, float endY, float endZ);
 
+// Gets the shortest path from the start coordinate to the end coordinate within the passed
+// budgets of each graph search (0 - unlimited), settling for the path to the node closest
+// to the end when one runs out
+extern "C" NATIVENAVMESH_H float* getBudgetedPath(float startX, float startY, float startZ, float endX, float endY, float endZ, int maxExpansions, int maxMicroseconds, int maxBytes);
+
+// Gets whether the last path was cut short by its budget
+extern "C" NATIVENAVMESH_H bool getPathPartial();
+
 #endif
\ No newline at end of file
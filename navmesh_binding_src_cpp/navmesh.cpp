@@ -176,7 +176,7 @@ void NavMesh::AddTreeNode(list<Vector3>* added, Vector3 toAdd)
 }
 
 // Finds the shortest path from the start coordinate to the target coordinate across the navmesh
-vector<Vector3> NavMesh::FindPath(Vector3 start, Vector3 target)
+vector<Vector3> NavMesh::FindPath(Vector3 start, Vector3 target, GraphBudget budget, bool* partial)
 {
 	PathNode* fromNode = tree->Nearest(start);
 	PathNode* toNode = tree->Nearest(target);
@@ -184,7 +184,7 @@ vector<Vector3> NavMesh::FindPath(Vector3 start, Vector3 target)
 	if (fromNode == NULL || toNode == NULL) {
 		return {}; // Should never happen
 	}
-	return network->FindShortest(fromNode->position, toNode->position);
+	return network->FindShortest(fromNode->position, toNode->position, false, budget, partial);
 }
 
 // Finds the closest point in the navmesh to the passed point
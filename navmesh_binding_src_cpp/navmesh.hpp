@@ -55,7 +55,7 @@ namespace navmesh {
 		void triangulateMesh();
 
 		Vector3 GetClosestPoint(Vector3 point);
-		vector<Vector3> FindPath(Vector3 start, Vector3 target);
+		vector<Vector3> FindPath(Vector3 start, Vector3 target, GraphBudget budget = GraphBudget(), bool* partial = NULL);
 		void CalculateCentriod();
 
 		string ToString();
@@ -8,6 +8,7 @@ NavMesh* NavmeshLinker::mesh;
 vector<NavMesh*>* NavmeshLinker::meshes;
 map<Vector3, NavMesh*>* NavmeshLinker::meshDictionary;
 VertexGraph* NavmeshLinker::meshGraph;
+bool NavmeshLinker::lastPartial = false;
 //fstream NavmeshLinker::debugFile;
 
 // Destructor
@@ -128,9 +129,15 @@ void NavmeshLinker::finishMeshes()
 	}
 }
 
-// Gets the shortest path from the start coordinate to the end coordinate
-float* NavmeshLinker::getPath(Vector3 start, Vector3 end)
+// Gets the shortest path from the start coordinate to the end coordinate, the budget
+// applies to each graph search. A search running out of it gives up on the path, or
+// when settling ends the path at the node closest to its target
+float* NavmeshLinker::getPath(Vector3 start, Vector3 end, GraphBudget budget, bool settle)
 {
+	lastPartial = false;
+	bool partial = false;
+	bool* partialOut = settle ? &partial : NULL;
+
 	// Use a tree to find the mesh it is currently on?
 	NavMesh* startMesh = NULL;
 	NavMesh* endMesh = NULL;
@@ -150,7 +157,8 @@ float* NavmeshLinker::getPath(Vector3 start, Vector3 end)
 
 	vector<Vector3> path;
 	if (startMesh == endMesh) {
-		path = startMesh->FindPath(start, end);
+		path = startMesh->FindPath(start, end, budget, partialOut);
+		lastPartial = partial;
 	}
 	else {
 		// Find the shortest path between the centriods and the connections
@@ -159,23 +167,27 @@ float* NavmeshLinker::getPath(Vector3 start, Vector3 end)
 		// start point and moving into each mesh utilizing the old ending point as the new start
 		// and closest point to next navmesh as the end point
 		// concatenating it all together to form the final path.
-		vector<Vector3> meshPath = meshGraph->FindShortest(startMesh->centriod, endMesh->centriod, true);
+		vector<Vector3> meshPath = meshGraph->FindShortest(startMesh->centriod, endMesh->centriod, true, budget, partialOut);
+
+		// A partial mesh path ends within the mesh closest to the end, heading for its centriod
+		Vector3 goal = partial && !meshPath.empty() ? meshPath.back() : end;
+		lastPartial = partial;
 
 		vector<Vector3> result;
 		for (int i = 0; i < meshPath.size(); i++) {
 			
 			// Start
 			if (i == 0) {
-				result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(start, meshPath.at(i+1));
+				result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(start, meshPath.at(i+1), budget, partialOut);
 			}
 
 			// End
 			else if (i + 1 == meshPath.size()) {
 				if (path.size() == 0) {
-					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(start, end);
+					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(start, goal, budget, partialOut);
 				}
 				else {
-					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(path.at(path.size() - 1), end);
+					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(path.at(path.size() - 1), goal, budget, partialOut);
 				}
 			}
 
@@ -183,13 +195,19 @@ float* NavmeshLinker::getPath(Vector3 start, Vector3 end)
 			else {
 				// Add check to make it more natural and less through the middle of each mesh?
 				if (path.size() == 0) {
-					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(start, meshPath.at(i + 1));
+					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(start, meshPath.at(i + 1), budget, partialOut);
 				}
 				else {
-					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(path.at(path.size() - 1), meshPath.at(i + 1));
+					result = (*meshDictionary->find(meshPath.at(i))).second->FindPath(path.at(path.size() - 1), meshPath.at(i + 1), budget, partialOut);
 				}
 			}
 			path.insert(path.end(), result.begin(), result.end());
+
+			// A mesh search cut short ends the path where it stopped
+			if (partial) {
+				lastPartial = true;
+				break;
+			}
 		}
 	}
 
@@ -206,4 +224,10 @@ float* NavmeshLinker::getPath(Vector3 start, Vector3 end)
 	float* data = new float[unpacked_waypoints.size()];
 	std::copy(unpacked_waypoints.begin(), unpacked_waypoints.end(), data);
 	return data;
+}
+
+// Gets whether the last path was cut short by its budget
+bool NavmeshLinker::getLastPartial()
+{
+	return lastPartial;
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ namespace navmesh
 		static vector<NavMesh*>* meshes;
 		static map<Vector3, NavMesh*>* meshDictionary;
 		static VertexGraph* meshGraph;
+		static bool lastPartial;
 		
 		static void finishMeshes();
 	public:
@@ -39,7 +40,8 @@ namespace navmesh
 		static void clipHole(vector<Vector3> vertices);
 		static float* getDebugMesh(int index);
 		static void endMesh();
-		static float* getPath(Vector3 start, Vector3 end);
+		static float* getPath(Vector3 start, Vector3 end, GraphBudget budget = GraphBudget(), bool settle = false);
+		static bool getLastPartial();
 	};
 }
 
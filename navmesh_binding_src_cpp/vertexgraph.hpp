@@ -7,6 +7,7 @@
 #include <list>
 #include <unordered_set>
 #include <queue>
+#include <chrono>
 #include "vector3.hpp"
 #include "minheap.hpp"
 #include "navmesh.hpp"
@@ -136,6 +137,15 @@ namespace std
 		}
 	};
 
+	// Budgets of a single graph search, 0 - unlimited. Once one runs out
+	// the search gives up, or settles for a partial path when asked to
+	struct GraphBudget {
+	public:
+		int maxExpansions = 10000;
+		long long maxMicroseconds = 0;
+		size_t maxBytes = 0;
+	};
+
 	class VertexGraph {
 	public:
 		Graph* graph;
@@ -157,16 +167,30 @@ namespace std
 			graph->AddEdge(edge);
 		}
 
-		vector<Vector3> FindShortest(Vector3 start, Vector3 target, bool exact = false) {
+		vector<Vector3> FindShortest(Vector3 start, Vector3 target, bool exact = false, GraphBudget budget = GraphBudget(), bool* partial = NULL) {
 			int safety = 0;
 			bool path_success = false;
+			bool exhausted = false;
+			auto begin = chrono::steady_clock::now();
 			set<VertexNode*, VertexComparer> openSet;
 			unordered_set<VertexNode, VertexEquality> opened;
 			unordered_set<VertexNode, VertexEquality> closedSet;
 
-			openSet.insert(new VertexNode(start));
+			VertexNode* origin = new VertexNode(start);
+			origin->updateCost(0, start.DistanceTo(target));
+			VertexNode* closest = origin;
+			if (partial != NULL) {
+				*partial = false;
+			}
+
+			openSet.insert(origin);
 			while (!openSet.empty()) {
-				if (safety > 10000) {
+				// Every visited node is either closed or still open
+				if ((budget.maxExpansions > 0 && safety > budget.maxExpansions)
+					|| (budget.maxBytes > 0 && (closedSet.size() + opened.size()) * sizeof(VertexNode) > budget.maxBytes)
+					|| (budget.maxMicroseconds > 0 && (safety & 63) == 63
+						&& chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - begin).count() > budget.maxMicroseconds)) {
+					exhausted = true;
 					break;
 				}
 
@@ -179,7 +203,9 @@ namespace std
 					path_success = true;
 					break;
 				}
-
+				if (current->hcost < closest->hcost) {
+					closest = current;
+				}
 				for (GraphEdge edgeNeighbor : *graph->Adjacencies->operator[](current->position)) {
 					VertexNode* neighbor = new VertexNode(edgeNeighbor.to);
 					if (closedSet.find(*neighbor) != closedSet.end()) {
@@ -210,6 +236,14 @@ namespace std
 				unordered_set<VertexNode>::iterator end = closedSet.find(VertexNode(target));
 				return retracePath(start, *end, exact);
 			}
+			else if (exhausted && partial != NULL) {
+				// Settle for the path to the expanded node closest to the target
+				*partial = true;
+				if (closest == origin) {
+					return {};
+				}
+				return retracePath(start, *closest, exact);
+			}
 			else {
 				return {};
 			}